@@ -0,0 +1,362 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <uc2/uc2.hpp>
+
+#include "benchrunner.hpp"
+#include "pkg/pkgstructures.hpp"
+#include "synthetic.hpp"
+
+constexpr const std::string_view SYNTHETIC_PKG_NAME = "synthetic.pkg";
+constexpr const std::string_view SYNTHETIC_INDEX_NAME = "synthetic_index.pkg";
+constexpr const std::string_view SYNTHETIC_TABLE_NAME = "synthetic.ecsv";
+
+struct BenchOptions_t
+{
+    double fMinSeconds = 1.0;
+    std::string szFilter;
+    std::string szOutPath;
+    std::uint32_t iEntriesNum = 20000;
+};
+
+static uc2::PkgFile::ptr_t CreateSyntheticPkg(std::vector<std::uint8_t>& vData,
+                                              uc2::PkgFileOptions* pOptions)
+{
+    return uc2::PkgFile::Create(std::string(SYNTHETIC_PKG_NAME), vData,
+                                std::string(SYNTHETIC_ENTRY_KEY),
+                                std::string(SYNTHETIC_DATA_KEY), pOptions);
+}
+
+// AES 128 CBC through a single entry, since the cipher classes are internal
+static void RunAesBenchmarks(CBenchRunner& runner)
+{
+    for (const std::uint32_t iSize :
+         { 4096u, 64u * 1024, 1024u * 1024, 16u * 1024 * 1024 })
+    {
+        const std::string szName = "aes_decrypt/" + std::to_string(iSize);
+
+        if (runner.IsSelected(szName) == false)
+        {
+            continue;
+        }
+
+        SyntheticPkgOptions_t options;
+        options.iEntriesNum = 1;
+        options.iMinFileSize = iSize;
+        options.iMaxFileSize = iSize;
+
+        std::vector<std::uint8_t> vPkg =
+            BuildSyntheticPkg(SYNTHETIC_PKG_NAME, options);
+        auto pPkg = CreateSyntheticPkg(vPkg, nullptr);
+        pPkg->DecryptHeader();
+        pPkg->Parse();
+
+        uc2::PkgEntry& entry = pPkg->GetEntry(0);
+        std::vector<std::uint8_t> vOut(entry.GetDecryptedSize());
+
+        runner.Run(szName, iSize, 1, [&]() {
+            entry.DecryptFileTo(vOut.data(), vOut.size());
+        });
+    }
+}
+
+static void RunPkgParseBenchmarks(CBenchRunner& runner,
+                                  const BenchOptions_t& benchOptions)
+{
+    const std::uint32_t iEntriesNum = benchOptions.iEntriesNum;
+
+    SyntheticPkgOptions_t options;
+    options.iEntriesNum = iEntriesNum;
+    options.iMinFileSize = 16;
+    options.iMaxFileSize = 256;
+
+    std::vector<std::uint8_t> vPristinePkg;
+
+    for (const bool bLazy : { false, true })
+    {
+        const std::string szName = std::string("pkg_parse_entries/") +
+                                   (bLazy == true ? "lazy/" : "eager/") +
+                                   std::to_string(iEntriesNum);
+
+        if (runner.IsSelected(szName) == false)
+        {
+            continue;
+        }
+
+        if (vPristinePkg.empty() == true)
+        {
+            vPristinePkg = BuildSyntheticPkg(SYNTHETIC_PKG_NAME, options);
+        }
+
+        auto pOptions = uc2::PkgFileOptions::Create();
+        pOptions->SetLazyEntries(bLazy);
+
+        std::vector<std::uint8_t> vPkg;
+        uc2::PkgFile::ptr_t pPkg;
+
+        // parsing decrypts the entry table in place, so every iteration
+        // starts from an encrypted copy
+        auto setup = [&]() {
+            pPkg.reset();
+            vPkg = vPristinePkg;
+            pPkg = CreateSyntheticPkg(vPkg, pOptions.get());
+            pPkg->DecryptHeader();
+        };
+
+        runner.Run(
+            szName, iEntriesNum * sizeof(uc2::PkgEntryHeader_t), iEntriesNum,
+            [&]() { pPkg->Parse(); }, setup);
+    }
+}
+
+static void RunEntryDecryptBenchmarks(CBenchRunner& runner,
+                                      const BenchOptions_t& benchOptions)
+{
+    const std::uint32_t iEntriesNum =
+        std::max<std::uint32_t>(benchOptions.iEntriesNum / 10, 1);
+    const std::string szName =
+        "pkg_entry_decrypt_file/" + std::to_string(iEntriesNum);
+
+    if (runner.IsSelected(szName) == false)
+    {
+        return;
+    }
+
+    SyntheticPkgOptions_t options;
+    options.iEntriesNum = iEntriesNum;
+    options.iMinFileSize = 1024;
+    options.iMaxFileSize = 256 * 1024;
+
+    const std::vector<std::uint8_t> vPristinePkg =
+        BuildSyntheticPkg(SYNTHETIC_PKG_NAME, options);
+    std::vector<std::uint8_t> vPkg = vPristinePkg;
+
+    auto pPkg = CreateSyntheticPkg(vPkg, nullptr);
+    pPkg->DecryptHeader();
+    pPkg->Parse();
+
+    std::uint64_t iTotalSize = 0;
+
+    for (auto&& entry : pPkg->GetEntries())
+    {
+        iTotalSize += entry->GetDecryptedSize();
+    }
+
+    // DecryptFile decrypts in place, so the data is encrypted again before
+    // every iteration. The parsed entries keep pointing to the same buffer.
+    auto setup = [&]() {
+        std::copy(vPristinePkg.begin(), vPristinePkg.end(), vPkg.begin());
+    };
+
+    runner.Run(
+        szName, iTotalSize, iEntriesNum,
+        [&]() {
+            for (auto&& entry : pPkg->GetEntries())
+            {
+                entry->DecryptFile();
+            }
+        },
+        setup);
+}
+
+static void RunIndexBenchmarks(CBenchRunner& runner,
+                               const BenchOptions_t& benchOptions)
+{
+    const std::uint32_t iPkgsNum = benchOptions.iEntriesNum;
+    const std::string szName = "pkg_index_parse/" + std::to_string(iPkgsNum);
+
+    if (runner.IsSelected(szName) == false)
+    {
+        return;
+    }
+
+    std::vector<std::string> vPkgNames;
+
+    for (std::uint32_t i = 0; i < iPkgsNum; i++)
+    {
+        vPkgNames.push_back(GetSyntheticPkgName(i));
+    }
+
+    const std::vector<std::uint8_t> vPristineIndex =
+        BuildSyntheticIndex(SYNTHETIC_INDEX_NAME, vPkgNames);
+
+    std::vector<std::uint8_t> vIndex;
+    uc2::PkgIndex::ptr_t pIndex;
+
+    auto setup = [&]() {
+        pIndex.reset();
+        vIndex = vPristineIndex;
+        pIndex = uc2::PkgIndex::Create(SYNTHETIC_INDEX_NAME, vIndex,
+                                       &SYNTHETIC_KEY_COLLECTION);
+        pIndex->ValidateHeader();
+    };
+
+    runner.Run(
+        szName, vPristineIndex.size(), iPkgsNum, [&]() { pIndex->Parse(); },
+        setup);
+}
+
+static void RunEncryptedFileBenchmarks(CBenchRunner& runner,
+                                       const BenchOptions_t& benchOptions)
+{
+    const std::uint32_t iRowsNum = benchOptions.iEntriesNum;
+    const std::string szName =
+        "encrypted_file_decrypt/" + std::to_string(iRowsNum);
+
+    if (runner.IsSelected(szName) == false)
+    {
+        return;
+    }
+
+    const std::vector<std::uint8_t> vPristineFile =
+        BuildSyntheticEncryptedFile(SYNTHETIC_TABLE_NAME,
+                                    BuildSyntheticTable(iRowsNum, 12));
+
+    std::vector<std::uint8_t> vFile;
+    uc2::EncryptedFile::ptr_t pFile;
+
+    auto setup = [&]() {
+        pFile.reset();
+        vFile = vPristineFile;
+        pFile = uc2::EncryptedFile::Create(SYNTHETIC_TABLE_NAME, vFile,
+                                           SYNTHETIC_KEY_COLLECTION);
+    };
+
+    runner.Run(
+        szName, vPristineFile.size(), iRowsNum, [&]() { pFile->Decrypt(); },
+        setup);
+}
+
+static void RunLzmaBenchmarks(CBenchRunner& runner)
+{
+    constexpr const std::uint32_t TEXTURE_SIZE = 16 * 1024 * 1024;
+    constexpr const std::uint32_t TEXTURE_CHUNK_SIZE = 128 * 1024;
+
+    std::vector<std::uint8_t> vTexture;
+    std::vector<std::uint8_t> vOut(TEXTURE_SIZE);
+
+    for (const bool bParallel : { false, true })
+    {
+        const std::string szName =
+            std::string("lzma_decompress/") +
+            (bParallel == true ? "parallel/" : "serial/") +
+            std::to_string(TEXTURE_SIZE);
+
+        if (runner.IsSelected(szName) == false)
+        {
+            continue;
+        }
+
+        if (vTexture.empty() == true)
+        {
+            vTexture =
+                BuildSyntheticTexture(TEXTURE_SIZE, TEXTURE_CHUNK_SIZE);
+        }
+
+        auto pTexture = uc2::LzmaTexture::Create(vTexture);
+
+        runner.Run(szName, TEXTURE_SIZE, 0, [&]() {
+            const bool bDecompressed =
+                bParallel == true ?
+                    pTexture->DecompressParallel(vOut.data(), vOut.size()) :
+                    pTexture->Decompress(vOut.data(), vOut.size());
+
+            if (bDecompressed == false)
+            {
+                throw std::runtime_error("Failed to decompress the texture");
+            }
+        });
+    }
+}
+
+static void PrintUsage(const char* szProgram)
+{
+    std::cerr
+        << "Usage: " << szProgram << " [options]\n"
+        << "  --filter <text>    Only run benchmarks whose name contains it\n"
+        << "  --min-time <secs>  Minimum time to run each benchmark for\n"
+        << "  --entries <num>    Entries in the synthetic PKGs and indexes\n"
+        << "  --out <path>       Write the JSON results to a file\n";
+}
+
+static bool ParseArguments(int argc, char* argv[], BenchOptions_t& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string_view szvArg = argv[i];
+
+        if (i + 1 == argc)
+        {
+            return false;
+        }
+
+        const char* szValue = argv[++i];
+
+        if (szvArg == "--filter")
+        {
+            options.szFilter = szValue;
+        }
+        else if (szvArg == "--min-time")
+        {
+            options.fMinSeconds = std::stod(szValue);
+        }
+        else if (szvArg == "--entries")
+        {
+            options.iEntriesNum =
+                static_cast<std::uint32_t>(std::stoul(szValue));
+        }
+        else if (szvArg == "--out")
+        {
+            options.szOutPath = szValue;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    BenchOptions_t options;
+
+    try
+    {
+        if (ParseArguments(argc, argv, options) == false)
+        {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+
+        CBenchRunner runner(options.fMinSeconds, options.szFilter);
+
+        RunAesBenchmarks(runner);
+        RunPkgParseBenchmarks(runner, options);
+        RunEntryDecryptBenchmarks(runner, options);
+        RunIndexBenchmarks(runner, options);
+        RunEncryptedFileBenchmarks(runner, options);
+        RunLzmaBenchmarks(runner);
+
+        if (options.szOutPath.empty() == false)
+        {
+            std::ofstream os(options.szOutPath);
+            runner.WriteJson(os);
+        }
+        else
+        {
+            runner.WriteJson(std::cout);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "pkg_bench: " << e.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include "benchrunner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <thread>
+
+#include <uc2/uc2.hpp>
+
+// enough samples for a stable median, even for slow benchmarks
+constexpr const std::uint64_t BENCH_MIN_ITERATIONS = 5;
+constexpr const std::uint64_t BENCH_MAX_ITERATIONS = 1000000;
+
+static double GetRate(std::uint64_t iAmount, double fNs)
+{
+    return fNs > 0 ? iAmount / (fNs / 1e9) : 0;
+}
+
+static std::string EscapeJson(std::string_view szvText)
+{
+    std::string szEscaped;
+
+    for (const char c : szvText)
+    {
+        if (c == '"' || c == '\\')
+        {
+            szEscaped += '\\';
+        }
+
+        szEscaped += c;
+    }
+
+    return szEscaped;
+}
+
+CBenchRunner::CBenchRunner(double fMinSeconds, std::string_view szvFilter)
+    : m_fMinSeconds(fMinSeconds), m_szFilter(szvFilter)
+{
+}
+
+bool CBenchRunner::IsSelected(std::string_view szvName) const
+{
+    return szvName.find(this->m_szFilter) != std::string_view::npos;
+}
+
+void CBenchRunner::Run(std::string szName, std::uint64_t iBytes,
+                       std::uint64_t iEntries, const func_t& run,
+                       const func_t& setup /*= {}*/)
+{
+    if (this->IsSelected(szName) == false)
+    {
+        return;
+    }
+
+    using clock_t = std::chrono::steady_clock;
+
+    std::cerr << "Running " << szName << "...\n";
+
+    // warm up the caches and the lazily initialized state
+    if (setup)
+    {
+        setup();
+    }
+
+    run();
+
+    std::vector<double> vSamples;
+    double fTotalNs = 0;
+
+    while (vSamples.size() < BENCH_MAX_ITERATIONS &&
+           (vSamples.size() < BENCH_MIN_ITERATIONS ||
+            fTotalNs < this->m_fMinSeconds * 1e9))
+    {
+        if (setup)
+        {
+            setup();
+        }
+
+        const auto start = clock_t::now();
+        run();
+        const auto end = clock_t::now();
+
+        const double fNs =
+            std::chrono::duration<double, std::nano>(end - start).count();
+        vSamples.push_back(fNs);
+        fTotalNs += fNs;
+    }
+
+    std::sort(vSamples.begin(), vSamples.end());
+
+    BenchResult_t result;
+    result.szName = std::move(szName);
+    result.iIterations = vSamples.size();
+    result.fMinNs = vSamples.front();
+    result.fMedianNs = vSamples[vSamples.size() / 2];
+    result.fMeanNs = fTotalNs / vSamples.size();
+    result.iBytes = iBytes;
+    result.iEntries = iEntries;
+
+    this->m_vResults.push_back(std::move(result));
+}
+
+void CBenchRunner::WriteJson(std::ostream& os) const
+{
+    os << "{\n";
+    os << "  \"library_version\": \""
+       << EscapeJson(uc2::Version::GetVersionString()) << "\",\n";
+    os << "  \"hardware_threads\": " << std::thread::hardware_concurrency()
+       << ",\n";
+    os << "  \"min_time_s\": " << this->m_fMinSeconds << ",\n";
+    os << "  \"benchmarks\": [";
+
+    for (std::size_t i = 0; i < this->m_vResults.size(); i++)
+    {
+        const BenchResult_t& result = this->m_vResults[i];
+
+        os << (i != 0 ? ",\n" : "\n");
+        os << "    {\n";
+        os << "      \"name\": \"" << EscapeJson(result.szName) << "\",\n";
+        os << "      \"iterations\": " << result.iIterations << ",\n";
+        os << "      \"min_ns\": " << result.fMinNs << ",\n";
+        os << "      \"median_ns\": " << result.fMedianNs << ",\n";
+        os << "      \"mean_ns\": " << result.fMeanNs << ",\n";
+        os << "      \"bytes_per_iteration\": " << result.iBytes << ",\n";
+        os << "      \"entries_per_iteration\": " << result.iEntries << ",\n";
+        // the rates use the median, which ignores the odd slow iteration
+        os << "      \"mb_per_s\": "
+           << GetRate(result.iBytes, result.fMedianNs) / 1e6 << ",\n";
+        os << "      \"entries_per_s\": "
+           << GetRate(result.iEntries, result.fMedianNs) << "\n";
+        os << "    }";
+    }
+
+    os << "\n  ]\n}\n";
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct BenchResult_t
+{
+    std::string szName;
+    std::uint64_t iIterations;
+    double fMinNs;
+    double fMedianNs;
+    double fMeanNs;
+    // processed by every iteration
+    std::uint64_t iBytes;
+    std::uint64_t iEntries;
+};
+
+// Runs each benchmark as it's added, until it ran for the minimum time, and
+// writes the results as JSON
+class CBenchRunner
+{
+public:
+    using func_t = std::function<void()>;
+
+    CBenchRunner(double fMinSeconds, std::string_view szvFilter);
+
+    // Only benchmarks whose name contains the filter are run. Their data
+    // should only be built when this returns true.
+    bool IsSelected(std::string_view szvName) const;
+
+    // The setup function runs before every iteration, and it is not timed.
+    // iBytes and iEntries are what one iteration processes, and they're
+    // zero when the rate doesn't apply.
+    void Run(std::string szName, std::uint64_t iBytes,
+             std::uint64_t iEntries, const func_t& run,
+             const func_t& setup = {});
+
+    void WriteJson(std::ostream& os) const;
+
+private:
+    double m_fMinSeconds;
+    std::string m_szFilter;
+    std::vector<BenchResult_t> m_vResults;
+};
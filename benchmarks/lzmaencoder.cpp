@@ -0,0 +1,320 @@
+#include "lzmaencoder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "lzmaDecoder.h"
+
+// lc = 3, lp = 0 and pb = 2, the LZMA SDK's defaults
+constexpr const std::uint32_t LZMA_LC = 3;
+constexpr const std::uint32_t LZMA_PB = 2;
+constexpr const std::uint8_t LZMA_PROPS_BYTE = (LZMA_PB * 5) * 9 + LZMA_LC;
+
+constexpr const std::uint32_t LZMA_NUM_STATES = 12;
+constexpr const std::uint32_t LZMA_NUM_POS_STATES = 1 << LZMA_PB;
+constexpr const std::uint32_t LZMA_NUM_LIT_STATES = 7;
+constexpr const std::uint32_t LZMA_LITERAL_PROBS = 0x300;
+
+constexpr const std::uint32_t LZMA_MATCH_MIN_LEN = 2;
+constexpr const std::uint32_t LZMA_MATCH_MAX_LEN = 273;
+
+constexpr const std::uint32_t LZMA_NUM_BIT_MODEL_BITS = 11;
+constexpr const std::uint16_t LZMA_PROB_INIT =
+    (1 << LZMA_NUM_BIT_MODEL_BITS) / 2;
+constexpr const std::uint32_t LZMA_NUM_MOVE_BITS = 5;
+constexpr const std::uint32_t LZMA_TOP_VALUE = 1 << 24;
+
+class CRangeEncoder
+{
+public:
+    CRangeEncoder(std::vector<std::uint8_t>& vOut)
+        : m_vOut(vOut), m_iLow(0), m_iRange(0xFFFFFFFF), m_iCache(0),
+          m_iCacheSize(1)
+    {
+    }
+
+    void EncodeBit(std::uint16_t& iProb, std::uint32_t iBit)
+    {
+        const std::uint32_t iBound =
+            (this->m_iRange >> LZMA_NUM_BIT_MODEL_BITS) * iProb;
+
+        if (iBit == 0)
+        {
+            this->m_iRange = iBound;
+            iProb += ((1 << LZMA_NUM_BIT_MODEL_BITS) - iProb) >>
+                     LZMA_NUM_MOVE_BITS;
+        }
+        else
+        {
+            this->m_iLow += iBound;
+            this->m_iRange -= iBound;
+            iProb -= iProb >> LZMA_NUM_MOVE_BITS;
+        }
+
+        while (this->m_iRange < LZMA_TOP_VALUE)
+        {
+            this->m_iRange <<= 8;
+            this->ShiftLow();
+        }
+    }
+
+    // encodes the iNumBits low bits of iSymbol, the highest bit first
+    void EncodeBitTree(std::uint16_t* pProbs, std::uint32_t iNumBits,
+                       std::uint32_t iSymbol)
+    {
+        std::uint32_t m = 1;
+
+        for (std::uint32_t i = iNumBits; i != 0; i--)
+        {
+            const std::uint32_t iBit = (iSymbol >> (i - 1)) & 1;
+            this->EncodeBit(pProbs[m], iBit);
+            m = (m << 1) | iBit;
+        }
+    }
+
+    void Flush()
+    {
+        for (int i = 0; i < 5; i++)
+        {
+            this->ShiftLow();
+        }
+    }
+
+private:
+    void ShiftLow()
+    {
+        if (static_cast<std::uint32_t>(this->m_iLow) < 0xFF000000 ||
+            (this->m_iLow >> 32) != 0)
+        {
+            std::uint8_t iTemp = this->m_iCache;
+
+            do
+            {
+                this->m_vOut.push_back(static_cast<std::uint8_t>(
+                    iTemp + static_cast<std::uint8_t>(this->m_iLow >> 32)));
+                iTemp = 0xFF;
+            } while (--this->m_iCacheSize != 0);
+
+            this->m_iCache = static_cast<std::uint8_t>(this->m_iLow >> 24);
+        }
+
+        this->m_iCacheSize++;
+        this->m_iLow = (this->m_iLow & 0x00FFFFFF) << 8;
+    }
+
+private:
+    std::vector<std::uint8_t>& m_vOut;
+    std::uint64_t m_iLow;
+    std::uint32_t m_iRange;
+    std::uint8_t m_iCache;
+    std::uint64_t m_iCacheSize;
+};
+
+struct LzmaLenProbs_t
+{
+    std::uint16_t Choice = LZMA_PROB_INIT;
+    std::uint16_t Choice2 = LZMA_PROB_INIT;
+    std::array<std::array<std::uint16_t, 1 << 3>, LZMA_NUM_POS_STATES> Low;
+    std::array<std::array<std::uint16_t, 1 << 3>, LZMA_NUM_POS_STATES> Mid;
+    std::array<std::uint16_t, 1 << 8> High;
+
+    LzmaLenProbs_t()
+    {
+        for (auto&& probs : this->Low)
+        {
+            probs.fill(LZMA_PROB_INIT);
+        }
+
+        for (auto&& probs : this->Mid)
+        {
+            probs.fill(LZMA_PROB_INIT);
+        }
+
+        this->High.fill(LZMA_PROB_INIT);
+    }
+};
+
+class CLzmaRunEncoder
+{
+public:
+    CLzmaRunEncoder(std::vector<std::uint8_t>& vOut)
+        : m_RangeEnc(vOut), m_iState(0),
+          m_vLiteralProbs(LZMA_LITERAL_PROBS << LZMA_LC, LZMA_PROB_INIT)
+    {
+        for (auto&& probs : this->m_IsMatch)
+        {
+            probs.fill(LZMA_PROB_INIT);
+        }
+
+        for (auto&& probs : this->m_IsRep0Long)
+        {
+            probs.fill(LZMA_PROB_INIT);
+        }
+
+        this->m_IsRep.fill(LZMA_PROB_INIT);
+        this->m_IsRepG0.fill(LZMA_PROB_INIT);
+    }
+
+    void Encode(const std::uint8_t* pData, std::uint32_t iDataSize)
+    {
+        std::uint32_t iPos = 0;
+
+        while (iPos < iDataSize)
+        {
+            // the first byte has nothing to repeat
+            std::uint32_t iRunLen = 0;
+
+            if (iPos != 0)
+            {
+                const std::uint32_t iMaxLen =
+                    std::min(iDataSize - iPos, LZMA_MATCH_MAX_LEN);
+
+                while (iRunLen < iMaxLen &&
+                       pData[iPos + iRunLen] == pData[iPos - 1])
+                {
+                    iRunLen++;
+                }
+            }
+
+            if (iRunLen >= LZMA_MATCH_MIN_LEN)
+            {
+                this->EncodeRep0(iPos, iRunLen);
+                iPos += iRunLen;
+            }
+            else
+            {
+                this->EncodeLiteral(pData, iPos);
+                iPos++;
+            }
+        }
+
+        this->m_RangeEnc.Flush();
+    }
+
+private:
+    void EncodeLiteral(const std::uint8_t* pData, std::uint32_t iPos)
+    {
+        const std::uint32_t iPosState = iPos & (LZMA_NUM_POS_STATES - 1);
+        this->m_RangeEnc.EncodeBit(
+            this->m_IsMatch[this->m_iState][iPosState], 0);
+
+        const std::uint8_t iPrevByte = iPos != 0 ? pData[iPos - 1] : 0;
+        std::uint16_t* pProbs =
+            &this->m_vLiteralProbs[LZMA_LITERAL_PROBS *
+                                   (iPrevByte >> (8 - LZMA_LC))];
+
+        std::uint32_t iSymbol = pData[iPos] | 0x100;
+
+        if (this->m_iState < LZMA_NUM_LIT_STATES)
+        {
+            do
+            {
+                this->m_RangeEnc.EncodeBit(pProbs[iSymbol >> 8],
+                                           (iSymbol >> 7) & 1);
+                iSymbol <<= 1;
+            } while (iSymbol < 0x10000);
+
+            this->m_iState -= this->m_iState < 4 ? this->m_iState : 3;
+        }
+        else
+        {
+            // after a match, the byte at rep0 (the previous byte) is used as
+            // context until the literal differs from it
+            std::uint32_t iMatchByte = iPrevByte;
+            std::uint32_t iOffs = 0x100;
+
+            do
+            {
+                iMatchByte <<= 1;
+                this->m_RangeEnc.EncodeBit(
+                    pProbs[iOffs + (iMatchByte & iOffs) + (iSymbol >> 8)],
+                    (iSymbol >> 7) & 1);
+                iSymbol <<= 1;
+                iOffs &= ~(iMatchByte ^ iSymbol);
+            } while (iSymbol < 0x10000);
+
+            this->m_iState -= this->m_iState < 10 ? 3 : 6;
+        }
+    }
+
+    // repeats the byte at rep0, which is never changed from its initial
+    // distance of one byte
+    void EncodeRep0(std::uint32_t iPos, std::uint32_t iLen)
+    {
+        const std::uint32_t iPosState = iPos & (LZMA_NUM_POS_STATES - 1);
+
+        this->m_RangeEnc.EncodeBit(
+            this->m_IsMatch[this->m_iState][iPosState], 1);
+        this->m_RangeEnc.EncodeBit(this->m_IsRep[this->m_iState], 1);
+        this->m_RangeEnc.EncodeBit(this->m_IsRepG0[this->m_iState], 0);
+        this->m_RangeEnc.EncodeBit(
+            this->m_IsRep0Long[this->m_iState][iPosState], 1);
+
+        this->EncodeLength(iLen - LZMA_MATCH_MIN_LEN, iPosState);
+
+        this->m_iState = this->m_iState < LZMA_NUM_LIT_STATES ? 8 : 11;
+    }
+
+    void EncodeLength(std::uint32_t iSymbol, std::uint32_t iPosState)
+    {
+        LzmaLenProbs_t& probs = this->m_RepLenProbs;
+
+        if (iSymbol < 8)
+        {
+            this->m_RangeEnc.EncodeBit(probs.Choice, 0);
+            this->m_RangeEnc.EncodeBitTree(probs.Low[iPosState].data(), 3,
+                                           iSymbol);
+        }
+        else if (iSymbol < 16)
+        {
+            this->m_RangeEnc.EncodeBit(probs.Choice, 1);
+            this->m_RangeEnc.EncodeBit(probs.Choice2, 0);
+            this->m_RangeEnc.EncodeBitTree(probs.Mid[iPosState].data(), 3,
+                                           iSymbol - 8);
+        }
+        else
+        {
+            this->m_RangeEnc.EncodeBit(probs.Choice, 1);
+            this->m_RangeEnc.EncodeBit(probs.Choice2, 1);
+            this->m_RangeEnc.EncodeBitTree(probs.High.data(), 8, iSymbol - 16);
+        }
+    }
+
+private:
+    CRangeEncoder m_RangeEnc;
+    std::uint32_t m_iState;
+
+    std::array<std::array<std::uint16_t, LZMA_NUM_POS_STATES>, LZMA_NUM_STATES>
+        m_IsMatch;
+    std::array<std::uint16_t, LZMA_NUM_STATES> m_IsRep;
+    std::array<std::uint16_t, LZMA_NUM_STATES> m_IsRepG0;
+    std::array<std::array<std::uint16_t, LZMA_NUM_POS_STATES>, LZMA_NUM_STATES>
+        m_IsRep0Long;
+    std::vector<std::uint16_t> m_vLiteralProbs;
+    LzmaLenProbs_t m_RepLenProbs;
+};
+
+std::vector<std::uint8_t> CompressLzmaChunk(const std::uint8_t* pData,
+                                            std::uint32_t iDataSize)
+{
+    std::vector<std::uint8_t> vChunk(sizeof(lzma_header_t));
+
+    CLzmaRunEncoder encoder(vChunk);
+    encoder.Encode(pData, iDataSize);
+
+    lzma_header_t header;
+    header.id = LZMA_ID;
+    header.actualSize = iDataSize;
+    header.lzmaSize =
+        static_cast<unsigned int>(vChunk.size() - sizeof(lzma_header_t));
+
+    // the dictionary only has to hold the whole chunk
+    const std::uint32_t iDictSize = std::max<std::uint32_t>(iDataSize, 4096);
+    header.properties[0] = LZMA_PROPS_BYTE;
+    std::memcpy(&header.properties[1], &iDictSize, sizeof(iDictSize));
+
+    std::memcpy(vChunk.data(), &header, sizeof(header));
+
+    return vChunk;
+}
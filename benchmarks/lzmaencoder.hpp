@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Compresses data to a Source engine LZMA chunk (an lzma_header_t followed by
+// a raw LZMA stream), like the chunks inside CSO2's LZMA textures.
+//
+// It is not a real compressor: it only emits literals and repeats of the
+// previous byte, which is enough to build valid streams that exercise both of
+// the decoder's main paths without an LZMA SDK encoder.
+std::vector<std::uint8_t> CompressLzmaChunk(const std::uint8_t* pData,
+                                            std::uint32_t iDataSize);
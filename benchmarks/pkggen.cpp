@@ -0,0 +1,273 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "synthetic.hpp"
+
+namespace fs = std::filesystem;
+
+constexpr const std::string_view SYNTHETIC_INDEX_NAME = "synthetic_index.pkg";
+
+struct GenOptions_t
+{
+    fs::path outDir = ".";
+    std::uint32_t iPkgsNum = 1;
+    SyntheticPkgOptions_t pkg;
+    std::uint32_t iTexturesNum = 0;
+    std::uint32_t iTextureSize = 4 * 1024 * 1024;
+};
+
+// Flushes and closes a written file, so a full disk isn't only noticed once
+// the truncated file is read
+static void CloseWrittenFile(std::ofstream& os, const fs::path& path)
+{
+    if (os.good() == false)
+    {
+        throw std::runtime_error("Could not write to " + path.string());
+    }
+
+    os.close();
+
+    if (os.fail() == true)
+    {
+        throw std::runtime_error("Could not close " + path.string());
+    }
+}
+
+static void WriteFile(const fs::path& path, const std::uint8_t* pData,
+                      std::size_t iSize)
+{
+    std::ofstream os(path, std::ios::binary | std::ios::trunc);
+
+    if (os.is_open() == false)
+    {
+        throw std::runtime_error("Could not open " + path.string());
+    }
+
+    os.write(reinterpret_cast<const char*>(pData), iSize);
+    CloseWrittenFile(os, path);
+}
+
+// Streams a PKG to disk, so it never has to fit in memory
+static std::uint64_t WritePkgFile(const fs::path& path,
+                                  std::string_view szvPkgName,
+                                  const SyntheticPkgOptions_t& options)
+{
+    std::ofstream os(path, std::ios::binary | std::ios::trunc);
+
+    if (os.is_open() == false)
+    {
+        throw std::runtime_error("Could not open " + path.string());
+    }
+
+    const std::uint64_t iPkgSize = WriteSyntheticPkg(
+        szvPkgName, options,
+        [&os](const std::uint8_t* pData, std::size_t iSize) {
+            os.write(reinterpret_cast<const char*>(pData), iSize);
+        });
+
+    CloseWrittenFile(os, path);
+    return iPkgSize;
+}
+
+// Parses an argument's value, which must fit in 32 bits
+static std::uint32_t ParseUInt32(std::string_view szvArg,
+                                 const std::string& szValue)
+{
+    // stoull would wrap negative numbers around
+    if (szValue.empty() == true || szValue.front() == '-')
+    {
+        throw std::invalid_argument(std::string(szvArg) +
+                                    " must be an unsigned number");
+    }
+
+    std::size_t iParsedLength;
+    const unsigned long long iValue = std::stoull(szValue, &iParsedLength);
+
+    if (iParsedLength != szValue.length())
+    {
+        throw std::invalid_argument(std::string(szvArg) +
+                                    " must be an unsigned number");
+    }
+
+    if (iValue > UINT32_MAX)
+    {
+        throw std::out_of_range(std::string(szvArg) + " must be at most " +
+                                std::to_string(UINT32_MAX));
+    }
+
+    return static_cast<std::uint32_t>(iValue);
+}
+
+static void PrintUsage(const char* szProgram)
+{
+    std::cerr
+        << "Usage: " << szProgram << " [options]\n"
+        << "  --out-dir <path>     Where to write the files to\n"
+        << "  --pkgs <num>         How many PKGs to write\n"
+        << "  --entries <num>      Entries in each PKG\n"
+        << "  --min-size <bytes>   Smallest entry size\n"
+        << "  --max-size <bytes>   Biggest entry size\n"
+        << "  --size-dist <dist>   'uniform' or 'log' entry sizes\n"
+        << "  --encrypted <ratio>  Fraction of encrypted entries\n"
+        << "  --textures <ratio>   Fraction of entries that are LZMA VTFs\n"
+        << "  --tfo                Use Titanfall Online's PKG header\n"
+        << "  --seed <num>         Seed for the sizes and the data\n"
+        << "  --vtfs <num>         Standalone LZMA VTFs to write\n"
+        << "  --vtf-size <bytes>   Decompressed size of the standalone VTFs\n";
+}
+
+static bool ParseArguments(int argc, char* argv[], GenOptions_t& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string_view szvArg = argv[i];
+
+        if (szvArg == "--tfo")
+        {
+            options.pkg.bTfoPkg = true;
+            continue;
+        }
+
+        if (i + 1 == argc)
+        {
+            return false;
+        }
+
+        const std::string szValue = argv[++i];
+
+        if (szvArg == "--out-dir")
+        {
+            options.outDir = szValue;
+        }
+        else if (szvArg == "--pkgs")
+        {
+            options.iPkgsNum = ParseUInt32(szvArg, szValue);
+        }
+        else if (szvArg == "--entries")
+        {
+            options.pkg.iEntriesNum = ParseUInt32(szvArg, szValue);
+        }
+        else if (szvArg == "--min-size")
+        {
+            options.pkg.iMinFileSize = ParseUInt32(szvArg, szValue);
+        }
+        else if (szvArg == "--max-size")
+        {
+            options.pkg.iMaxFileSize = ParseUInt32(szvArg, szValue);
+        }
+        else if (szvArg == "--size-dist")
+        {
+            if (szValue == "uniform")
+            {
+                options.pkg.SizeDist = SyntheticSizeDist::Uniform;
+            }
+            else if (szValue == "log")
+            {
+                options.pkg.SizeDist = SyntheticSizeDist::LogUniform;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else if (szvArg == "--encrypted")
+        {
+            options.pkg.fEncryptedRatio = std::stod(szValue);
+        }
+        else if (szvArg == "--textures")
+        {
+            options.pkg.fTextureRatio = std::stod(szValue);
+        }
+        else if (szvArg == "--seed")
+        {
+            options.pkg.iSeed = ParseUInt32(szvArg, szValue);
+        }
+        else if (szvArg == "--vtfs")
+        {
+            options.iTexturesNum = ParseUInt32(szvArg, szValue);
+        }
+        else if (szvArg == "--vtf-size")
+        {
+            options.iTextureSize = ParseUInt32(szvArg, szValue);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    GenOptions_t options;
+
+    try
+    {
+        if (ParseArguments(argc, argv, options) == false)
+        {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+
+        fs::create_directories(options.outDir);
+
+        std::vector<std::string> vPkgNames;
+        std::uint64_t iTotalSize = 0;
+
+        for (std::uint32_t i = 0; i < options.iPkgsNum; i++)
+        {
+            const std::string szPkgName = GetSyntheticPkgName(i);
+
+            // every PKG gets different sizes and data
+            SyntheticPkgOptions_t pkgOptions = options.pkg;
+            pkgOptions.iSeed += i;
+
+            const std::uint64_t iPkgSize = WritePkgFile(
+                options.outDir / szPkgName, szPkgName, pkgOptions);
+
+            std::cout << szPkgName << ": " << pkgOptions.iEntriesNum
+                      << " entries, " << iPkgSize << " bytes\n";
+
+            vPkgNames.push_back(szPkgName);
+            iTotalSize += iPkgSize;
+        }
+
+        const std::vector<std::uint8_t> vIndex =
+            BuildSyntheticIndex(SYNTHETIC_INDEX_NAME, vPkgNames);
+        WriteFile(options.outDir / SYNTHETIC_INDEX_NAME, vIndex.data(),
+                  vIndex.size());
+
+        for (std::uint32_t i = 0; i < options.iTexturesNum; i++)
+        {
+            const std::string szTextureName =
+                "synthetic" + std::to_string(i) + ".vtf";
+
+            const std::vector<std::uint8_t> vTexture = BuildSyntheticTexture(
+                options.iTextureSize,
+                GetSyntheticTextureChunkSize(options.iTextureSize),
+                options.pkg.iSeed + i);
+            WriteFile(options.outDir / szTextureName, vTexture.data(),
+                      vTexture.size());
+        }
+
+        std::cout << "Wrote " << options.iPkgsNum << " PKGs (" << iTotalSize
+                  << " bytes), " << SYNTHETIC_INDEX_NAME << " and "
+                  << options.iTexturesNum << " textures\n"
+                  << "Entry key: " << SYNTHETIC_ENTRY_KEY << '\n'
+                  << "Data key: " << SYNTHETIC_DATA_KEY << '\n';
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "pkg_gen: " << e.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,516 @@
+#include "synthetic.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+
+#include <aes.h>
+#include <md5.h>
+#include <modes.h>
+
+#include "encryptedfileimpl.hpp"
+#include "lzmaencoder.hpp"
+#include "lzmatextureimpl.hpp"
+#include "pkg/pkgstructures.hpp"
+
+const std::uint8_t SYNTHETIC_KEY_COLLECTION[4][16] = {
+    { 0x73, 0x79, 0x6E, 0x74, 0x68, 0x65, 0x74, 0x69, 0x63, 0x20, 0x6B, 0x65,
+      0x79, 0x20, 0x30, 0x31 },
+    { 0x73, 0x79, 0x6E, 0x74, 0x68, 0x65, 0x74, 0x69, 0x63, 0x20, 0x6B, 0x65,
+      0x79, 0x20, 0x30, 0x32 },
+    { 0x73, 0x79, 0x6E, 0x74, 0x68, 0x65, 0x74, 0x69, 0x63, 0x20, 0x6B, 0x65,
+      0x79, 0x20, 0x30, 0x33 },
+    { 0x73, 0x79, 0x6E, 0x74, 0x68, 0x65, 0x74, 0x69, 0x63, 0x20, 0x6B, 0x65,
+      0x79, 0x20, 0x30, 0x34 },
+};
+
+constexpr const std::uint64_t PKG_HASH_LEN = 33;
+constexpr const std::uint32_t AES_BLOCK_SIZE = CryptoPP::AES::BLOCKSIZE;
+constexpr const std::uint8_t INDEX_CIPHER_AES = 2;
+constexpr const std::uint16_t INDEX_VERSION = 2;
+// how many entries share a directory
+constexpr const std::uint32_t SYNTHETIC_FILES_PER_DIR = 64;
+
+static std::uint32_t AlignToAesBlock(std::uint32_t iSize)
+{
+    return (iSize + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE * AES_BLOCK_SIZE;
+}
+
+// The same as the library's GeneratePkgFileKey, which is not exported
+static std::string GetPkgFileKeyHex(std::string_view szvPkgName,
+                                    std::string_view szvKey)
+{
+    CryptoPP::Weak::MD5 hash;
+    hash.Update(reinterpret_cast<const std::uint8_t*>(szvKey.data()),
+                szvKey.length());
+    hash.Update(reinterpret_cast<const std::uint8_t*>(szvPkgName.data()),
+                szvPkgName.length());
+
+    std::array<std::uint8_t, CryptoPP::Weak::MD5::DIGESTSIZE> digest;
+    hash.Final(digest.data());
+
+    constexpr const char szHexDigits[] = "0123456789abcdef";
+    std::string szHex;
+
+    for (const std::uint8_t b : digest)
+    {
+        szHex += szHexDigits[b >> 4];
+        szHex += szHexDigits[b & 0xF];
+    }
+
+    return szHex;
+}
+
+// The same as the library's GeneratePkgIndexKey, with the first key
+static std::array<std::uint8_t, 16> GetIndexKey(std::string_view szvFileName)
+{
+    const std::uint32_t iVersion = INDEX_VERSION;
+
+    CryptoPP::Weak::MD5 hash;
+    hash.Update(reinterpret_cast<const std::uint8_t*>(&iVersion),
+                sizeof(iVersion));
+    hash.Update(reinterpret_cast<const std::uint8_t*>(szvFileName.data()),
+                szvFileName.length());
+    hash.Update(SYNTHETIC_KEY_COLLECTION[0], 16);
+
+    std::array<std::uint8_t, 16> key;
+    hash.Final(key.data());
+    return key;
+}
+
+// AES 128 CBC with a zeroed IV, iSize must be a multiple of the block size
+static void EncryptAes(std::uint8_t* pData, std::size_t iSize,
+                       const std::uint8_t* pKey)
+{
+    const std::uint8_t iv[AES_BLOCK_SIZE] = {};
+
+    CryptoPP::CBC_Mode<CryptoPP::AES>::Encryption encryption;
+    encryption.SetKeyWithIV(pKey, 16, iv);
+    encryption.ProcessData(pData, pData, iSize);
+}
+
+// pads the data with PKCS #7 and encrypts it like the index files are
+static std::vector<std::uint8_t> EncryptIndexData(std::string_view szvData,
+                                                  std::string_view szvFileName)
+{
+    const std::size_t iPadding =
+        AES_BLOCK_SIZE - szvData.length() % AES_BLOCK_SIZE;
+
+    std::vector<std::uint8_t> vData(szvData.begin(), szvData.end());
+    vData.insert(vData.end(), iPadding, static_cast<std::uint8_t>(iPadding));
+
+    EncryptAes(vData.data(), vData.size(), GetIndexKey(szvFileName).data());
+
+    return vData;
+}
+
+// Fills a buffer with pseudo random bytes
+static void FillSyntheticData(std::uint8_t* pData, std::size_t iSize,
+                              std::uint64_t iSeed)
+{
+    std::uint64_t iState = iSeed * 0x9E3779B97F4A7C15 + 1;
+
+    for (std::size_t i = 0; i < iSize; i += sizeof(iState))
+    {
+        // xorshift64
+        iState ^= iState << 13;
+        iState ^= iState >> 7;
+        iState ^= iState << 17;
+
+        std::memcpy(pData + i, &iState,
+                    std::min(sizeof(iState), iSize - i));
+    }
+}
+
+std::uint32_t GetSyntheticTextureChunkSize(std::uint32_t iOriginalSize)
+{
+    const std::uint32_t iMinChunkSize = (iOriginalSize + UINT8_MAX - 1) /
+                                        UINT8_MAX;
+    return std::max<std::uint32_t>(iMinChunkSize, 64 * 1024);
+}
+
+static std::uint64_t GetEntrySeed(const SyntheticPkgOptions_t& options,
+                                  std::uint32_t iEntry)
+{
+    return static_cast<std::uint64_t>(options.iSeed) << 32 | iEntry;
+}
+
+// Generates an entry's decrypted data to vOut
+static void BuildEntryData(const SyntheticPkgOptions_t& options,
+                           std::uint32_t iEntry, std::uint32_t iSize,
+                           bool bIsTexture, std::vector<std::uint8_t>& vOut)
+{
+    if (bIsTexture == true)
+    {
+        vOut = BuildSyntheticTexture(
+            iSize, GetSyntheticTextureChunkSize(iSize),
+            static_cast<std::uint32_t>(GetEntrySeed(options, iEntry)));
+    }
+    else
+    {
+        vOut.resize(iSize);
+        FillSyntheticData(vOut.data(), iSize, GetEntrySeed(options, iEntry));
+    }
+}
+
+static std::uint32_t GetRandomFileSize(const SyntheticPkgOptions_t& options,
+                                       std::mt19937& rng)
+{
+    if (options.SizeDist == SyntheticSizeDist::LogUniform)
+    {
+        std::uniform_real_distribution<double> logDist(
+            std::log(options.iMinFileSize + 1.0),
+            std::log(options.iMaxFileSize + 1.0));
+        const double fSize = std::exp(logDist(rng)) - 1;
+
+        return std::clamp(static_cast<std::uint32_t>(fSize),
+                          options.iMinFileSize, options.iMaxFileSize);
+    }
+
+    std::uniform_int_distribution<std::uint32_t> sizeDist(
+        options.iMinFileSize, options.iMaxFileSize);
+    return sizeDist(rng);
+}
+
+std::uint64_t WriteSyntheticPkg(std::string_view szvPkgName,
+                                const SyntheticPkgOptions_t& options,
+                                const SyntheticWriter_t& write)
+{
+    if (options.iMinFileSize > options.iMaxFileSize)
+    {
+        throw std::invalid_argument(
+            "The minimum file size is bigger than the maximum");
+    }
+
+    std::mt19937 rng(options.iSeed);
+    std::bernoulli_distribution encryptedDist(options.fEncryptedRatio);
+    std::bernoulli_distribution textureDist(options.fTextureRatio);
+
+    std::vector<uc2::PkgEntryHeader_t> vEntries(options.iEntriesNum);
+    // the textures' original sizes, or zero if the entry isn't a texture
+    std::vector<std::uint32_t> vTextureSizes(options.iEntriesNum);
+    std::vector<std::uint8_t> vEntryData;
+    std::uint64_t iDataSize = 0;
+
+    // the entry table comes before the data, so every entry's size must be
+    // known first. A texture's size is only known once it's compressed, so
+    // textures are built twice instead of being kept in memory.
+    for (std::uint32_t i = 0; i < options.iEntriesNum; i++)
+    {
+        uc2::PkgEntryHeader_t& entry = vEntries[i];
+        std::memset(&entry, 0, sizeof(entry));
+
+        const std::uint32_t iFileSize = GetRandomFileSize(options, rng);
+        const bool bIsEncrypted = encryptedDist(rng);
+        const bool bIsTexture = textureDist(rng) && iFileSize != 0;
+        vTextureSizes[i] = bIsTexture == true ? iFileSize : 0;
+
+        std::snprintf(entry.szFilePath, sizeof(entry.szFilePath),
+                      "synthetic/dir%05u/file%08u.%s",
+                      i / SYNTHETIC_FILES_PER_DIR, i,
+                      bIsTexture == true ? "vtf" : "bin");
+
+        std::uint32_t iDecryptedSize = iFileSize;
+
+        if (bIsTexture == true)
+        {
+            BuildEntryData(options, i, iFileSize, true, vEntryData);
+            iDecryptedSize = static_cast<std::uint32_t>(vEntryData.size());
+        }
+
+        const std::uint32_t iEncryptedSize =
+            bIsEncrypted == true ? AlignToAesBlock(iDecryptedSize) :
+                                   iDecryptedSize;
+
+        if (iDataSize + iEncryptedSize > UINT32_MAX)
+        {
+            throw std::length_error(
+                "The entries' data does not fit in 32 bits offsets, use more "
+                "PKGs or fewer entries");
+        }
+
+        entry.iOffset = static_cast<std::uint32_t>(iDataSize);
+        entry.iEncryptedSize = iEncryptedSize;
+        entry.iDecryptedSize = iDecryptedSize;
+        entry.bIsEncrypted = bIsEncrypted == true ? 1 : 0;
+
+        iDataSize += iEncryptedSize;
+    }
+
+    const std::string szHeaderKey =
+        GetPkgFileKeyHex(szvPkgName, SYNTHETIC_ENTRY_KEY)
+            .substr(0, uc2::PKG_ENTRY_KEY_LEN);
+    const auto pHeaderKey =
+        reinterpret_cast<const std::uint8_t*>(szHeaderKey.data());
+
+    // the hash isn't validated, but it names the PKG in entry caches
+    std::array<std::uint8_t, PKG_HASH_LEN> hash = {};
+    const std::string szHash =
+        GetPkgFileKeyHex(szvPkgName, std::to_string(options.iSeed));
+    std::copy(szHash.begin(), szHash.end(), hash.begin());
+    write(hash.data(), hash.size());
+
+    std::uint64_t iHeaderSize;
+
+    if (options.bTfoPkg == true)
+    {
+        uc2::PkgHeaderTfo_t header;
+        std::memset(&header, 0, sizeof(header));
+        header.iEntries = options.iEntriesNum;
+
+        auto pHeader = reinterpret_cast<std::uint8_t*>(&header);
+        EncryptAes(pHeader, sizeof(header), pHeaderKey);
+        write(pHeader, sizeof(header));
+        iHeaderSize = sizeof(header);
+    }
+    else
+    {
+        uc2::PkgHeader_t header;
+        std::memset(&header, 0, sizeof(header));
+        std::snprintf(header.szDirectoryPath, sizeof(header.szDirectoryPath),
+                      "synthetic/");
+        header.iEntries = options.iEntriesNum;
+
+        auto pHeader = reinterpret_cast<std::uint8_t*>(&header);
+        EncryptAes(pHeader, sizeof(header), pHeaderKey);
+        write(pHeader, sizeof(header));
+        iHeaderSize = sizeof(header);
+    }
+
+    // every entry header is encrypted on its own
+    std::vector<uc2::PkgEntryHeader_t> vEncryptedEntries = vEntries;
+
+    for (auto&& entry : vEncryptedEntries)
+    {
+        EncryptAes(reinterpret_cast<std::uint8_t*>(&entry), sizeof(entry),
+                   pHeaderKey);
+    }
+
+    write(reinterpret_cast<const std::uint8_t*>(vEncryptedEntries.data()),
+          vEncryptedEntries.size() * sizeof(uc2::PkgEntryHeader_t));
+
+    for (std::uint32_t i = 0; i < options.iEntriesNum; i++)
+    {
+        const uc2::PkgEntryHeader_t& entry = vEntries[i];
+        const std::uint32_t iEncryptedSize = entry.iEncryptedSize;
+
+        const bool bIsTexture = vTextureSizes[i] != 0;
+        BuildEntryData(options, i,
+                       bIsTexture == true ? vTextureSizes[i] :
+                                            entry.iDecryptedSize,
+                       bIsTexture, vEntryData);
+        vEntryData.resize(iEncryptedSize);
+
+        if (entry.bIsEncrypted != 0)
+        {
+            const std::string_view szvPath = entry.szFilePath;
+            const std::string szKey =
+                GetPkgFileKeyHex(szvPath.substr(szvPath.rfind('/') + 1),
+                                 SYNTHETIC_DATA_KEY)
+                    .substr(0, uc2::PKG_ENTRY_KEY_LEN);
+
+            // and so is every data block
+            for (std::uint64_t iOffset = 0; iOffset < iEncryptedSize;
+                 iOffset += uc2::PKG_DATA_BLOCK_SIZE)
+            {
+                EncryptAes(
+                    vEntryData.data() + iOffset,
+                    std::min(uc2::PKG_DATA_BLOCK_SIZE,
+                             iEncryptedSize - iOffset),
+                    reinterpret_cast<const std::uint8_t*>(szKey.data()));
+            }
+        }
+
+        write(vEntryData.data(), vEntryData.size());
+    }
+
+    return PKG_HASH_LEN + iHeaderSize +
+           vEntries.size() * sizeof(uc2::PkgEntryHeader_t) + iDataSize;
+}
+
+std::vector<std::uint8_t> BuildSyntheticPkg(
+    std::string_view szvPkgName, const SyntheticPkgOptions_t& options)
+{
+    std::vector<std::uint8_t> vPkg;
+
+    WriteSyntheticPkg(szvPkgName, options,
+                      [&vPkg](const std::uint8_t* pData, std::size_t iSize) {
+                          vPkg.insert(vPkg.end(), pData, pData + iSize);
+                      });
+
+    return vPkg;
+}
+
+std::string GetSyntheticPkgName(std::uint32_t iIndex)
+{
+    return GetPkgFileKeyHex(std::to_string(iIndex), "synthetic pkg") + ".pkg";
+}
+
+std::vector<std::uint8_t> BuildSyntheticIndex(
+    std::string_view szvIndexName, const std::vector<std::string>& vPkgNames)
+{
+    // the first line is the index's own name
+    std::string szText(szvIndexName);
+    szText += "\r\n";
+
+    for (const std::string& szPkgName : vPkgNames)
+    {
+        szText += szPkgName;
+        szText += "\r\n";
+    }
+
+    const std::vector<std::uint8_t> vEncrypted =
+        EncryptIndexData(szText, szvIndexName);
+
+    uc2::PkgIndexHeader_t header;
+    header.iVersion = INDEX_VERSION;
+    header.iCipher = INDEX_CIPHER_AES;
+    header.iKey = 0;
+    header.iFileSize = static_cast<std::uint32_t>(vEncrypted.size());
+
+    std::vector<std::uint8_t> vIndex(sizeof(header));
+    std::memcpy(vIndex.data(), &header, sizeof(header));
+    vIndex.insert(vIndex.end(), vEncrypted.begin(), vEncrypted.end());
+
+    return vIndex;
+}
+
+std::string BuildSyntheticTable(std::uint32_t iRowsNum,
+                                std::uint32_t iColumnsNum,
+                                std::uint32_t iSeed /*= 1*/)
+{
+    std::mt19937 rng(iSeed);
+    std::string szTable;
+
+    for (std::uint32_t c = 0; c < iColumnsNum; c++)
+    {
+        szTable += c != 0 ? ",column" : "column";
+        szTable += std::to_string(c);
+    }
+
+    szTable += "\r\n";
+
+    for (std::uint32_t r = 0; r < iRowsNum; r++)
+    {
+        for (std::uint32_t c = 0; c < iColumnsNum; c++)
+        {
+            if (c != 0)
+            {
+                szTable += ',';
+            }
+
+            // alternate between numbers and names, like the game's tables
+            if (c % 2 == 0)
+            {
+                szTable += std::to_string(rng() % 100000);
+            }
+            else
+            {
+                szTable += "name_";
+                szTable += std::to_string(rng());
+            }
+        }
+
+        szTable += "\r\n";
+    }
+
+    return szTable;
+}
+
+std::vector<std::uint8_t> BuildSyntheticEncryptedFile(
+    std::string_view szvFileName, std::string_view szvText)
+{
+    const std::vector<std::uint8_t> vEncrypted =
+        EncryptIndexData(szvText, szvFileName);
+
+    uc2::EncryptedFileHeader_t header;
+    std::memset(&header, 0, sizeof(header));
+    header.version = INDEX_VERSION;
+    header.cipher = INDEX_CIPHER_AES;
+    header.flag = 0;
+    header.fileSize = static_cast<std::uint32_t>(vEncrypted.size());
+
+    std::vector<std::uint8_t> vFile(sizeof(header));
+    std::memcpy(vFile.data(), &header, sizeof(header));
+    vFile.insert(vFile.end(), vEncrypted.begin(), vEncrypted.end());
+
+    return vFile;
+}
+
+std::vector<std::uint8_t> BuildSyntheticTexture(std::uint32_t iOriginalSize,
+                                                std::uint32_t iChunkSize,
+                                                std::uint32_t iSeed /*= 1*/)
+{
+    if (iChunkSize == 0)
+    {
+        throw std::invalid_argument("The chunk size cannot be zero");
+    }
+
+    const std::uint32_t iChunksNum =
+        (iOriginalSize + iChunkSize - 1) / iChunkSize;
+
+    if (iChunksNum > UINT8_MAX)
+    {
+        throw std::invalid_argument("A texture has at most 255 chunks");
+    }
+
+    // texture-like data: short runs of the same byte between random bytes
+    std::mt19937 rng(iSeed);
+    std::vector<std::uint8_t> vOriginal(iOriginalSize);
+
+    for (std::uint32_t i = 0; i < iOriginalSize;)
+    {
+        const std::uint32_t iRandom = rng();
+        const std::uint32_t iRunLen =
+            std::min(2 + iRandom % 24, iOriginalSize - i);
+
+        if ((iRandom >> 16) % 4 == 0)
+        {
+            std::fill_n(vOriginal.begin() + i, iRunLen,
+                        static_cast<std::uint8_t>(iRandom >> 24));
+            i += iRunLen;
+        }
+        else
+        {
+            vOriginal[i++] = static_cast<std::uint8_t>(iRandom >> 24);
+        }
+    }
+
+    const std::size_t iTableSize =
+        sizeof(uc2::LzmaVtfHeader_t) + iChunksNum * 2 * sizeof(std::uint32_t);
+    std::vector<std::uint8_t> vTexture(iTableSize);
+    std::vector<std::uint32_t> vChunkTable(iChunksNum * 2);
+
+    for (std::uint32_t i = 0; i < iChunksNum; i++)
+    {
+        const std::uint32_t iOffset = i * iChunkSize;
+        const std::uint32_t iSize =
+            std::min(iChunkSize, iOriginalSize - iOffset);
+
+        const std::vector<std::uint8_t> vChunk =
+            CompressLzmaChunk(vOriginal.data() + iOffset, iSize);
+
+        // the lowest bit marks the chunk as compressed
+        const auto iChunkOffset = static_cast<std::uint32_t>(vTexture.size());
+        vChunkTable[i * 2] = iChunkOffset << 1 | 1;
+        vChunkTable[i * 2 + 1] = iSize;
+
+        vTexture.insert(vTexture.end(), vChunk.begin(), vChunk.end());
+    }
+
+    uc2::LzmaVtfHeader_t header;
+    header.Signature.iHighByte = uc2::CSO2_LZMA_VTF_HWORD_SIGNATURE;
+    header.Signature.iLowWord = uc2::CSO2_LZMA_VTF_LWORD_SIGNATURE;
+    header.iProbs = static_cast<std::uint8_t>(iChunksNum);
+    header.iOriginalSize = iOriginalSize;
+
+    std::memcpy(vTexture.data(), &header, sizeof(header));
+    std::memcpy(vTexture.data() + sizeof(header), vChunkTable.data(),
+                vChunkTable.size() * sizeof(std::uint32_t));
+
+    return vTexture;
+}
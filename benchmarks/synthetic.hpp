@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// The keys every synthetic file is encrypted with. They are not any game's
+// keys, so no game file is needed to build or to read the synthetic files.
+constexpr const std::string_view SYNTHETIC_ENTRY_KEY =
+    "libuncso2 synthetic entry key";
+constexpr const std::string_view SYNTHETIC_DATA_KEY =
+    "libuncso2 synthetic data key";
+extern const std::uint8_t SYNTHETIC_KEY_COLLECTION[4][16];
+
+enum class SyntheticSizeDist
+{
+    Uniform,
+    // as many small files as big files in each order of magnitude, which
+    // is closer to the games' PKGs
+    LogUniform,
+};
+
+struct SyntheticPkgOptions_t
+{
+    std::uint32_t iEntriesNum = 1000;
+    // the entries' sizes are distributed between these
+    std::uint32_t iMinFileSize = 1024;
+    std::uint32_t iMaxFileSize = 64 * 1024;
+    SyntheticSizeDist SizeDist = SyntheticSizeDist::Uniform;
+    // how many of the entries are encrypted, from 0 to 1
+    double fEncryptedRatio = 1.0;
+    // how many of the entries are LZMA textures, from 0 to 1. The texture's
+    // original size is the entry's size.
+    double fTextureRatio = 0.0;
+    // use Titanfall Online's PKG header instead of CSO2's
+    bool bTfoPkg = false;
+    std::uint32_t iSeed = 1;
+};
+
+// Receives the synthetic files' data, in order
+using SyntheticWriter_t =
+    std::function<void(const std::uint8_t* pData, std::size_t iSize)>;
+
+// Writes a PKG file piece by piece, so PKGs bigger than the memory can be
+// written. The PKG's file name is part of its entry key, so PkgFile must be
+// given the same szvPkgName. Returns the PKG's size.
+std::uint64_t WriteSyntheticPkg(std::string_view szvPkgName,
+                                const SyntheticPkgOptions_t& options,
+                                const SyntheticWriter_t& write);
+
+// The same as WriteSyntheticPkg, to a buffer
+std::vector<std::uint8_t> BuildSyntheticPkg(
+    std::string_view szvPkgName, const SyntheticPkgOptions_t& options);
+
+// A PKG file name like the games' ones, which are MD5 digests
+std::string GetSyntheticPkgName(std::uint32_t iIndex);
+
+// Builds an index file listing the PKG file names
+std::vector<std::uint8_t> BuildSyntheticIndex(
+    std::string_view szvIndexName, const std::vector<std::string>& vPkgNames);
+
+// Builds a CSV table like the ones inside .ecsv files, with a header row
+std::string BuildSyntheticTable(std::uint32_t iRowsNum,
+                                std::uint32_t iColumnsNum,
+                                std::uint32_t iSeed = 1);
+
+// Encrypts szvText to an .e* file, such as an .ecsv
+std::vector<std::uint8_t> BuildSyntheticEncryptedFile(
+    std::string_view szvFileName, std::string_view szvText);
+
+// The smallest chunk size, of at least 64 KiB, that fits a texture of
+// iOriginalSize bytes in 255 chunks
+std::uint32_t GetSyntheticTextureChunkSize(std::uint32_t iOriginalSize);
+
+// Builds an LZMA texture whose data is split in chunks of iChunkSize bytes.
+// A texture has at most 255 chunks.
+std::vector<std::uint8_t> BuildSyntheticTexture(std::uint32_t iOriginalSize,
+                                                std::uint32_t iChunkSize,
+                                                std::uint32_t iSeed = 1);
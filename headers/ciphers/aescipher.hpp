@@ -1,7 +1,11 @@
 #pragma once
 
+#include "aeskernels.hpp"
 #include "basecipher.hpp"
 
+#include <aes.h>
+#include <modes.h>
+
 namespace uc2
 {
 class CAesCipher : public IBaseCipher
@@ -14,5 +18,12 @@ public:
                             bool paddingEnabled = false);
     virtual std::uint64_t Decrypt(gsl::span<const std::uint8_t> inData,
                                   gsl::span<std::uint8_t> outBuffer);
+    virtual std::size_t GetBlockSize() const;
+
+private:
+    // used when the CPU has no AES instructions, or for other key lengths
+    CryptoPP::CBC_Mode<CryptoPP::AES>::Decryption m_Decryption;
+    AesKernel m_Kernel;
+    AesDecryptionKeys_t m_DecryptionKeys;
 };
 }  // namespace uc2
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace uc2
+{
+// The native AES CBC decryption kernels, from slowest to fastest
+enum class AesKernel
+{
+    // the CPU has no AES instructions, Crypto++ must be used
+    None,
+    // AES-NI, decrypting 8 blocks per iteration
+    AesNi,
+    // VAES with AVX-512, decrypting 16 blocks per iteration
+    Vaes512,
+};
+
+// AES 256 has the most rounds
+constexpr const std::size_t AES_MAX_ROUNDS = 14;
+
+// The decryption round keys, in the order the rounds use them
+struct AesDecryptionKeys_t
+{
+    std::array<std::uint8_t, (AES_MAX_ROUNDS + 1) * 16> Bytes;
+    std::size_t iRounds;
+};
+
+// The fastest kernel this CPU and OS support, detected on the first call
+AesKernel GetBestAesKernel();
+
+// Expands a 128 or 256 bits key to its decryption round keys. Returns false
+// if the native kernels can't be used, because the CPU has no AES
+// instructions or the key has another length.
+bool ExpandAesDecryptionKeys(const std::uint8_t* pKey, std::size_t iKeyLength,
+                             AesDecryptionKeys_t& outKeys);
+
+// Decrypts iBlocksNum AES CBC blocks from pInData to pOutBuffer. Both
+// buffers may be the same.
+void DecryptAesCbc(AesKernel kernel, const AesDecryptionKeys_t& keys,
+                   const std::uint8_t* pIV, const std::uint8_t* pInData,
+                   std::uint8_t* pOutBuffer, std::size_t iBlocksNum);
+}  // namespace uc2
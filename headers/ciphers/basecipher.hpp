@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <gsl/gsl>
 #include <string_view>
@@ -14,10 +15,29 @@ public:
                             bool paddingEnabled = false) = 0;
     virtual std::uint64_t Decrypt(gsl::span<const std::uint8_t> inData,
                                   gsl::span<std::uint8_t> outBuffer) = 0;
+    virtual std::size_t GetBlockSize() const = 0;
+
+    // Decrypts consecutive records of iRecordSize bytes where each record
+    // restarts the CBC chain at the cipher's IV, using a single Decrypt call
+    // over the whole buffer. The padding must be disabled.
+    std::uint64_t DecryptRecords(gsl::span<const std::uint8_t> inData,
+                                 gsl::span<std::uint8_t> outBuffer,
+                                 std::size_t iRecordSize);
+
+protected:
+    void SetIV(std::string_view iv);
+
+    // Validates the input and output sizes before a decryption
+    static void ValidateBuffers(gsl::span<const std::uint8_t> inData,
+                                gsl::span<std::uint8_t> outBuffer,
+                                std::size_t iBlockSize);
+
+    // Returns the decrypted data's length without its PKCS #7 padding
+    static std::uint64_t GetUnpaddedLength(
+        gsl::span<const std::uint8_t> decryptedData, std::size_t iBlockSize);
 
 protected:
-    std::string_view m_szvKey;
-    std::string_view m_szvIV;
+    std::array<std::uint8_t, 16> m_IV;
     bool m_bPaddingEnabled;
 };
 }  // namespace uc2
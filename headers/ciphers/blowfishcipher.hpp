@@ -2,6 +2,9 @@
 
 #include "basecipher.hpp"
 
+#include <blowfish.h>
+#include <modes.h>
+
 namespace uc2
 {
 class CBlowfishCipher : public IBaseCipher
@@ -14,5 +17,9 @@ public:
                             bool paddingEnabled = false);
     virtual std::uint64_t Decrypt(gsl::span<const std::uint8_t> inData,
                                   gsl::span<std::uint8_t> outBuffer);
+    virtual std::size_t GetBlockSize() const;
+
+private:
+    CryptoPP::CBC_Mode<CryptoPP::Blowfish>::Decryption m_Decryption;
 };
 }  // namespace uc2
@@ -40,6 +40,12 @@ public:
 
     std::size_t DecryptInBuffer(void* pBuffer, const std::size_t iLength) const;
 
+    // Decrypts iRecordsNum records of iRecordSize bytes that were each
+    // encrypted separately, like the PKG entry headers
+    std::size_t DecryptRecordsInBuffer(void* pBuffer,
+                                       const std::size_t iRecordSize,
+                                       const std::size_t iRecordsNum) const;
+
 private:
     void Initialize(std::string_view key, std::string_view iv,
                     bool paddingEnabled);
@@ -32,6 +32,8 @@ public:
     virtual ~EncryptedFileImpl() override;
 
     virtual std::pair<std::uint8_t*, std::size_t> Decrypt() override;
+    virtual std::size_t DecryptTo(std::uint8_t* pOutBuffer,
+                                  const std::uint64_t iOutBufferSize) override;
 
     static ptr_t CreateSpan(
         std::string_view fileName, gsl::span<std::uint8_t> fileDataView,
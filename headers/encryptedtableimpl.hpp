@@ -0,0 +1,36 @@
+#pragma once
+
+#include "encryptedtable.hpp"
+
+#include <string_view>
+#include <vector>
+
+namespace uc2
+{
+class EncryptedTableImpl : public EncryptedTable
+{
+public:
+    EncryptedTableImpl(std::string_view szvText, char cDelimiter);
+    virtual ~EncryptedTableImpl() override;
+
+    virtual std::uint64_t GetRowsNum() override;
+    virtual std::uint64_t GetColumnsNum(std::uint64_t iRow) override;
+    virtual std::string_view GetCell(std::uint64_t iRow,
+                                     std::uint64_t iColumn) override;
+    virtual std::int64_t GetCellInteger(std::uint64_t iRow,
+                                        std::uint64_t iColumn) override;
+    virtual double GetCellFloat(std::uint64_t iRow,
+                                std::uint64_t iColumn) override;
+    virtual std::uint64_t FindColumn(std::string_view szvName) override;
+
+private:
+    void Parse(std::string_view szvText, char cDelimiter);
+    void EndRow();
+
+private:
+    // the cells of every row, one row after the other
+    std::vector<std::string_view> m_vCells;
+    // where each row starts in m_vCells, plus where the last row ends
+    std::vector<std::size_t> m_vRowStarts;
+};
+}  // namespace uc2
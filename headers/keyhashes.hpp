@@ -10,6 +10,17 @@ std::vector<std::uint8_t> GeneratePkgIndexKey(
     int iKey, std::string_view szPkgName,
     gsl::span<const std::uint8_t[4][16]> keyCollectionView);
 
+// an MD5 digest encoded as lowercase hexadecimal characters
+using PkgFileKeyHex_t = std::array<char, 32>;
+
 std::string GeneratePkgFileKey(std::string_view szvPkgName,
                                std::string_view szKey);
+
+PkgFileKeyHex_t GeneratePkgFileKeyHex(std::string_view szvPkgName,
+                                      std::string_view szKey);
+
+// Same as GeneratePkgFileKeyHex, but the keys are only derived once for each
+// pair of name and key, since the same file names are found in many PKGs
+PkgFileKeyHex_t GetCachedPkgFileKeyHex(std::string_view szvPkgName,
+                                       std::string_view szKey);
 }  // namespace uc2
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "lzmatexture.hpp"
 
 #include <gsl/gsl>
+#include <string_view>
+#include <vector>
 
 namespace uc2
 {
@@ -29,16 +31,60 @@ class LzmaTextureImpl : public LzmaTexture
 public:
     LzmaTextureImpl(std::vector<std::uint8_t>& texData);
     LzmaTextureImpl(gsl::span<std::uint8_t> texDataView);
+    LzmaTextureImpl(PkgEntry& entry);
     virtual ~LzmaTextureImpl();
 
     virtual std::uint64_t GetOriginalSize() override;
 
     virtual bool Decompress(std::uint8_t* outBuffer,
                             std::uint64_t outBufferSize) override;
+    virtual bool DecompressParallel(std::uint8_t* outBuffer,
+                                    std::uint64_t outBufferSize,
+                                    std::uint32_t iThreadsNum = 0) override;
 
     static bool IsLzmaTextureSpan(gsl::span<std::uint8_t> texData);
 
+private:
+    struct Chunk_t
+    {
+        std::uint8_t* pSource;
+        std::uint64_t iSourceSize;
+        std::uint64_t iOutOffset;
+        std::uint32_t iOutSize;
+        bool bIsCompressed;
+    };
+
+    // Reads the chunk table and places every chunk in the output. Returns
+    // false if a chunk is out of the texture's bounds, or if the chunks'
+    // sizes don't add up to the original size.
+    bool BuildChunkTable(std::vector<Chunk_t>& vOutChunks) const;
+
+    // Places, in order, the chunks whose start has been decrypted, from
+    // iPlacedChunks onwards. Returns false like BuildChunkTable does.
+    bool PlaceDecryptedChunks(std::vector<Chunk_t>& vChunks,
+                              std::size_t& iPlacedChunks,
+                              std::uint64_t& iNextOutOffset,
+                              const std::uint64_t iOutBufferSize) const;
+
+    // Decrypts the entry's next data block. Returns false if every block is
+    // already decrypted.
+    bool DecryptNextEntryBlock();
+
+    // Decompresses a texture being read from a PKG entry, while its data is
+    // still being decrypted.
+    bool DecompressEntry(std::uint8_t* outBuffer,
+                         std::uint64_t outBufferSize,
+                         std::uint32_t iThreadsNum);
+
+    // The entry's path, if the texture is read from a PKG entry
+    std::string_view GetEntryPath() const;
+
 private:
     gsl::span<std::uint8_t> m_TexDataView;
+
+    // only set when the texture's data is decrypted from a PKG entry
+    PkgEntry* m_pEntry;
+    std::vector<std::uint8_t> m_vEntryData;
+    std::uint64_t m_iDecryptedSize;
 };
 }  // namespace uc2
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "lzmatexturereader.hpp"
+
+#include <functional>
+#include <vector>
+
+class CLZMAStream;
+
+namespace uc2
+{
+class LzmaTextureReaderImpl : public LzmaTextureReader
+{
+public:
+    // Returns the next piece of compressed input, or a size of zero at the
+    // end of the input
+    using InputSource_t =
+        std::function<std::pair<const std::uint8_t*, std::uint64_t>()>;
+
+    LzmaTextureReaderImpl(InputSource_t inputSource);
+    virtual ~LzmaTextureReaderImpl() override;
+
+    virtual std::pair<const std::uint8_t*, std::uint64_t> Next() override;
+
+    virtual std::uint64_t GetOriginalSize() override;
+    virtual std::uint64_t GetPosition() override;
+    virtual bool IsFinished() override;
+
+private:
+    struct Chunk_t
+    {
+        std::uint64_t iSourceOffset;
+        std::uint32_t iPlainSize;  // only set in uncompressed chunks
+        bool bIsCompressed;
+    };
+
+    void ReadHeader();
+
+    // Makes sure there's input left, returns false at the end of the input
+    bool PullInput();
+    void ConsumeInput(std::uint64_t iBytes);
+    void SkipInputTo(std::uint64_t iSourceOffset);
+
+    void StartChunk();
+    void FinishChunk();
+    // Both return how many bytes were written to the output
+    std::uint64_t ReadPlainChunk(std::uint8_t* pOutput,
+                                 std::uint64_t iOutputSize);
+    std::uint64_t ReadCompressedChunk(std::uint8_t* pOutput,
+                                      std::uint64_t iOutputSize);
+
+private:
+    InputSource_t m_InputSource;
+
+    // what's left of the last piece of input
+    const std::uint8_t* m_pInput;
+    std::uint64_t m_iInputLeft;
+    // the offset of m_pInput in the compressed texture
+    std::uint64_t m_iInputOffset;
+
+    bool m_bHeaderRead;
+    std::uint64_t m_iOriginalSize;
+    std::vector<Chunk_t> m_Chunks;
+
+    std::size_t m_iCurChunk;
+    bool m_bChunkStarted;
+    std::uint64_t m_iPlainLeft;
+    std::unique_ptr<CLZMAStream> m_pLzmaStream;
+
+    std::uint64_t m_iPosition;
+    std::vector<std::uint8_t> m_vWindow;
+};
+}  // namespace uc2
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <gsl/gsl>
+
+namespace uc2
+{
+// Maps a whole file to memory as copy-on-write, so it can be decrypted in
+// place without touching the file on disk. Pages are only read when
+// they're accessed.
+class CMappedFile
+{
+public:
+    CMappedFile(const std::filesystem::path& filePath);
+    ~CMappedFile();
+
+    const std::filesystem::path& GetPath() const;
+    gsl::span<std::uint8_t> GetView() const;
+
+private:
+    std::filesystem::path m_FilePath;
+
+    std::uint8_t* m_pData;
+    std::uint64_t m_iSize;
+
+private:
+    CMappedFile() = delete;
+    CMappedFile(const CMappedFile&) = delete;
+    CMappedFile& operator=(const CMappedFile&) = delete;
+};
+}  // namespace uc2
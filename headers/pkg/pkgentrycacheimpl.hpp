@@ -0,0 +1,66 @@
+#pragma once
+
+#include "pkgentrycache.hpp"
+
+#include <gsl/gsl>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "pkg/pkgstructures.hpp"
+
+namespace uc2
+{
+class CMappedFile;
+
+class PkgEntryCacheImpl : public PkgEntryCache
+{
+public:
+    // A PKG's decrypted entry table
+    struct Table_t
+    {
+        std::uint64_t iFileSize;
+        std::uint64_t iDataStartOffset;
+        gsl::span<const PkgEntryHeader_t> Entries;
+
+        // holds the entries of tables that are not in the cache file yet
+        std::vector<PkgEntryHeader_t> vOwnedEntries;
+    };
+
+public:
+    PkgEntryCacheImpl(const std::filesystem::path& cachePath);
+    virtual ~PkgEntryCacheImpl() override;
+
+    virtual void Save() override;
+    virtual std::uint64_t GetArchivesNum() override;
+
+    // Returns the PKG's table, or null if it isn't cached. The table is valid
+    // until the cache is saved or destroyed.
+    const Table_t* FindTable(std::string_view szvMd5Hash,
+                             std::uint64_t iFileSize);
+    // Replaces a cached table with the same MD5 hash only if its file size
+    // differs. The replaced table stays valid until the cache is saved.
+    void StoreTable(std::string_view szvMd5Hash, std::uint64_t iFileSize,
+                    std::uint64_t iDataStartOffset,
+                    gsl::span<const PkgEntryHeader_t> entries);
+
+private:
+    void Load();
+    bool LoadTables(gsl::span<const std::uint8_t> cacheData);
+
+private:
+    std::filesystem::path m_CachePath;
+    std::unique_ptr<CMappedFile> m_pMappedFile;
+
+    // the tables are keyed by their PKG's MD5 hash
+    std::unordered_map<std::string, Table_t> m_Tables;
+    // the replaced tables, which may still be in use until the cache is saved
+    std::vector<std::unordered_map<std::string, Table_t>::node_type>
+        m_vRetiredTables;
+    std::mutex m_TablesMutex;
+
+    bool m_bHasNewTables;
+};
+}  // namespace uc2
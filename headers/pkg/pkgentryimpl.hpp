@@ -2,24 +2,36 @@
 
 #include "pkgentry.hpp"
 
+#include <array>
 #include <gsl/gsl>
 #include <string>
 #include <string_view>
 
+#include "pkg/pkgstructures.hpp"
+
 namespace uc2
 {
+class CThreadPool;
+
 class PkgEntryImpl : public PkgEntry
 {
 public:
     PkgEntryImpl(std::string_view filePath, std::uint64_t pkgFileOffset,
                  std::uint64_t encryptedSize, std::uint64_t decryptedSize,
                  bool isEncrypted, gsl::span<std::uint8_t> fileData,
-                 std::string_view szvPkgKey = {});
+                 std::string_view szvPkgKey = {},
+                 CThreadPool* pDecryptPool = nullptr);
     virtual ~PkgEntryImpl() override;
 
 public:
     virtual std::pair<std::uint8_t*, std::uint64_t> DecryptFile(
         const std::uint64_t iBytesToDecrypt = 0) override;
+    virtual std::uint64_t ReadRange(const std::uint64_t iOffset,
+                                    const std::uint64_t iLength,
+                                    std::uint8_t* pOutBuffer) override;
+    virtual std::uint64_t DecryptFileTo(
+        std::uint8_t* pOutBuffer, const std::uint64_t iOutBufferSize,
+        const std::uint64_t iBytesToDecrypt = 0) override;
 
     virtual const std::string_view GetFilePath() override;
     virtual std::uint64_t GetPkgFileOffset() override;
@@ -27,24 +39,46 @@ public:
     virtual std::uint64_t GetDecryptedSize() override;
     virtual bool IsEncrypted() override;
 
+    // Decrypts, in place, a piece of the entry's data that the caller read
+    // by itself. The piece must start at a PKG_DATA_BLOCK_SIZE boundary.
+    void DecryptDataInBuffer(std::uint8_t* pData,
+                             const std::uint64_t iDataSize) const;
+
     void SetDataBufferView(gsl::span<std::uint8_t> newDataView);
     void ReleaseDataBufferView();
 
+    // The name of the PKG holding the entry, only used by the trace events.
+    // It must outlive the entry.
+    void SetPkgFilename(std::string_view szvPkgFilename);
+
 private:
     std::pair<std::uint8_t*, std::uint64_t> HandleEncryptedFile(
         const std::uint64_t iBytesToDecrypt) const;
     std::pair<std::uint8_t*, std::uint64_t> HandlePlainFile(
         const std::uint64_t iBytesToDecrypt) const noexcept;
 
+    // Decrypts the bytes [iOffset, iOffset + iLength) of the entry's data in
+    // pInData to pOutBuffer, only touching the cipher blocks holding them.
+    // Both buffers may be the same if iOffset is zero.
+    void DecryptRange(const std::uint8_t* pInData, std::uint8_t* pOutBuffer,
+                      const std::uint64_t iOffset,
+                      const std::uint64_t iLength) const;
+
 private:
     gsl::span<std::uint8_t> m_FileDataView;
 
-    std::string m_szHashedKey;
+    std::array<char, PKG_ENTRY_KEY_LEN> m_HashedKey;
+
+    CThreadPool* m_pDecryptPool;
 
     std::string m_szFilePath;
     std::uint64_t m_iPkgFileOffset;
     std::uint64_t m_iEncryptedSize;
     std::uint64_t m_iDecryptedSize;
     bool m_bIsEncrypted;
+
+#ifdef UNCSO2_TRACING
+    std::string_view m_szvPkgFilename;
+#endif
 };
 }  // namespace uc2
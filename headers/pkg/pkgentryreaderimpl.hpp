@@ -0,0 +1,36 @@
+#pragma once
+
+#include "pkgentryreader.hpp"
+
+#include <vector>
+
+namespace uc2
+{
+class PkgEntryImpl;
+
+class PkgEntryReaderImpl : public PkgEntryReader
+{
+public:
+    PkgEntryReaderImpl(PkgEntryImpl* pEntry, int iFileDescriptor = -1);
+    virtual ~PkgEntryReaderImpl() override;
+
+    virtual std::pair<const std::uint8_t*, std::uint64_t> Next() override;
+
+    virtual std::uint64_t GetPosition() override;
+    virtual bool IsFinished() override;
+    virtual void Rewind() override;
+
+private:
+    void ReadFromFile(std::uint64_t iFileOffset, std::uint8_t* pOutBuffer,
+                      std::uint64_t iLength) const;
+
+private:
+    PkgEntryImpl* m_pEntry;
+
+    // -1 when the data is read from the entry's buffer
+    int m_iFileDescriptor;
+
+    std::uint64_t m_iPosition;
+    std::vector<std::uint8_t> m_vChunk;
+};
+}  // namespace uc2
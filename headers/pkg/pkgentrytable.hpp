@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <gsl/gsl>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "pkg/pkgstructures.hpp"
+
+namespace uc2
+{
+constexpr const std::size_t PKG_ENTRY_NOT_FOUND = static_cast<std::size_t>(-1);
+
+// A PKG's decrypted entry headers, kept as parallel arrays so the entries'
+// objects can be created only when they're needed.
+//
+// The paths are stored as they are in the PKG, split in their directory and
+// file name. Each directory is stored once and shared by the entries inside
+// it, and everything is referenced by 32 bits indexes into the pools.
+//
+// Paths are looked up like pkgpath.hpp describes, through a hash table built
+// with the table, or through an index sorted by path for prefix searches,
+// built on the first search.
+class CPkgEntryTable
+{
+public:
+    CPkgEntryTable();
+    CPkgEntryTable(gsl::span<const PkgEntryHeader_t> entries,
+                   std::uint64_t iDataStartOffset);
+
+    std::size_t GetSize() const;
+
+    std::string GetFilePath(std::size_t iIndex) const;
+    // the directory keeps its trailing separator, if it has one
+    std::string_view GetDirectory(std::size_t iIndex) const;
+    std::string_view GetFileName(std::size_t iIndex) const;
+
+    std::uint64_t GetPkgFileOffset(std::size_t iIndex) const;
+    std::uint64_t GetEncryptedSize(std::size_t iIndex) const;
+    std::uint64_t GetDecryptedSize(std::size_t iIndex) const;
+    bool IsEncrypted(std::size_t iIndex) const;
+
+    // Returns the index of the entry with the path, or PKG_ENTRY_NOT_FOUND.
+    // If many entries share the path, it returns the first one.
+    std::size_t FindPath(std::string_view szvPath) const;
+
+    // Appends the indexes of the entries whose path starts with the prefix,
+    // in the order of their paths. The prefix's root separators are skipped.
+    void FindPathsByPrefix(std::string_view szvPrefix,
+                           std::vector<std::uint32_t>& vOutIndexes);
+
+private:
+    void BuildPathSlots();
+    void BuildSortedIndexes();
+
+    // the entry's path without its root separators, in two pieces
+    std::pair<std::string_view, std::string_view> GetPathPieces(
+        std::size_t iIndex) const;
+    bool IsEntryPath(std::size_t iIndex, std::string_view szvPath) const;
+
+private:
+    std::uint64_t m_iDataStartOffset;
+
+    std::vector<std::uint32_t> m_vOffsets;
+    std::vector<std::uint32_t> m_vEncryptedSizes;
+    std::vector<std::uint32_t> m_vDecryptedSizes;
+    std::vector<bool> m_vIsEncrypted;
+
+    std::vector<std::uint32_t> m_vDirectoryIds;
+
+    // where every string starts in its pool, followed by the pool's size
+    std::vector<std::uint32_t> m_vDirectoryOffsets;
+    std::vector<std::uint32_t> m_vFileNameOffsets;
+    std::string m_szDirectoryPool;
+    std::string m_szFileNamePool;
+
+    // an open addressing hash table of entry indexes plus one, zero being an
+    // empty slot. Its size is a power of two, at least twice the entries'.
+    std::vector<std::uint32_t> m_vPathSlots;
+
+    // the entries' indexes sorted by path, empty until the first search
+    std::vector<std::uint32_t> m_vSortedIndexes;
+};
+}  // namespace uc2
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "pkgextractor.hpp"
+
+#include <memory>
+
+namespace uc2
+{
+class CThreadPool;
+class PkgEntry;
+
+class PkgExtractorImpl : public PkgExtractor
+{
+public:
+    PkgExtractorImpl(PkgFile* pPkgFile, std::uint32_t iThreadsNum);
+    virtual ~PkgExtractorImpl() override;
+
+    virtual std::uint64_t ExtractAll(
+        const std::filesystem::path& outDirectory) override;
+
+    virtual std::uint32_t GetThreadsNum() override;
+
+private:
+    static std::filesystem::path GetEntryOutPath(
+        PkgEntry& entry, const std::filesystem::path& outDirectory);
+
+    static void ExtractEntry(PkgEntry& entry,
+                             const std::filesystem::path& outPath);
+
+private:
+    PkgFile* m_pPkgFile;
+    std::unique_ptr<CThreadPool> m_pPool;
+};
+}  // namespace uc2
@@ -3,12 +3,19 @@
 #include "pkgfile.hpp"
 
 #include <gsl/gsl>
+#include <memory>
 #include <string>
+#include <unordered_map>
 
+#include "pkg/pkgentrytable.hpp"
 #include "pkg/pkgstructures.hpp"
 
 namespace uc2
 {
+class CMappedFile;
+class CThreadPool;
+class PkgEntryCacheImpl;
+
 class PkgFileImpl : public PkgFile
 {
 public:
@@ -18,6 +25,9 @@ public:
     PkgFileImpl(std::string szFilename, gsl::span<std::uint8_t> fileDataView,
                 std::string szEntryKey = {}, std::string szDataKey = {},
                 PkgFileOptions* pOptions = nullptr);
+    PkgFileImpl(std::unique_ptr<CMappedFile> pMappedFile,
+                std::string szEntryKey = {}, std::string szDataKey = {},
+                PkgFileOptions* pOptions = nullptr);
     virtual ~PkgFileImpl() override;
 
     virtual std::string_view GetFilename() override;
@@ -38,6 +48,13 @@ public:
     virtual void Parse() override;
 
     virtual std::vector<entryptr_t>& GetEntries() override;
+    virtual std::uint64_t GetEntriesNum() override;
+    virtual PkgEntry& GetEntry(std::uint64_t iIndex) override;
+    virtual PkgEntry* FindEntry(std::string_view szvPath) override;
+    virtual std::vector<PkgEntry*> FindEntriesByPrefix(
+        std::string_view szvPrefix) override;
+    virtual std::vector<PkgEntry*> ListDirectory(
+        std::string_view szvDirectory, bool bRecursive = false) override;
 
     static ptr_t CreateSpan(std::string szFilename,
                             gsl::span<std::uint8_t> fileDataView = {},
@@ -63,6 +80,10 @@ private:
     template <typename PkgHeaderType>
     void ParseEntries();
 
+    void CreateEntries(gsl::span<const PkgEntryHeader_t> entries,
+                       std::uint64_t iDataStartOffset);
+    entryptr_t CreateEntry(std::size_t iIndex) const;
+    bool AreAllEntriesCreated() const;
     void UpdateEntriesDataView();
 
     template <typename PkgHeaderType>
@@ -78,11 +99,26 @@ private:
 
     std::string m_szMd5Hash;
 
+    // owns the file data when the PKG was opened by its path
+    std::unique_ptr<CMappedFile> m_pMappedFile;
     gsl::span<std::uint8_t> m_FileDataView;
 
+    // the entries' headers, the entries' objects are created from them
+    CPkgEntryTable m_EntryTable;
+
+    // only filled once every entry is created, since GetEntries returns it
     std::vector<std::unique_ptr<PkgEntry>> m_Entries;
+    // the lazy entries that were requested while m_Entries was empty
+    std::unordered_map<std::uint32_t, std::unique_ptr<PkgEntry>>
+        m_CreatedEntries;
+
+    std::unique_ptr<CThreadPool> m_pDecryptPool;
+
+    // not owned, it may be null
+    PkgEntryCacheImpl* m_pEntryCache;
 
     bool m_bIsTfoPkg;
+    bool m_bLazyEntries;
     bool m_bParsed;
 };
 }  // namespace uc2
@@ -13,9 +13,21 @@ public:
     virtual void SetTfoPkg(bool state) override;
     virtual bool IsTfoPkg() override;
 
+    virtual void SetDecryptThreads(std::uint32_t iThreadsNum) override;
+    virtual std::uint32_t GetDecryptThreads() override;
+
+    virtual void SetEntryCache(PkgEntryCache* pCache) override;
+    virtual PkgEntryCache* GetEntryCache() override;
+
+    virtual void SetLazyEntries(bool bNewState) override;
+    virtual bool IsLazyEntries() override;
+
     static ptr_t Create();
 
 private:
     bool m_bIsTfoPkg;
+    std::uint32_t m_iDecryptThreads;
+    PkgEntryCache* m_pEntryCache;
+    bool m_bLazyEntries;
 };
 }  // namespace uc2
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "pkgfilesystem.hpp"
+
+#include <vector>
+
+namespace uc2
+{
+class PkgFileSystemImpl : public PkgFileSystem
+{
+public:
+    PkgFileSystemImpl();
+    virtual ~PkgFileSystemImpl() override;
+
+    virtual void AddArchive(PkgFile::ptr_t&& pkgFile) override;
+    virtual std::uint64_t AddIndex(PkgIndex& index,
+                                   const std::filesystem::path& pkgDirectory,
+                                   std::string szEntryKey,
+                                   std::string szDataKey,
+                                   PkgFileOptions* options = nullptr) override;
+
+    virtual std::pair<PkgFile*, PkgEntry*> Find(
+        std::string_view szvPath) override;
+    virtual PkgEntry* FindEntry(std::string_view szvPath) override;
+
+    virtual std::uint64_t GetArchivesNum() override;
+    virtual std::uint64_t GetEntriesNum() override;
+
+private:
+    // An open addressing hash table slot. It's empty when pEntry is null.
+    struct Slot_t
+    {
+        std::uint64_t iHash;
+        PkgEntry* pEntry;
+        std::uint32_t iArchive;
+    };
+
+    void Insert(PkgEntry* pEntry, std::uint32_t iArchive);
+    void Grow();
+
+    // Returns the slot holding the path, or the empty slot where it belongs
+    std::size_t FindSlot(std::string_view szvPath, std::uint64_t iHash) const;
+
+private:
+    std::vector<PkgFile::ptr_t> m_Archives;
+
+    // the capacity is always a power of two
+    std::vector<Slot_t> m_Slots;
+    std::size_t m_iUsedSlots;
+};
+}  // namespace uc2
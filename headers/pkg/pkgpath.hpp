@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// PKG paths are looked up without their leading separators, with '\' and '/'
+// being the same separator, and ignoring the case of ASCII letters
+namespace uc2
+{
+constexpr const std::uint64_t PKG_PATH_HASH_BASIS = 0xcbf29ce484222325;
+
+// Makes the path separators and letters' case the same in every path
+inline char NormalizePathChar(char c)
+{
+    if (c == '\\')
+    {
+        return '/';
+    }
+
+    if (c >= 'A' && c <= 'Z')
+    {
+        return static_cast<char>(c - 'A' + 'a');
+    }
+
+    return c;
+}
+
+inline std::string_view SkipRootSeparators(std::string_view szvPath)
+{
+    const std::size_t iStart = szvPath.find_first_not_of("/\\");
+    return iStart != std::string_view::npos ? szvPath.substr(iStart) :
+                                              std::string_view();
+}
+
+// 64 bits FNV-1a over the normalized characters. A path split in pieces is
+// hashed by passing each piece the previous piece's hash.
+inline std::uint64_t HashPathChars(std::string_view szvChars,
+                                   std::uint64_t iHash = PKG_PATH_HASH_BASIS)
+{
+    constexpr const std::uint64_t FNV_PRIME = 0x100000001b3;
+
+    for (char c : szvChars)
+    {
+        iHash ^= static_cast<std::uint8_t>(NormalizePathChar(c));
+        iHash *= FNV_PRIME;
+    }
+
+    return iHash;
+}
+
+inline std::uint64_t HashPath(std::string_view szvPath)
+{
+    return HashPathChars(SkipRootSeparators(szvPath));
+}
+
+// Compares the normalized characters of two paths' pieces of the same
+// length
+inline bool ArePathCharsEqual(std::string_view szvCharsA,
+                              std::string_view szvCharsB)
+{
+    for (std::size_t i = 0; i < szvCharsA.length(); i++)
+    {
+        if (NormalizePathChar(szvCharsA[i]) != NormalizePathChar(szvCharsB[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+inline bool ArePathsEqual(std::string_view szvPathA, std::string_view szvPathB)
+{
+    szvPathA = SkipRootSeparators(szvPathA);
+    szvPathB = SkipRootSeparators(szvPathB);
+
+    return szvPathA.length() == szvPathB.length() &&
+           ArePathCharsEqual(szvPathA, szvPathB);
+}
+}  // namespace uc2
@@ -1,9 +1,16 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 namespace uc2
 {
+// every PKG_DATA_BLOCK_SIZE bytes of an entry's data are encrypted on their own
+constexpr const std::uint64_t PKG_DATA_BLOCK_SIZE = 0x10000;
+
+// how many characters of an entry's hex key are used as its AES key
+constexpr const std::size_t PKG_ENTRY_KEY_LEN = 16;
+
 #pragma pack(push, 1)
 
 struct PkgIndexHeader_t
@@ -59,5 +66,30 @@ struct PkgEntryHeader_t
 static_assert(sizeof(PkgEntryHeader_t) == 288,
               "The pkg entry header's size must be 288 bytes long");
 
+// the entry table cache file starts with a PkgEntryCacheHeader_t, followed by
+// iArchives PkgEntryCacheArchive_t and then the decrypted entry tables
+struct PkgEntryCacheHeader_t
+{
+    char Magic[8];
+    std::uint32_t iVersion;
+    std::uint32_t iArchives;
+};
+
+static_assert(sizeof(PkgEntryCacheHeader_t) == 16,
+              "The entry cache header's size must be 16 bytes long");
+
+struct PkgEntryCacheArchive_t
+{
+    char szMd5Hash[32 + 1];
+    std::uint8_t Pad[7];
+    std::uint64_t iFileSize;
+    std::uint64_t iDataStartOffset;
+    std::uint64_t iEntriesOffset;  // from the start of the cache file
+    std::uint64_t iEntries;
+};
+
+static_assert(sizeof(PkgEntryCacheArchive_t) == 72,
+              "The entry cache archive's size must be 72 bytes long");
+
 #pragma pack(pop)
 }  // namespace uc2
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace uc2
+{
+enum class StatsCounter : std::size_t
+{
+    DesBytesDecrypted,
+    AesBytesDecrypted,
+    BlowfishBytesDecrypted,
+    BlocksDecrypted,
+    EntriesParsed,
+    KeysDerived,
+    LzmaChunksDecoded,
+    DecryptNs,
+    KeyDerivationNs,
+    LzmaNs,
+
+    Count
+};
+
+extern std::atomic<bool> g_bStatsEnabled;
+
+inline bool AreStatsEnabled()
+{
+    return g_bStatsEnabled.load(std::memory_order_relaxed);
+}
+
+// Adds to the calling thread's counter
+void AddThreadStat(StatsCounter counter, std::uint64_t iValue);
+
+inline void AddStat(StatsCounter counter, std::uint64_t iValue)
+{
+    if (AreStatsEnabled() == true)
+    {
+        AddThreadStat(counter, iValue);
+    }
+}
+
+// Adds the time spent in its scope to a counter, if the statistics were
+// enabled when it was created
+class CStatsTimer
+{
+public:
+    explicit CStatsTimer(StatsCounter counter)
+        : m_Counter(counter), m_bEnabled(AreStatsEnabled())
+    {
+        if (this->m_bEnabled == true)
+        {
+            this->m_Start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~CStatsTimer()
+    {
+        if (this->m_bEnabled == true)
+        {
+            const auto elapsed =
+                std::chrono::steady_clock::now() - this->m_Start;
+            AddThreadStat(
+                this->m_Counter,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                    .count());
+        }
+    }
+
+    CStatsTimer(const CStatsTimer&) = delete;
+    CStatsTimer& operator=(const CStatsTimer&) = delete;
+
+private:
+    StatsCounter m_Counter;
+    bool m_bEnabled;
+    std::chrono::steady_clock::time_point m_Start;
+};
+}  // namespace uc2
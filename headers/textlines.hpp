@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+namespace uc2
+{
+// Splits decrypted text files, like the PKG index, in their "\r\n"
+// terminated lines. Text after the last line break is not a line.
+// The views point inside szvText.
+std::vector<std::string_view> SplitTextByLine(std::string_view szvText);
+}  // namespace uc2
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace uc2
+{
+class CThreadPool
+{
+public:
+    CThreadPool(std::uint32_t iThreadsNum);
+    ~CThreadPool();
+
+    std::uint32_t GetThreadsNum() const;
+
+    // Calls fn for every index in [0, iCount) using the pool's workers and the
+    // calling thread. It blocks until every index was processed, and rethrows
+    // the first exception thrown by fn.
+    void ParallelFor(std::size_t iCount,
+                     const std::function<void(std::size_t)>& fn);
+    // Same as above, but with at most iMaxThreads threads, counting the
+    // calling one
+    void ParallelFor(std::size_t iCount, std::uint32_t iMaxThreads,
+                     const std::function<void(std::size_t)>& fn);
+
+private:
+    void Enqueue(std::function<void()> task);
+    void WorkerLoop();
+
+private:
+    std::vector<std::thread> m_Workers;
+
+    std::queue<std::function<void()>> m_Tasks;
+    std::mutex m_TasksMutex;
+    std::condition_variable m_TaskAvailable;
+
+    bool m_bStopping;
+
+private:
+    CThreadPool() = delete;
+    CThreadPool(const CThreadPool&) = delete;
+    CThreadPool& operator=(const CThreadPool&) = delete;
+};
+}  // namespace uc2
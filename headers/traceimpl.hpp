@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string_view>
+
+namespace uc2
+{
+// Records a begin event when it's created and an end event when it's
+// destroyed, in the calling thread's trace buffer. szName must be a string
+// literal, the last 63 bytes of szvFile and szvPath are copied.
+class CTraceSpan
+{
+public:
+    CTraceSpan(const char* szName, std::string_view szvFile = {},
+               std::string_view szvPath = {});
+    ~CTraceSpan();
+
+    CTraceSpan(const CTraceSpan&) = delete;
+    CTraceSpan& operator=(const CTraceSpan&) = delete;
+
+private:
+    const char* m_szName;
+};
+}  // namespace uc2
+
+// the spans, and their arguments, are compiled out without tracing
+#ifdef UNCSO2_TRACING
+#define UC2_TRACE_CONCAT_INNER(a, b) a##b
+#define UC2_TRACE_CONCAT(a, b) UC2_TRACE_CONCAT_INNER(a, b)
+#define UC2_TRACE_SPAN(...) \
+    uc2::CTraceSpan UC2_TRACE_CONCAT(traceSpan, __LINE__)(__VA_ARGS__)
+#else
+#define UC2_TRACE_SPAN(...) static_cast<void>(0)
+#endif
@@ -83,6 +83,26 @@ extern "C"
      */
     UNCSO2_API bool UNCSO2_CALLMETHOD uncso2_EncryptedFile_Decrypt(
         EncryptedFile_t fileHandle, void** outBuffer, uint64_t* outSize);
+
+    /**
+     * @brief Decrypts the file to a buffer
+     *
+     * Decrypts the file to the buffer given by the caller, without modifying
+     * the buffer provided in the factory method uncso2_EncryptedFile_Create.
+     * The output buffer must be at least as big as the file's encrypted data,
+     * which is the file's size minus uncso2_EncryptedFile_GetHeaderSize().
+     *
+     * @param fileHandle The EncryptedFile's object handle.
+     * @param outBuffer The buffer to write the decrypted data to.
+     * @param outBufferSize The output buffer's size.
+     * @param outSize A pointer to where the decrypted data's length will be
+     * written.
+     * @return true If the data was decrypted successfully.
+     * @return false If there was an error decrypting the data.
+     */
+    UNCSO2_API bool UNCSO2_CALLMETHOD uncso2_EncryptedFile_DecryptTo(
+        EncryptedFile_t fileHandle, void* outBuffer, uint64_t outBufferSize,
+        uint64_t* outSize);
 #ifdef __cplusplus
 }
 #endif
@@ -49,6 +49,23 @@ public:
      */
     virtual std::pair<std::uint8_t*, std::size_t> Decrypt() = 0;
 
+    /**
+     * @brief Decrypts the file to a buffer.
+     *
+     * Decrypts the file to the buffer given by the caller, without modifying
+     * the data given to this object.
+     *
+     * This method throws exceptions:
+     * - It throws std::length_error when the output buffer is smaller than the
+     * file's encrypted data, which is the file's size minus GetHeaderSize().
+     *
+     * @param pOutBuffer The buffer to write the decrypted data to.
+     * @param iOutBufferSize The output buffer's size.
+     * @return std::size_t How many bytes of decrypted data were written.
+     */
+    virtual std::size_t DecryptTo(std::uint8_t* pOutBuffer,
+                                  const std::uint64_t iOutBufferSize) = 0;
+
     /**
      * @brief Does the buffer data's have an encrypted file header?
      *
@@ -0,0 +1,143 @@
+/**
+ * @file encryptedtable.h
+ * @author Luís Leite (luis@leite.xyz)
+ * @brief Parses the tables inside .ecsv files
+ * @version 1.0
+ *
+ * Contains a class that splits decrypted CSV tables, such as the ones in
+ * 'ecsv' files, in rows and cells without copying them.
+ */
+
+#pragma once
+
+#include "uc2defs.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    /**
+     * @brief Construct a new EncryptedTable object from an encrypted file.
+     *
+     * Decrypts the file like uncso2_EncryptedFile_Decrypt does, in the buffer
+     * given to uncso2_EncryptedFile_Create, and parses the decrypted text.
+     * The file must not have been decrypted before, and its buffer must
+     * outlive the table.
+     * Returns NULL if it failed to create a new object.
+     *
+     * @param fileHandle The EncryptedFile's object handle.
+     * @param delimiter The character between the cells of a row.
+     *
+     * @return EncryptedTable_t The new EncryptedTable's object handle.
+     */
+    UNCSO2_API EncryptedTable_t UNCSO2_CALLMETHOD
+    uncso2_EncryptedTable_Create(EncryptedFile_t fileHandle, char delimiter);
+
+    /**
+     * @brief Construct a new EncryptedTable object from decrypted text.
+     *
+     * The text is not copied, so it must outlive the table.
+     * Returns NULL if it failed to create a new object.
+     *
+     * @param text The table's decrypted text.
+     * @param textSize The text's length.
+     * @param delimiter The character between the cells of a row.
+     *
+     * @return EncryptedTable_t The new EncryptedTable's object handle.
+     */
+    UNCSO2_API EncryptedTable_t UNCSO2_CALLMETHOD
+    uncso2_EncryptedTable_CreateFromText(const char* text, uint64_t textSize,
+                                         char delimiter);
+
+    /**
+     * @brief Destroys an EncryptedTable object.
+     *
+     * Free's the EncryptedTable object stored in the handle.
+     *
+     * @param tableHandle The EncryptedTable's object handle to be destroyed.
+     */
+    UNCSO2_API void UNCSO2_CALLMETHOD
+    uncso2_EncryptedTable_Free(EncryptedTable_t tableHandle);
+
+    /**
+     * @brief Get the number of rows, including the header row.
+     *
+     * @param tableHandle The EncryptedTable's object handle.
+     *
+     * @return uint64_t The number of rows.
+     */
+    UNCSO2_API uint64_t UNCSO2_CALLMETHOD
+    uncso2_EncryptedTable_GetRowsNum(EncryptedTable_t tableHandle);
+
+    /**
+     * @brief Get the number of cells in a row.
+     *
+     * @param tableHandle The EncryptedTable's object handle.
+     * @param row The row's index.
+     *
+     * @return uint64_t The number of cells in the row, or 0 if the row index
+     * is invalid.
+     */
+    UNCSO2_API uint64_t UNCSO2_CALLMETHOD uncso2_EncryptedTable_GetColumnsNum(
+        EncryptedTable_t tableHandle, uint64_t row);
+
+    /**
+     * @brief Get a cell's text.
+     *
+     * The text is not null terminated, and it points inside the table's text.
+     *
+     * @param tableHandle The EncryptedTable's object handle.
+     * @param row The cell's row index.
+     * @param column The cell's column index.
+     * @param outCell A pointer to where the cell's text will be written.
+     * @param outSize A pointer to where the cell's length will be written.
+     * @return true If the cell exists.
+     * @return false If the row or column index is invalid.
+     */
+    UNCSO2_API bool UNCSO2_CALLMETHOD uncso2_EncryptedTable_GetCell(
+        EncryptedTable_t tableHandle, uint64_t row, uint64_t column,
+        const char** outCell, uint64_t* outSize);
+
+    /**
+     * @brief Get a cell's text as a signed integer.
+     *
+     * @param tableHandle The EncryptedTable's object handle.
+     * @param row The cell's row index.
+     * @param column The cell's column index.
+     * @param outValue A pointer to where the cell's integer will be written.
+     * @return true If the cell is an integer.
+     * @return false If the cell does not exist or is not an integer.
+     */
+    UNCSO2_API bool UNCSO2_CALLMETHOD uncso2_EncryptedTable_GetCellInteger(
+        EncryptedTable_t tableHandle, uint64_t row, uint64_t column,
+        int64_t* outValue);
+
+    /**
+     * @brief Get a cell's text as a floating point number.
+     *
+     * @param tableHandle The EncryptedTable's object handle.
+     * @param row The cell's row index.
+     * @param column The cell's column index.
+     * @param outValue A pointer to where the cell's number will be written.
+     * @return true If the cell is a number.
+     * @return false If the cell does not exist or is not a number.
+     */
+    UNCSO2_API bool UNCSO2_CALLMETHOD uncso2_EncryptedTable_GetCellFloat(
+        EncryptedTable_t tableHandle, uint64_t row, uint64_t column,
+        double* outValue);
+
+    /**
+     * @brief Find a column by its name in the first row.
+     *
+     * @param tableHandle The EncryptedTable's object handle.
+     * @param name The column's null terminated name, compared case
+     * sensitively.
+     *
+     * @return uint64_t The column's index, or UINT64_MAX if there is no such
+     * column.
+     */
+    UNCSO2_API uint64_t UNCSO2_CALLMETHOD uncso2_EncryptedTable_FindColumn(
+        EncryptedTable_t tableHandle, const char* name);
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,150 @@
+/**
+ * @file encryptedtable.hpp
+ * @author Luís Leite (luis@leite.xyz)
+ * @brief Parses the tables inside .ecsv files
+ * @version 1.0
+ *
+ * Contains a class that splits decrypted CSV tables, such as the ones in
+ * 'ecsv' files, in rows and cells without copying them.
+ */
+
+#pragma once
+
+#include "uc2defs.h"
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+/**
+ * @brief The libuncso2's namespace.
+ */
+namespace uc2
+{
+class EncryptedFile;
+
+/**
+ * @brief Parses the tables inside .ecsv files.
+ *
+ * The table is parsed once, when it's created, to an array of cells. Every
+ * cell is a view of the text given to the table, so the text must outlive the
+ * table.
+ *
+ * Lines may end with "\r\n" or "\n", and empty lines are skipped. A cell
+ * enclosed in double quotes may have delimiters and line breaks. Its quotes
+ * are not part of the cell, but the doubled quotes inside it are kept as they
+ * are.
+ */
+class UNCSO2_API EncryptedTable
+{
+public:
+    using ptr_t = std::unique_ptr<EncryptedTable>; /*!< The pointer type of
+                                                      EncryptedTable */
+
+    static constexpr const std::uint64_t COLUMN_NOT_FOUND =
+        UINT64_MAX; /*!< Returned by FindColumn when there is no such column */
+
+    virtual ~EncryptedTable() = default;
+
+    /**
+     * @brief Get the number of rows, including the header row.
+     *
+     * @return std::uint64_t The number of rows.
+     */
+    virtual std::uint64_t GetRowsNum() = 0;
+
+    /**
+     * @brief Get the number of cells in a row.
+     *
+     * Rows may have a different number of cells.
+     *
+     * This method throws exceptions:
+     * - It throws std::out_of_range if the row index is past the last row.
+     *
+     * @param iRow The row's index.
+     * @return std::uint64_t The number of cells in the row.
+     */
+    virtual std::uint64_t GetColumnsNum(std::uint64_t iRow) = 0;
+
+    /**
+     * @brief Get a cell's text.
+     *
+     * This method throws exceptions:
+     * - It throws std::out_of_range if the row or the column index is past
+     * the last row or the row's last cell.
+     *
+     * @param iRow The cell's row index.
+     * @param iColumn The cell's column index.
+     * @return std::string_view The cell's text, pointing inside the table's
+     * text.
+     */
+    virtual std::string_view GetCell(std::uint64_t iRow,
+                                     std::uint64_t iColumn) = 0;
+
+    /**
+     * @brief Get a cell's text as a signed integer.
+     *
+     * This method throws exceptions:
+     * - It throws the same exceptions as GetCell.
+     * - It throws std::invalid_argument if the whole cell is not a base 10
+     * integer, or if it does not fit in 64 bits.
+     *
+     * @param iRow The cell's row index.
+     * @param iColumn The cell's column index.
+     * @return std::int64_t The cell's integer.
+     */
+    virtual std::int64_t GetCellInteger(std::uint64_t iRow,
+                                        std::uint64_t iColumn) = 0;
+
+    /**
+     * @brief Get a cell's text as a floating point number.
+     *
+     * This method throws exceptions:
+     * - It throws the same exceptions as GetCell.
+     * - It throws std::invalid_argument if the whole cell is not a number.
+     *
+     * @param iRow The cell's row index.
+     * @param iColumn The cell's column index.
+     * @return double The cell's number.
+     */
+    virtual double GetCellFloat(std::uint64_t iRow, std::uint64_t iColumn) = 0;
+
+    /**
+     * @brief Find a column by its name in the first row.
+     *
+     * @param szvName The column's name, compared case sensitively.
+     * @return std::uint64_t The column's index, or COLUMN_NOT_FOUND if no
+     * cell in the first row has the name.
+     */
+    virtual std::uint64_t FindColumn(std::string_view szvName) = 0;
+
+    /**
+     * @brief Construct a new EncryptedTable object from an encrypted file.
+     *
+     * Decrypts the file with EncryptedFile::Decrypt, in its own buffer, and
+     * parses the decrypted text. The file must not have been decrypted before,
+     * and its data must outlive the table.
+     *
+     * This method throws exceptions:
+     * - It throws the same exceptions as EncryptedFile::Decrypt.
+     *
+     * @param file The encrypted file.
+     * @param cDelimiter The character between the cells of a row.
+     *
+     * @return ptr_t the new EncryptedTable object.
+     */
+    static ptr_t Create(EncryptedFile& file, char cDelimiter = ',');
+
+    /**
+     * @brief Construct a new EncryptedTable object from decrypted text.
+     *
+     * The text is not copied, so it must outlive the table.
+     *
+     * @param szvText The table's decrypted text.
+     * @param cDelimiter The character between the cells of a row.
+     *
+     * @return ptr_t the new EncryptedTable object.
+     */
+    static ptr_t Create(std::string_view szvText, char cDelimiter = ',');
+};
+}  // namespace uc2
@@ -32,6 +32,22 @@ extern "C"
     UNCSO2_API LzmaTexture_t UNCSO2_CALLMETHOD
     uncso2_LzmaTexture_Create(void* texBuffer, uint64_t texSize);
 
+    /**
+     * @brief Construct a new LzmaTexture object from a PKG entry.
+     *
+     * The texture's data is decrypted while it is decompressed, and the
+     * entry's file data is not modified. The entry must outlive the texture.
+     *
+     * It may return NULL if an error occurs.
+     *
+     * @param entryHandle The PkgEntry's object handle.
+     *
+     * @return LzmaTexture_t The new LzmaTexture's object
+     * handle.
+     */
+    UNCSO2_API LzmaTexture_t UNCSO2_CALLMETHOD
+    uncso2_LzmaTexture_CreateFromEntry(PkgEntry_t entryHandle);
+
     /**
      * @brief Destroys a LzmaTexture object.
      *
@@ -91,6 +107,24 @@ extern "C"
      */
     UNCSO2_API bool UNCSO2_CALLMETHOD uncso2_LzmaTexture_Decompress(
         LzmaTexture_t texHandle, void* outBuffer, uint64_t outBufferSize);
+
+    /**
+     * @brief Decompresses the texture's chunks in parallel.
+     *
+     * Works like uncso2_LzmaTexture_Decompress, but the texture's chunks are
+     * decompressed concurrently.
+     *
+     * @param texHandle The LzmaTexture's object handle.
+     * @param outBuffer The user's allocated out buffer.
+     * @param outBufferSize The out buffer's size.
+     * @param threadsNum How many threads to decompress with. Zero means one
+     * thread per CPU core.
+     * @return true if it was decompressed successfully.
+     * @return false if it failed to decompress.
+     */
+    UNCSO2_API bool UNCSO2_CALLMETHOD uncso2_LzmaTexture_DecompressParallel(
+        LzmaTexture_t texHandle, void* outBuffer, uint64_t outBufferSize,
+        uint32_t threadsNum);
 #ifdef __cplusplus
 }
 #endif
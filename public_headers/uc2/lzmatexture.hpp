@@ -21,6 +21,8 @@
  */
 namespace uc2
 {
+class PkgEntry;
+
 /**
  * @brief Decompresses LZMA'd VTFs.
  *
@@ -61,6 +63,28 @@ public:
     virtual bool Decompress(std::uint8_t* outBuffer,
                             std::uint64_t outBufferSize) = 0;
 
+    /**
+     * @brief Decompresses the texture's chunks in parallel.
+     *
+     * Works like Decompress, but every chunk of the texture is decompressed
+     * straight to its place in the outBuffer by its own task, so the chunks of
+     * big textures are decompressed concurrently.
+     *
+     * The chunk table is validated before any chunk is decompressed. The
+     * threads are shared by every texture, and kept for the next calls.
+     * There's at most one thread per CPU core.
+     *
+     * @param outBuffer The user's allocated out buffer.
+     * @param outBufferSize The out buffer's size.
+     * @param iThreadsNum How many threads to decompress with. Zero means one
+     * thread per CPU core.
+     * @return true if it was decompressed successfully.
+     * @return false if it failed to decompress.
+     */
+    virtual bool DecompressParallel(std::uint8_t* outBuffer,
+                                    std::uint64_t outBufferSize,
+                                    std::uint32_t iThreadsNum = 0) = 0;
+
     /**
      * @brief Does the buffer data's have an LZMA texture header?
      *
@@ -107,5 +131,26 @@ public:
      * @return ptr_t the new CompressedTexture object.
      */
     static ptr_t Create(std::uint8_t* pData, const std::uint64_t iDataSize);
+
+    /**
+     * @brief Construct a new CompressedTexture object from a PKG entry.
+     *
+     * Only the entry's first data block is decrypted here, to read the
+     * texture's header. The rest of it is decrypted by Decompress and
+     * DecompressParallel, block by block, and each chunk is decompressed as
+     * soon as the blocks holding it are decrypted, while they are still in
+     * the CPU's cache. The entry's file data is not modified.
+     *
+     * The entry must outlive the new object.
+     *
+     * This method throws exceptions:
+     * - It throws std::invalid_argument when the texture's header is invalid.
+     * - It throws the same exceptions as PkgEntry::ReadRange, and so do the
+     * new object's Decompress and DecompressParallel methods.
+     *
+     * @param entry The PKG entry holding the compressed texture.
+     * @return ptr_t the new CompressedTexture object.
+     */
+    static ptr_t Create(PkgEntry& entry);
 };
 }  // namespace uc2
@@ -0,0 +1,102 @@
+/**
+ * @file lzmatexturereader.h
+ * @author Luís Leite (luis@leite.xyz)
+ * @brief Decompresses LZMA'd VTFs piece by piece.
+ * @version 1.0
+ *
+ * Contains a class that decompresses Valve Texture Files that were compressed
+ * with LZMA, without holding the whole texture in memory.
+ */
+
+#pragma once
+
+#include "uc2defs.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    /**
+     * @brief Construct a new LzmaTextureReader object.
+     *
+     * The buffer is NOT modified, and it must outlive the reader.
+     *
+     * It may return NULL if an error occurs.
+     *
+     * @param texBuffer The compressed texture's data buffer.
+     * @param texSize The compressed texture's data buffer size.
+     *
+     * @return LzmaTextureReader_t A handle to the new LzmaTextureReader
+     * object.
+     */
+    UNCSO2_API LzmaTextureReader_t UNCSO2_CALLMETHOD
+    uncso2_LzmaTextureReader_Create(const void* texBuffer, uint64_t texSize);
+
+    /**
+     * @brief Construct a new LzmaTextureReader object.
+     *
+     * Reads the compressed texture from a PKG entry's reader. The entry reader
+     * must be at the start of the entry, and it must outlive the texture
+     * reader.
+     *
+     * It may return NULL if an error occurs.
+     *
+     * @param entryReaderHandle The PkgEntryReader's object handle.
+     *
+     * @return LzmaTextureReader_t A handle to the new LzmaTextureReader
+     * object.
+     */
+    UNCSO2_API LzmaTextureReader_t UNCSO2_CALLMETHOD
+    uncso2_LzmaTextureReader_CreateFromEntry(
+        PkgEntryReader_t entryReaderHandle);
+
+    /**
+     * @brief Destroys a LzmaTextureReader object.
+     *
+     * Free's the LzmaTextureReader object stored in the handle.
+     *
+     * @param readerHandle The LzmaTextureReader's object handle to be
+     * destroyed.
+     */
+    UNCSO2_API void UNCSO2_CALLMETHOD
+    uncso2_LzmaTextureReader_Free(LzmaTextureReader_t readerHandle);
+
+    /**
+     * @brief Decompresses the next window of the texture.
+     *
+     * The window is stored in a buffer owned by the reader, which is reused by
+     * the next call. The window's size is zero when the whole texture was
+     * decompressed.
+     *
+     * @param readerHandle The LzmaTextureReader's object handle.
+     * @param outBuffer A pointer to where the window's address will be written
+     * to.
+     * @param outSize A pointer to where the window's size will be written to.
+     * @return true If the window was decompressed successfully.
+     * @return false If the texture is truncated or broken.
+     */
+    UNCSO2_API bool UNCSO2_CALLMETHOD
+    uncso2_LzmaTextureReader_Next(LzmaTextureReader_t readerHandle,
+                                  const void** outBuffer, uint64_t* outSize);
+
+    /**
+     * @brief Retrieves the texture's real size.
+     *
+     * @param readerHandle The LzmaTextureReader's object handle.
+     *
+     * @return uint64_t the texture's real size, or zero if its header is
+     * invalid.
+     */
+    UNCSO2_API uint64_t UNCSO2_CALLMETHOD
+    uncso2_LzmaTextureReader_GetOriginalSize(LzmaTextureReader_t readerHandle);
+
+    /**
+     * @brief Get the size of a full window.
+     *
+     * @return uint64_t The size of a full window.
+     */
+    UNCSO2_API uint64_t UNCSO2_CALLMETHOD
+    uncso2_LzmaTextureReader_GetWindowSize();
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,124 @@
+/**
+ * @file lzmatexturereader.hpp
+ * @author Luís Leite (luis@leite.xyz)
+ * @brief Decompresses LZMA'd VTFs piece by piece.
+ * @version 1.0
+ *
+ * Contains a class that decompresses Valve Texture Files that were compressed
+ * with LZMA, without holding the whole texture in memory.
+ */
+
+#pragma once
+
+#include "uc2defs.h"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief The libuncso2's namespace.
+ */
+namespace uc2
+{
+class PkgEntryReader;
+
+/**
+ * @brief Decompresses LZMA'd VTFs piece by piece.
+ *
+ * Decompresses a texture one window at a time, reading its compressed data
+ * only as it's needed. The memory used does not depend on the texture's size.
+ *
+ * The compressed data can come from a buffer or from a PkgEntryReader, so a
+ * texture stored in a PKG file is decrypted and decompressed in the same pass.
+ *
+ * The texture's chunks must be stored in the same order as they're listed in
+ * its header, which is how the game's textures are laid out.
+ */
+class UNCSO2_API LzmaTextureReader
+{
+public:
+    using ptr_t = std::unique_ptr<LzmaTextureReader>; /*!< The pointer type of
+                                                         LzmaTextureReader */
+
+    virtual ~LzmaTextureReader() = default;
+
+    /**
+     * @brief Decompresses the next window of the texture.
+     *
+     * The window is stored in a buffer owned by the reader, which is reused by
+     * the next call. Every window but the last is GetWindowSize() bytes long.
+     *
+     * This method throws exceptions:
+     * - It throws std::runtime_error when the texture's data is truncated or
+     * broken, or when its chunks are not stored in order.
+     * - It throws the same exceptions PkgEntryReader::Next does.
+     *
+     * @return std::pair<const std::uint8_t*, std::uint64_t> The window's
+     * buffer pointer and the window's size. The size is zero when the whole
+     * texture was decompressed.
+     */
+    virtual std::pair<const std::uint8_t*, std::uint64_t> Next() = 0;
+
+    /**
+     * @brief Retrieves the texture's real size.
+     *
+     * The texture's header is read from the input if it wasn't yet.
+     *
+     * This method throws exceptions:
+     * - It throws std::runtime_error when the texture's header is invalid or
+     * truncated.
+     *
+     * @return std::uint64_t the texture's real size.
+     */
+    virtual std::uint64_t GetOriginalSize() = 0;
+
+    /**
+     * @brief Get how many bytes of the texture were decompressed.
+     *
+     * @return std::uint64_t The position of the next window in the texture.
+     */
+    virtual std::uint64_t GetPosition() = 0;
+
+    /**
+     * @brief Has the whole texture been decompressed?
+     *
+     * @return true If there are no windows left.
+     * @return false If there are windows left.
+     */
+    virtual bool IsFinished() = 0;
+
+    /**
+     * @brief Get the size of a full window.
+     *
+     * @return std::uint64_t The size of a full window.
+     */
+    static std::uint64_t GetWindowSize();
+
+    /**
+     * @brief Construct a new LzmaTextureReader object.
+     *
+     * The buffer is NOT modified, and it must outlive the reader.
+     *
+     * @param pData The compressed texture's data buffer.
+     * @param iDataSize The compressed texture's data buffer size.
+     *
+     * @return ptr_t the new LzmaTextureReader object.
+     */
+    static ptr_t Create(const std::uint8_t* pData,
+                        const std::uint64_t iDataSize);
+
+    /**
+     * @brief Construct a new LzmaTextureReader object.
+     *
+     * Reads the compressed texture from a PKG entry's reader, one chunk at a
+     * time. The entry reader must be at the start of the entry, and it must
+     * outlive the texture reader.
+     *
+     * @param entryReader The reader of the entry holding the texture.
+     *
+     * @return ptr_t the new LzmaTextureReader object.
+     */
+    static ptr_t Create(PkgEntryReader& entryReader);
+};
+}  // namespace uc2
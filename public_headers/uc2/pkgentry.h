@@ -35,6 +35,50 @@ extern "C"
     uncso2_PkgEntry_Decrypt(PkgEntry_t entryHandle, void** outBuffer,
                             uint64_t* outSize, uint64_t bytesToDecrypt = 0);
 
+    /**
+     * @brief Decrypts the file to a buffer
+     *
+     * Decrypts the file entry contained in the PkgEntry object to the buffer
+     * given by the caller. Unlike uncso2_PkgEntry_Decrypt, it does NOT modify
+     * the buffer given to PkgFile, so it may be called again on the same
+     * entry, or from many threads at once.
+     *
+     * @param entryHandle The PkgEntry's object handle.
+     * @param outBuffer The buffer to write the file's data to.
+     * @param outBufferSize The output buffer's size.
+     * @param outSize A pointer to where the written data's size will be
+     * written to.
+     * @param bytesToDecrypt How many file bytes should be decrypted? Zero
+     * means 'decrypt everything'.
+     * @return true If the data was decrypted successfully.
+     * @return false If the function failed to decrypt the data.
+     */
+    UNCSO2_API bool UNCSO2_CALLMETHOD uncso2_PkgEntry_DecryptTo(
+        PkgEntry_t entryHandle, void* outBuffer, uint64_t outBufferSize,
+        uint64_t* outSize, uint64_t bytesToDecrypt = 0);
+
+    /**
+     * @brief Decrypts a range of the file to a buffer
+     *
+     * Decrypts length bytes of the file entry, starting at offset, to the
+     * buffer given by the caller. Only the data blocks overlapping the range
+     * are decrypted, and the buffer given to PkgFile is NOT modified.
+     * The range is cut short at the end of the file.
+     *
+     * @param entryHandle The PkgEntry's object handle.
+     * @param offset The file offset to start reading at.
+     * @param length How many bytes should be read.
+     * @param outBuffer The buffer to write the data to. It must be at least
+     * length bytes long.
+     * @param outSize A pointer to where the written data's size will be
+     * written to.
+     * @return true If the data was decrypted successfully.
+     * @return false If the function failed to decrypt the data.
+     */
+    UNCSO2_API bool UNCSO2_CALLMETHOD uncso2_PkgEntry_ReadRange(
+        PkgEntry_t entryHandle, uint64_t offset, uint64_t length,
+        void* outBuffer, uint64_t* outSize);
+
     /**
      * @brief Get the file's path.
      *
@@ -55,6 +55,55 @@ public:
     virtual std::pair<std::uint8_t*, std::uint64_t> DecryptFile(
         const std::uint64_t iBytesToDecrypt = 0) = 0;
 
+    /**
+     * @brief Decrypts the file to a buffer
+     *
+     * Decrypts the file contained in here to the buffer given by the caller.
+     * Unlike DecryptFile, it does NOT modify the buffer given to PkgFile, so
+     * the same entry can be decrypted again, or by many threads at once.
+     *
+     * This method throws exceptions:
+     * - It throws std::runtime_error when it tries to decrypt a file larger
+     * than its host PKG file.
+     * - It throws std::length_error when the output buffer is too small.
+     *
+     * @param pOutBuffer The buffer to write the file's data to.
+     * @param iOutBufferSize The output buffer's size. It must be big enough
+     * for the bytes to decrypt.
+     * @param iBytesToDecrypt How many file bytes should be decrypted? Default
+     * is zero, which means 'decrypt everything'.
+     *
+     * @return std::uint64_t How many bytes were written to the buffer.
+     */
+    virtual std::uint64_t DecryptFileTo(
+        std::uint8_t* pOutBuffer, const std::uint64_t iOutBufferSize,
+        const std::uint64_t iBytesToDecrypt = 0) = 0;
+
+    /**
+     * @brief Decrypts a range of the file to a buffer
+     *
+     * Decrypts iLength bytes of the file, starting at iOffset, to the buffer
+     * given by the caller. Only the data blocks overlapping the range are
+     * decrypted, and the buffer given to PkgFile is NOT modified.
+     *
+     * The range is cut short at the end of the file.
+     *
+     * This method throws exceptions:
+     * - It throws std::out_of_range when iOffset is past the end of the file.
+     * - It throws std::runtime_error when it tries to decrypt a file larger
+     * than its host PKG file.
+     *
+     * @param iOffset The file offset to start reading at.
+     * @param iLength How many bytes should be read.
+     * @param pOutBuffer The buffer to write the data to. It must be at least
+     * iLength bytes long.
+     *
+     * @return std::uint64_t How many bytes were written to the buffer.
+     */
+    virtual std::uint64_t ReadRange(const std::uint64_t iOffset,
+                                    const std::uint64_t iLength,
+                                    std::uint8_t* pOutBuffer) = 0;
+
     /**
      * @brief Get the file's path.
      * @return std::string_view the file's path
@@ -0,0 +1,74 @@
+/**
+ * @file pkgentrycache.h
+ * @author Luís Leite (luis@leite.xyz)
+ * @brief Caches decrypted pkg entry tables on the disk.
+ * @version 1.0
+ *
+ * Contains a class that stores the decrypted entry tables of pkg files in a
+ * file, so they don't have to be decrypted every time the pkg files are
+ * parsed.
+ */
+
+#pragma once
+
+#include "uc2defs.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    /**
+     * @brief Opens an entry table cache.
+     *
+     * The tables in the cache file are loaded if it exists. A missing, old or
+     * broken cache file is ignored, and the cache starts empty.
+     *
+     * Give it to PkgFile objects with uncso2_PkgFileOptions_SetEntryCache.
+     *
+     * It may return NULL if an error occurs.
+     *
+     * @param cachePath The cache file's path. It is written by
+     * uncso2_PkgEntryCache_Save.
+     *
+     * @return PkgEntryCache_t A handle to the new PkgEntryCache object.
+     */
+    UNCSO2_API PkgEntryCache_t UNCSO2_CALLMETHOD
+    uncso2_PkgEntryCache_Open(const char* cachePath);
+
+    /**
+     * @brief Destroys a PkgEntryCache object.
+     *
+     * Free's the PkgEntryCache object stored in the handle. New tables are
+     * not saved.
+     *
+     * @param cacheHandle The PkgEntryCache's object handle to be destroyed.
+     */
+    UNCSO2_API void UNCSO2_CALLMETHOD
+    uncso2_PkgEntryCache_Free(PkgEntryCache_t cacheHandle);
+
+    /**
+     * @brief Writes the cached entry tables to the cache file.
+     *
+     * The file is only written if new tables were added since the cache was
+     * opened or last saved.
+     *
+     * @param cacheHandle The PkgEntryCache's object handle.
+     *
+     * @return true If the cache was saved.
+     * @return false If the cache file could not be written.
+     */
+    UNCSO2_API bool UNCSO2_CALLMETHOD
+    uncso2_PkgEntryCache_Save(PkgEntryCache_t cacheHandle);
+
+    /**
+     * @brief Get the number of PKG files with a cached entry table.
+     *
+     * @param cacheHandle The PkgEntryCache's object handle.
+     *
+     * @return uint64_t The number of cached PKG files.
+     */
+    UNCSO2_API uint64_t UNCSO2_CALLMETHOD
+    uncso2_PkgEntryCache_GetArchivesNum(PkgEntryCache_t cacheHandle);
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,81 @@
+/**
+ * @file pkgentrycache.hpp
+ * @author Luís Leite (luis@leite.xyz)
+ * @brief Caches decrypted pkg entry tables on the disk.
+ * @version 1.0
+ *
+ * Contains a class that stores the decrypted entry tables of pkg files in a
+ * file, so they don't have to be decrypted every time the pkg files are
+ * parsed.
+ */
+
+#pragma once
+
+#include "uc2defs.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+/**
+ * @brief The libuncso2's namespace
+ */
+namespace uc2
+{
+/**
+ * @brief Caches decrypted pkg entry tables on the disk.
+ *
+ * Give it to PkgFile objects through PkgFileOptions::SetEntryCache. When a
+ * PKG file is parsed, its entry table is looked up in the cache by the PKG's
+ * MD5 hash and size. On a hit, the entries are read from the cache and the
+ * entry table is not decrypted. On a miss, the decrypted table is added to the
+ * cache.
+ *
+ * The cache file is memory mapped and its tables are read in place. Its
+ * format depends on the machine's byte order, so it should not be shared
+ * between different architectures.
+ *
+ * PkgFile objects may be parsed with the same cache from many threads, but
+ * Save must not be called while a PkgFile is being parsed.
+ */
+class UNCSO2_API PkgEntryCache
+{
+public:
+    using ptr_t = std::unique_ptr<PkgEntryCache>; /*!< The pointer type of
+                                                     PkgEntryCache */
+
+    virtual ~PkgEntryCache() = default;
+
+    /**
+     * @brief Writes the cached entry tables to the cache file.
+     *
+     * The file is only written if new tables were added since the cache was
+     * opened or last saved.
+     *
+     * This method throws exceptions:
+     * - It throws std::runtime_error if the cache file could not be written.
+     * - It throws std::filesystem::filesystem_error if the new cache file
+     * could not replace the old one.
+     */
+    virtual void Save() = 0;
+
+    /**
+     * @brief Get the number of PKG files with a cached entry table.
+     *
+     * @return std::uint64_t The number of cached PKG files.
+     */
+    virtual std::uint64_t GetArchivesNum() = 0;
+
+    /**
+     * @brief Opens an entry table cache.
+     *
+     * The tables in the cache file are loaded if it exists. A missing, old or
+     * broken cache file is ignored, and the cache starts empty.
+     *
+     * @param cachePath The cache file's path. It is written by Save.
+     *
+     * @return ptr_t the new PkgEntryCache object.
+     */
+    static ptr_t Open(const std::filesystem::path& cachePath);
+};
+}  // namespace uc2
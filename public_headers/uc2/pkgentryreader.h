@@ -0,0 +1,95 @@
+/**
+ * @file pkgentryreader.h
+ * @author Luís Leite (luis@leite.xyz)
+ * @brief Reads a file entry's data piece by piece.
+ * @version 1.0
+ *
+ * Contains a class that decrypts the data of pkg file entries in chunks.
+ */
+
+#pragma once
+
+#include "uc2defs.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    /**
+     * @brief Construct a new PkgEntryReader object.
+     *
+     * Reads the entry's data from the buffer given to its PkgFile, without
+     * modifying it. The PkgEntry must outlive the reader.
+     *
+     * It may return NULL if an error occurs.
+     *
+     * @param entryHandle The PkgEntry's object handle.
+     *
+     * @return PkgEntryReader_t A handle to the new PkgEntryReader object.
+     */
+    UNCSO2_API PkgEntryReader_t UNCSO2_CALLMETHOD
+    uncso2_PkgEntryReader_Create(PkgEntry_t entryHandle);
+
+    /**
+     * @brief Construct a new PkgEntryReader object.
+     *
+     * Reads the entry's data from the PKG file opened in the file descriptor.
+     * The reads don't use the descriptor's file offset, but they move it on
+     * Windows. The PkgEntry must outlive the reader, and the caller still
+     * owns the descriptor.
+     *
+     * It may return NULL if an error occurs.
+     *
+     * @param entryHandle The PkgEntry's object handle.
+     * @param fileDescriptor The descriptor of the entry's PKG file.
+     *
+     * @return PkgEntryReader_t A handle to the new PkgEntryReader object.
+     */
+    UNCSO2_API PkgEntryReader_t UNCSO2_CALLMETHOD
+    uncso2_PkgEntryReader_CreateFromFile(PkgEntry_t entryHandle,
+                                         int fileDescriptor);
+
+    /**
+     * @brief Destroys a PkgEntryReader object.
+     *
+     * Free's the PkgEntryReader object stored in the handle.
+     *
+     * @param readerHandle The PkgEntryReader's object handle to be destroyed.
+     */
+    UNCSO2_API void UNCSO2_CALLMETHOD
+    uncso2_PkgEntryReader_Free(PkgEntryReader_t readerHandle);
+
+    /**
+     * @brief Decrypts the next chunk of the file.
+     *
+     * The chunk is stored in a buffer owned by the reader, which is reused by
+     * the next call. The chunk's size is zero when the whole file was read.
+     *
+     * @param readerHandle The PkgEntryReader's object handle.
+     * @param outBuffer A pointer to where the chunk's address will be written
+     * to.
+     * @param outSize A pointer to where the chunk's size will be written to.
+     * @return true If the chunk was decrypted successfully.
+     * @return false If the function failed to decrypt the chunk.
+     */
+    UNCSO2_API bool UNCSO2_CALLMETHOD
+    uncso2_PkgEntryReader_Next(PkgEntryReader_t readerHandle,
+                               const void** outBuffer, uint64_t* outSize);
+
+    /**
+     * @brief Go back to the start of the file.
+     *
+     * @param readerHandle The PkgEntryReader's object handle.
+     */
+    UNCSO2_API void UNCSO2_CALLMETHOD
+    uncso2_PkgEntryReader_Rewind(PkgEntryReader_t readerHandle);
+
+    /**
+     * @brief Get the size of a full chunk.
+     *
+     * @return uint64_t The size of a full chunk.
+     */
+    UNCSO2_API uint64_t UNCSO2_CALLMETHOD uncso2_PkgEntryReader_GetChunkSize();
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,116 @@
+/**
+ * @file pkgentryreader.hpp
+ * @author Luís Leite (luis@leite.xyz)
+ * @brief Reads a file entry's data piece by piece.
+ * @version 1.0
+ *
+ * Contains a class that decrypts the data of pkg file entries in chunks.
+ */
+
+#pragma once
+
+#include "uc2defs.h"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief The libuncso2's namespace
+ */
+namespace uc2
+{
+class PkgEntry;
+
+/**
+ * @brief Reads a file entry's data piece by piece.
+ *
+ * Decrypts a PkgEntry's data one chunk at a time, so the whole file never has
+ * to be in memory at once. Each chunk is as big as the data blocks the PKG
+ * encrypts separately, which is what GetChunkSize() returns, except for the
+ * last one.
+ *
+ * The data is either read from the buffer given to PkgFile, which is NOT
+ * modified, or straight from the PKG file through a file descriptor.
+ *
+ * The PkgEntry must outlive its readers.
+ */
+class UNCSO2_API PkgEntryReader
+{
+public:
+    using ptr_t = std::unique_ptr<PkgEntryReader>; /*!< The pointer type of
+                                                      PkgEntryReader */
+
+    virtual ~PkgEntryReader() = default;
+
+    /**
+     * @brief Decrypts the next chunk of the file.
+     *
+     * The chunk is stored in a buffer owned by the reader, which is reused by
+     * the next call.
+     *
+     * This method throws exceptions:
+     * - It throws std::runtime_error when the data could not be read from the
+     * file descriptor, or when the file is larger than its host PKG file.
+     *
+     * @return std::pair<const std::uint8_t*, std::uint64_t> The chunk's buffer
+     * pointer and the chunk's size. The size is zero when the whole file was
+     * read.
+     */
+    virtual std::pair<const std::uint8_t*, std::uint64_t> Next() = 0;
+
+    /**
+     * @brief Get how many bytes of the file were read.
+     *
+     * @return std::uint64_t The position of the next chunk in the file.
+     */
+    virtual std::uint64_t GetPosition() = 0;
+
+    /**
+     * @brief Has the whole file been read?
+     *
+     * @return true If there are no chunks left.
+     * @return false If there are chunks left.
+     */
+    virtual bool IsFinished() = 0;
+
+    /**
+     * @brief Go back to the start of the file.
+     */
+    virtual void Rewind() = 0;
+
+    /**
+     * @brief Get the size of a full chunk.
+     *
+     * @return std::uint64_t The size of a full chunk.
+     */
+    static std::uint64_t GetChunkSize();
+
+    /**
+     * @brief Construct a new PkgEntryReader object.
+     *
+     * Reads the entry's data from the buffer given to its PkgFile.
+     *
+     * @param entry The entry to read.
+     *
+     * @return ptr_t the new PkgEntryReader object.
+     */
+    static ptr_t Create(PkgEntry& entry);
+
+    /**
+     * @brief Construct a new PkgEntryReader object.
+     *
+     * Reads the entry's data from the PKG file opened in the file descriptor.
+     * The reads don't use the descriptor's file offset, so many readers may
+     * share one descriptor. On Windows the reads still move the file offset,
+     * so don't rely on it while a reader uses the descriptor. The caller
+     * still owns the descriptor.
+     *
+     * @param entry The entry to read.
+     * @param iFileDescriptor The descriptor of the entry's PKG file.
+     *
+     * @return ptr_t the new PkgEntryReader object.
+     */
+    static ptr_t CreateFromFile(PkgEntry& entry, int iFileDescriptor);
+};
+}  // namespace uc2
@@ -0,0 +1,64 @@
+/**
+ * @file pkgextractor.h
+ * @author Luís Leite (luis@leite.xyz)
+ * @brief Extracts every file of a pkg file.
+ * @version 1.0
+ *
+ * Contains a class that writes the entries of a parsed pkg file to the disk.
+ */
+
+#pragma once
+
+#include "uc2defs.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    /**
+     * @brief Construct a new PkgExtractor object.
+     *
+     * The PkgFile must be parsed before its entries are extracted, and it must
+     * outlive the extractor.
+     *
+     * It may return NULL if an error occurs.
+     *
+     * @param pkgHandle The PkgFile's object handle.
+     * @param threadsNum How many threads to extract with. Zero means one
+     * thread per CPU core.
+     *
+     * @return PkgExtractor_t A handle to the new PkgExtractor object.
+     */
+    UNCSO2_API PkgExtractor_t UNCSO2_CALLMETHOD
+    uncso2_PkgExtractor_Create(PkgFile_t pkgHandle, uint32_t threadsNum);
+
+    /**
+     * @brief Destroys a PkgExtractor object.
+     *
+     * Free's the PkgExtractor object stored in the handle.
+     *
+     * @param extractorHandle The PkgExtractor's object handle to be destroyed.
+     */
+    UNCSO2_API void UNCSO2_CALLMETHOD
+    uncso2_PkgExtractor_Free(PkgExtractor_t extractorHandle);
+
+    /**
+     * @brief Extracts every entry to a directory.
+     *
+     * The entries keep their paths inside the output directory, and any
+     * missing directory is created. Existing files are overwritten.
+     *
+     * @param extractorHandle The PkgExtractor's object handle.
+     * @param outDirectory The directory to extract the entries to.
+     * @param outExtractedNum A pointer to where the number of extracted
+     * entries will be written to. It may be NULL.
+     *
+     * @return true If every entry was extracted.
+     * @return false If an entry could not be extracted.
+     */
+    UNCSO2_API bool UNCSO2_CALLMETHOD uncso2_PkgExtractor_ExtractAll(
+        PkgExtractor_t extractorHandle, const char* outDirectory,
+        uint64_t* outExtractedNum);
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,82 @@
+/**
+ * @file pkgextractor.hpp
+ * @author Luís Leite (luis@leite.xyz)
+ * @brief Extracts every file of a pkg file.
+ * @version 1.0
+ *
+ * Contains a class that writes the entries of a parsed pkg file to the disk.
+ */
+
+#pragma once
+
+#include "uc2defs.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+/**
+ * @brief The libuncso2's namespace
+ */
+namespace uc2
+{
+class PkgFile;
+
+/**
+ * @brief Extracts every file of a pkg file.
+ *
+ * Decrypts and writes every entry of a parsed PkgFile to a directory, using
+ * multiple threads.
+ *
+ * The biggest entries are extracted first, so a big entry started last
+ * doesn't leave the other threads waiting for it. Each entry is decrypted and
+ * written in chunks, and the PkgFile's buffer is NOT modified.
+ *
+ * The PkgFile must outlive the extractor.
+ */
+class UNCSO2_API PkgExtractor
+{
+public:
+    using ptr_t = std::unique_ptr<PkgExtractor>; /*!< The pointer type of
+                                                    PkgExtractor */
+
+    virtual ~PkgExtractor() = default;
+
+    /**
+     * @brief Extracts every entry to a directory.
+     *
+     * The entries keep their paths inside the output directory, and any
+     * missing directory is created. Existing files are overwritten.
+     *
+     * This method throws exceptions:
+     * - It throws std::runtime_error if an entry's path leaves the output
+     * directory, or if an entry could not be decrypted or written.
+     *
+     * @param outDirectory The directory to extract the entries to.
+     *
+     * @return std::uint64_t The number of extracted entries.
+     */
+    virtual std::uint64_t ExtractAll(
+        const std::filesystem::path& outDirectory) = 0;
+
+    /**
+     * @brief Get how many threads extract the entries.
+     *
+     * @return std::uint32_t The number of threads.
+     */
+    virtual std::uint32_t GetThreadsNum() = 0;
+
+    /**
+     * @brief Construct a new PkgExtractor object.
+     *
+     * The PkgFile must be parsed before its entries are extracted.
+     *
+     * @param pkgFile The PKG file to extract.
+     * @param iThreadsNum How many threads to extract with. Zero means one
+     * thread per CPU core.
+     *
+     * @return ptr_t the new PkgExtractor object.
+     */
+    static ptr_t Create(PkgFile& pkgFile, std::uint32_t iThreadsNum = 0);
+};
+}  // namespace uc2
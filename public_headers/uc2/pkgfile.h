@@ -37,6 +37,25 @@ extern "C"
         const char* szEntryKey, const char* szDataKey,
         PkgFileOptions_t options = NULL);
 
+    /**
+     * @brief Open a PKG file from the disk.
+     *
+     * Maps the PKG file to memory instead of reading it whole. The mapping is
+     * private, the decrypted data is never written back to the file.
+     *
+     * It may return NULL if an error occurs.
+     *
+     * @param pkgPath The path to the PKG file.
+     * @param szEntryKey The PKG data entries' key. The key must be 16 bytes
+     * long.
+     * @param szDataKey The PKG data's key. The key must be 16 bytes long.
+     *
+     * @return PkgFile_t A handle to the new PkgFile object.
+     */
+    UNCSO2_API PkgFile_t UNCSO2_CALLMETHOD
+    uncso2_PkgFile_Open(const char* pkgPath, const char* szEntryKey,
+                        const char* szDataKey, PkgFileOptions_t options = NULL);
+
     /**
      * @brief Destroys a PkgFile object.
      *
@@ -163,6 +182,73 @@ extern "C"
     UNCSO2_API PkgEntry_t* UNCSO2_CALLMETHOD
     uncso2_PkgFile_GetEntries(PkgFile_t pkgHandle);
 
+    /**
+     * @brief Get one of the PKG's file entries by its index.
+     *
+     * With the lazy entries option, the entry is only created the first time
+     * it is requested. The entry is owned by the PkgFile.
+     *
+     * @param pkgHandle The PkgFile's object handle.
+     * @param index The entry's index, in the PKG's entry table.
+     *
+     * @return PkgEntry_t The file entry, or NULL if the index is invalid.
+     */
+    UNCSO2_API PkgEntry_t UNCSO2_CALLMETHOD
+    uncso2_PkgFile_GetEntry(PkgFile_t pkgHandle, uint64_t index);
+
+    /**
+     * @brief Find one of the PKG's file entries by its path.
+     *
+     * The path's leading separators are ignored, '\\' and '/' are the same
+     * separator, and the case of ASCII letters is ignored.
+     *
+     * @param pkgHandle The PkgFile's object handle.
+     * @param path The entry's path.
+     *
+     * @return PkgEntry_t The file entry, or NULL if no entry has the path.
+     */
+    UNCSO2_API PkgEntry_t UNCSO2_CALLMETHOD
+    uncso2_PkgFile_FindEntry(PkgFile_t pkgHandle, const char* path);
+
+    /**
+     * @brief Find the PKG's file entries whose path starts with a prefix.
+     *
+     * The paths are compared like uncso2_PkgFile_FindEntry does, and the
+     * entries are sorted by their path.
+     *
+     * @param pkgHandle The PkgFile's object handle.
+     * @param prefix The paths' prefix.
+     * @param outEntries An array to write the entries to. It may be NULL if
+     * maxEntries is zero.
+     * @param maxEntries How many entries fit in outEntries.
+     *
+     * @return uint64_t How many entries were found, which may be more than
+     * maxEntries.
+     */
+    UNCSO2_API uint64_t UNCSO2_CALLMETHOD uncso2_PkgFile_FindEntriesByPrefix(
+        PkgFile_t pkgHandle, const char* prefix, PkgEntry_t* outEntries,
+        uint64_t maxEntries);
+
+    /**
+     * @brief List the PKG's file entries inside a directory.
+     *
+     * Works like uncso2_PkgFile_FindEntriesByPrefix. The directory does not
+     * need a trailing separator, and an empty path is the PKG's root.
+     *
+     * @param pkgHandle The PkgFile's object handle.
+     * @param directory The directory's path.
+     * @param recursive Should the entries in subdirectories be listed too?
+     * @param outEntries An array to write the entries to. It may be NULL if
+     * maxEntries is zero.
+     * @param maxEntries How many entries fit in outEntries.
+     *
+     * @return uint64_t How many entries were found, which may be more than
+     * maxEntries.
+     */
+    UNCSO2_API uint64_t UNCSO2_CALLMETHOD uncso2_PkgFile_ListDirectory(
+        PkgFile_t pkgHandle, const char* directory, bool recursive,
+        PkgEntry_t* outEntries, uint64_t maxEntries);
+
     /**
      * @brief Get the header size of a PKG file.
      *
@@ -12,6 +12,7 @@
 #include "uc2defs.h"
 
 #include <cstdint>
+#include <filesystem>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -144,10 +145,88 @@ public:
      *
      * Retrieves the parsed pkg's file entries.
      *
+     * If the PKG was created with the lazy entries option, every entry that
+     * was not requested yet is created here.
+     *
      * @return std::vector<entryptr_t>& The file entries.
      */
     virtual std::vector<entryptr_t>& GetEntries() = 0;
 
+    /**
+     * @brief Get the number of file entries.
+     *
+     * Unlike GetEntries, it does not create any entry.
+     *
+     * @return std::uint64_t The number of file entries.
+     */
+    virtual std::uint64_t GetEntriesNum() = 0;
+
+    /**
+     * @brief Get a file entry by its index.
+     *
+     * If the PKG was created with the lazy entries option, the entry is
+     * created the first time it is requested. The entry is owned by the
+     * PkgFile.
+     *
+     * This method throws exceptions:
+     * - It throws std::out_of_range if the index is past the last entry.
+     * - It throws std::invalid_argument if the entry's decrypted size is
+     * bigger than its encrypted size.
+     *
+     * @param iIndex The entry's index, in the PKG's entry table.
+     * @return PkgEntry& The file entry.
+     */
+    virtual PkgEntry& GetEntry(std::uint64_t iIndex) = 0;
+
+    /**
+     * @brief Find a file entry by its path.
+     *
+     * The path's leading separators are ignored, '\\' and '/' are the same
+     * separator, and the case of ASCII letters is ignored. It's looked up in
+     * a hash table built by Parse.
+     *
+     * If many entries share the path, the first one in the PKG is returned.
+     *
+     * This method throws the same exceptions as GetEntry.
+     *
+     * @param szvPath The entry's path.
+     * @return PkgEntry* The file entry, or null if no entry has the path.
+     */
+    virtual PkgEntry* FindEntry(std::string_view szvPath) = 0;
+
+    /**
+     * @brief Find the file entries whose path starts with a prefix.
+     *
+     * The paths are compared like FindEntry does, so a directory's entries
+     * are found with a prefix such as "materials/models/". The entries are
+     * sorted by their path.
+     *
+     * The first search sorts the PKG's paths.
+     *
+     * This method throws the same exceptions as GetEntry.
+     *
+     * @param szvPrefix The paths' prefix.
+     * @return std::vector<PkgEntry*> The entries found.
+     */
+    virtual std::vector<PkgEntry*> FindEntriesByPrefix(
+        std::string_view szvPrefix) = 0;
+
+    /**
+     * @brief List the file entries inside a directory.
+     *
+     * The directory's path is compared like FindEntry does, and it does not
+     * need a trailing separator. The entries are sorted by their path.
+     *
+     * This method throws the same exceptions as GetEntry.
+     *
+     * @param szvDirectory The directory's path. An empty path is the PKG's
+     * root.
+     * @param bRecursive Should the entries in subdirectories be listed too?
+     * @return std::vector<PkgEntry*> The entries found.
+     */
+    virtual std::vector<PkgEntry*> ListDirectory(
+        std::string_view szvDirectory, bool bRecursive = false) = 0;
+
     /**
      * @brief Construct a new PkgFile object.
      *
@@ -171,6 +250,31 @@ public:
                         std::string szEntryKey = {}, std::string szDataKey = {},
                         PkgFileOptions* options = nullptr);
 
+    /**
+     * @brief Open a PKG file from the disk.
+     *
+     * Maps the PKG file to memory instead of reading it whole, so only the
+     * parts that are used get read from the disk. The mapping is private,
+     * the decrypted data is never written back to the file.
+     *
+     * The PkgFile's file name is taken from the path.
+     *
+     * This method throws exceptions:
+     * - It throws std::runtime_error if the file could not be opened or
+     * mapped.
+     *
+     * @param pkgPath The path to the pkg file.
+     * @param szEntryKey The pkg data entries' key. The key must be 16 bytes
+     * long.
+     * @param szDataKey The pkg data's key. The key must be 16 bytes long.
+     * @param options The options to use in this PkgFile, it may be null.
+     *
+     * @return ptr_t the new PkgFile object
+     */
+    static ptr_t Open(const std::filesystem::path& pkgPath,
+                      std::string szEntryKey = {}, std::string szDataKey = {},
+                      PkgFileOptions* options = nullptr);
+
     /**
      * @brief Get the header size of a PKG file.
      *
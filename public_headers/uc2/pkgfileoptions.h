@@ -65,6 +65,72 @@ extern "C"
     UNCSO2_API bool UNCSO2_CALLMETHOD
     uncso2_PkgFileOptions_IsTfoPkg(PkgFileOptions_t optionsHandle);
 
+    /**
+     * @brief Set how many threads decrypt a PKG entry's data.
+     *
+     * An entry's data is split in 64 KiB blocks that can be decrypted
+     * independently, so big entries may be decrypted by multiple threads.
+     *
+     * A value of 0 or 1 decrypts the entries in the calling thread only, which
+     * is the default behaviour.
+     *
+     * @param optionsHandle The PkgFileOptions's object handle.
+     * @param threadsNum The number of threads to decrypt with.
+     */
+    UNCSO2_API void UNCSO2_CALLMETHOD uncso2_PkgFileOptions_SetDecryptThreads(
+        PkgFileOptions_t optionsHandle, uint32_t threadsNum);
+
+    /**
+     * @brief Get how many threads decrypt a PKG entry's data.
+     *
+     * @param optionsHandle The PkgFileOptions's object handle.
+     *
+     * @return uint32_t The number of threads to decrypt with.
+     */
+    UNCSO2_API uint32_t UNCSO2_CALLMETHOD
+    uncso2_PkgFileOptions_GetDecryptThreads(PkgFileOptions_t optionsHandle);
+
+    /**
+     * @brief Set the cache to read and store PKG entry tables in.
+     *
+     * When a PKG file's entry table is in the cache, parsing the PKG file
+     * does not decrypt it. Tables that are not cached yet are added to it.
+     *
+     * The cache is not owned by the options, and it must outlive the PkgFile
+     * objects that use it.
+     *
+     * @param optionsHandle The PkgFileOptions's object handle.
+     * @param cacheHandle The PkgEntryCache's object handle, or NULL to not use
+     * a cache.
+     */
+    UNCSO2_API void UNCSO2_CALLMETHOD uncso2_PkgFileOptions_SetEntryCache(
+        PkgFileOptions_t optionsHandle, PkgEntryCache_t cacheHandle);
+
+    /**
+     * @brief Set if a PKG file's entries are only created when requested.
+     *
+     * When enabled, parsing a PKG file only decrypts its entry table, and an
+     * entry is only created the first time it is requested with
+     * uncso2_PkgFile_GetEntry, or with uncso2_PkgFile_GetEntries, which
+     * creates every entry.
+     *
+     * @param optionsHandle The PkgFileOptions's object handle.
+     * @param state The new 'lazy entries' state.
+     */
+    UNCSO2_API void UNCSO2_CALLMETHOD uncso2_PkgFileOptions_SetLazyEntries(
+        PkgFileOptions_t optionsHandle, bool state);
+
+    /**
+     * @brief Is the lazy entries option enabled?
+     *
+     * @param optionsHandle The PkgFileOptions's object handle.
+     *
+     * @return true If the option is enabled.
+     * @return false If the option is disabled.
+     */
+    UNCSO2_API bool UNCSO2_CALLMETHOD
+    uncso2_PkgFileOptions_IsLazyEntries(PkgFileOptions_t optionsHandle);
+
 #ifdef __cplusplus
 }
 #endif
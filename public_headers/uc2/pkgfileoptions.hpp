@@ -11,6 +11,7 @@
 
 #include "uc2defs.h"
 
+#include <cstdint>
 #include <memory>
 
 /**
@@ -18,6 +19,8 @@
  */
 namespace uc2
 {
+class PkgEntryCache;
+
 /**
  * @brief Options to use with PkgFile
  *
@@ -51,6 +54,69 @@ public:
      */
     virtual bool IsTfoPkg() = 0;
 
+    /**
+     * @brief Set how many threads decrypt a PKG entry's data.
+     *
+     * An entry's data is split in 64 KiB blocks that can be decrypted
+     * independently, so big entries may be decrypted by multiple threads.
+     *
+     * A value of 0 or 1 decrypts the entries in the calling thread only, which
+     * is the default behaviour.
+     *
+     * @param iThreadsNum The number of threads to decrypt with.
+     */
+    virtual void SetDecryptThreads(std::uint32_t iThreadsNum) = 0;
+
+    /**
+     * @brief Get how many threads decrypt a PKG entry's data.
+     *
+     * @return std::uint32_t The number of threads to decrypt with.
+     */
+    virtual std::uint32_t GetDecryptThreads() = 0;
+
+    /**
+     * @brief Set the cache to read and store PKG entry tables in.
+     *
+     * When a PKG file's entry table is in the cache, parsing the PKG file
+     * does not decrypt it. Tables that are not cached yet are added to it.
+     *
+     * The cache is not owned by the options, and it must outlive the PkgFile
+     * objects that use it. It's null by default.
+     *
+     * @param pCache The entry table cache, or null to not use one.
+     */
+    virtual void SetEntryCache(PkgEntryCache* pCache) = 0;
+
+    /**
+     * @brief Get the cache to read and store PKG entry tables in.
+     *
+     * @return PkgEntryCache* The entry table cache, or null if none is set.
+     */
+    virtual PkgEntryCache* GetEntryCache() = 0;
+
+    /**
+     * @brief Set if a PKG file's entries are only created when requested.
+     *
+     * When enabled, parsing a PKG file only decrypts its entry table and keeps
+     * the entries' paths, offsets and sizes in a compact table. An entry's
+     * object, and its data key, are only created the first time the entry is
+     * requested with PkgFile::GetEntry, or with PkgFile::GetEntries, which
+     * creates every entry.
+     *
+     * It's disabled by default.
+     *
+     * @param bNewState The new 'lazy entries' state.
+     */
+    virtual void SetLazyEntries(bool bNewState) = 0;
+
+    /**
+     * @brief Is the lazy entries option enabled?
+     *
+     * @return true If the option is enabled.
+     * @return false If the option is disabled.
+     */
+    virtual bool IsLazyEntries() = 0;
+
     /**
      * @brief Construct a new PkgFileOptions object.
      *
@@ -0,0 +1,113 @@
+/**
+ * @file pkgfilesystem.h
+ * @author Luís Leite (luis@leite.xyz)
+ * @brief Looks up files across many pkg files.
+ * @version 1.0
+ *
+ * Contains a class that maps file paths to the pkg files that store them.
+ */
+
+#pragma once
+
+#include "uc2defs.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    /**
+     * @brief Construct a new, empty, PkgFileSystem object.
+     *
+     * It may return NULL if an error occurs.
+     *
+     * @return PkgFileSystem_t A handle to the new PkgFileSystem object.
+     */
+    UNCSO2_API PkgFileSystem_t UNCSO2_CALLMETHOD uncso2_PkgFileSystem_Create();
+
+    /**
+     * @brief Destroys a PkgFileSystem object.
+     *
+     * Free's the PkgFileSystem object stored in the handle, and the PkgFile
+     * objects added to it.
+     *
+     * @param fsHandle The PkgFileSystem's object handle to be destroyed.
+     */
+    UNCSO2_API void UNCSO2_CALLMETHOD
+    uncso2_PkgFileSystem_Free(PkgFileSystem_t fsHandle);
+
+    /**
+     * @brief Adds a PKG file to the file system.
+     *
+     * The file system takes the PkgFile's ownership if it was added, do not
+     * free its handle after that. If it fails, the caller still owns the
+     * handle and must free it.
+     *
+     * @param fsHandle The PkgFileSystem's object handle.
+     * @param pkgHandle The PkgFile's object handle.
+     *
+     * @return true If the PKG file was added.
+     * @return false If the PKG file could not be decrypted or parsed.
+     */
+    UNCSO2_API bool UNCSO2_CALLMETHOD
+    uncso2_PkgFileSystem_AddArchive(PkgFileSystem_t fsHandle,
+                                    PkgFile_t pkgHandle);
+
+    /**
+     * @brief Adds every PKG file listed in an index to the file system.
+     *
+     * PKG files missing from the directory are skipped.
+     *
+     * @param fsHandle The PkgFileSystem's object handle.
+     * @param indexHandle The parsed PkgIndex's object handle.
+     * @param pkgDirectory The directory holding the PKG files.
+     * @param szEntryKey The PKG data entries' key.
+     * @param szDataKey The PKG data's key.
+     * @param options The options to open the PKG files with, it may be NULL.
+     * @param outAddedNum A pointer to where the number of added PKG files will
+     * be written to. It may be NULL.
+     *
+     * @return true If every PKG file found was added.
+     * @return false If a PKG file could not be added.
+     */
+    UNCSO2_API bool UNCSO2_CALLMETHOD uncso2_PkgFileSystem_AddIndex(
+        PkgFileSystem_t fsHandle, PkgIndex_t indexHandle,
+        const char* pkgDirectory, const char* szEntryKey,
+        const char* szDataKey, PkgFileOptions_t options,
+        uint64_t* outAddedNum);
+
+    /**
+     * @brief Finds a file entry by its path.
+     *
+     * The entry is owned by the file system, do not free it.
+     *
+     * @param fsHandle The PkgFileSystem's object handle.
+     * @param szPath The file's path, such as "/materials/foo.vtf".
+     *
+     * @return PkgEntry_t The file's entry, or NULL if it wasn't found.
+     */
+    UNCSO2_API PkgEntry_t UNCSO2_CALLMETHOD
+    uncso2_PkgFileSystem_FindEntry(PkgFileSystem_t fsHandle,
+                                   const char* szPath);
+
+    /**
+     * @brief Get the number of PKG files in the file system.
+     *
+     * @param fsHandle The PkgFileSystem's object handle.
+     *
+     * @return uint64_t The number of PKG files.
+     */
+    UNCSO2_API uint64_t UNCSO2_CALLMETHOD
+    uncso2_PkgFileSystem_GetArchivesNum(PkgFileSystem_t fsHandle);
+
+    /**
+     * @brief Get the number of unique file paths in the file system.
+     *
+     * @param fsHandle The PkgFileSystem's object handle.
+     *
+     * @return uint64_t The number of file paths.
+     */
+    UNCSO2_API uint64_t UNCSO2_CALLMETHOD
+    uncso2_PkgFileSystem_GetEntriesNum(PkgFileSystem_t fsHandle);
+#ifdef __cplusplus
+}
+#endif
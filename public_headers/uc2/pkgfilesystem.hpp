@@ -0,0 +1,134 @@
+/**
+ * @file pkgfilesystem.hpp
+ * @author Luís Leite (luis@leite.xyz)
+ * @brief Looks up files across many pkg files.
+ * @version 1.0
+ *
+ * Contains a class that maps file paths to the pkg files that store them.
+ */
+
+#pragma once
+
+#include "uc2defs.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "pkgfile.hpp"
+
+/**
+ * @brief The libuncso2's namespace
+ */
+namespace uc2
+{
+class PkgEntry;
+class PkgFileOptions;
+class PkgIndex;
+
+/**
+ * @brief Looks up files across many pkg files.
+ *
+ * Owns a set of parsed PkgFile objects and indexes every entry in them by its
+ * path, so the archive holding a file can be found without scanning every
+ * entry.
+ *
+ * The paths are compared without case, '\\' and '/' are the same separator,
+ * and leading separators are ignored. Looking up a path does not allocate
+ * memory.
+ *
+ * When two archives have a file with the same path, the archive added last
+ * wins.
+ */
+class UNCSO2_API PkgFileSystem
+{
+public:
+    using ptr_t = std::unique_ptr<PkgFileSystem>; /*!< The pointer type of
+                                                     PkgFileSystem */
+
+    virtual ~PkgFileSystem() = default;
+
+    /**
+     * @brief Adds a PKG file to the file system.
+     *
+     * The PKG's header is decrypted and the PKG is parsed if that wasn't done
+     * yet.
+     *
+     * This method throws exceptions:
+     * - It throws std::runtime_error if the PKG's header could not be
+     * decrypted.
+     * - It throws the same exceptions PkgFile::Parse does.
+     *
+     * @param pkgFile The PKG file to add. The file system only takes its
+     * ownership if it was added, it's left untouched if this throws.
+     */
+    virtual void AddArchive(PkgFile::ptr_t&& pkgFile) = 0;
+
+    /**
+     * @brief Adds every PKG file listed in an index to the file system.
+     *
+     * The index must be parsed. Every PKG file listed in it is opened from the
+     * directory with PkgFile::Open. PKG files missing from the directory are
+     * skipped, since game installs don't always have every PKG.
+     *
+     * This method throws exceptions:
+     * - It throws the same exceptions PkgFile::Open and AddArchive do.
+     *
+     * @param index The parsed index listing the PKG files.
+     * @param pkgDirectory The directory holding the PKG files.
+     * @param szEntryKey The PKG data entries' key.
+     * @param szDataKey The PKG data's key.
+     * @param options The options to open the PKG files with, it may be null.
+     *
+     * @return std::uint64_t How many PKG files were added.
+     */
+    virtual std::uint64_t AddIndex(PkgIndex& index,
+                                   const std::filesystem::path& pkgDirectory,
+                                   std::string szEntryKey,
+                                   std::string szDataKey,
+                                   PkgFileOptions* options = nullptr) = 0;
+
+    /**
+     * @brief Finds a file entry by its path.
+     *
+     * @param szvPath The file's path, such as "/materials/foo.vtf".
+     *
+     * @return std::pair<PkgFile*, PkgEntry*> The PKG file holding the file
+     * and the file's entry, or a pair of null pointers if it wasn't found.
+     */
+    virtual std::pair<PkgFile*, PkgEntry*> Find(std::string_view szvPath) = 0;
+
+    /**
+     * @brief Finds a file entry by its path.
+     *
+     * @param szvPath The file's path, such as "/materials/foo.vtf".
+     *
+     * @return PkgEntry* The file's entry, or null if it wasn't found.
+     */
+    virtual PkgEntry* FindEntry(std::string_view szvPath) = 0;
+
+    /**
+     * @brief Get the number of PKG files in the file system.
+     *
+     * @return std::uint64_t The number of PKG files.
+     */
+    virtual std::uint64_t GetArchivesNum() = 0;
+
+    /**
+     * @brief Get the number of unique file paths in the file system.
+     *
+     * @return std::uint64_t The number of file paths.
+     */
+    virtual std::uint64_t GetEntriesNum() = 0;
+
+    /**
+     * @brief Construct a new, empty, PkgFileSystem object.
+     *
+     * @return ptr_t the new PkgFileSystem object.
+     */
+    static ptr_t Create();
+};
+}  // namespace uc2
@@ -0,0 +1,67 @@
+/**
+ * @file stats.h
+ * @author Luís Leite (luis@leite.xyz)
+ * @brief Counters of libuncso2's decryption, key derivation and
+ * decompression work.
+ * @version 1.0
+ */
+
+#pragma once
+
+#include "uc2defs.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    /**
+     * @brief The work done by libuncso2 since the statistics were last
+     * reset. It has the same members as uc2::Stats.
+     *
+     * The times are wall clock times, in nanoseconds, summed across threads.
+     */
+    typedef struct
+    {
+        uint64_t iDesBytesDecrypted;
+        uint64_t iAesBytesDecrypted;
+        uint64_t iBlowfishBytesDecrypted;
+        uint64_t iBlocksDecrypted;
+        uint64_t iEntriesParsed;
+        uint64_t iKeysDerived;
+        uint64_t iLzmaChunksDecoded;
+        uint64_t iDecryptNs;
+        uint64_t iKeyDerivationNs;
+        uint64_t iLzmaNs;
+    } Stats_t;
+
+    /**
+     * @brief Sums the counters of every thread.
+     *
+     * @param pOutStats Where to write the counters to
+     *
+     * @return true if successful, false if not
+     */
+    UNCSO2_API bool UNCSO2_CALLMETHOD uncso2_Stats_Get(Stats_t* pOutStats);
+
+    /**
+     * @brief Sets every counter to zero.
+     */
+    UNCSO2_API void UNCSO2_CALLMETHOD uncso2_Stats_Reset();
+
+    /**
+     * @brief Starts or stops updating the counters. They are disabled by
+     * default.
+     *
+     * @param bEnabled true to start updating the counters, false to stop
+     */
+    UNCSO2_API void UNCSO2_CALLMETHOD uncso2_Stats_SetEnabled(bool bEnabled);
+
+    /**
+     * @brief Checks if the counters are being updated
+     *
+     * @return true if they are, false if not
+     */
+    UNCSO2_API bool UNCSO2_CALLMETHOD uncso2_Stats_IsEnabled();
+#ifdef __cplusplus
+}
+#endif
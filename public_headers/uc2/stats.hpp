@@ -0,0 +1,106 @@
+/**
+ * @file stats.hpp
+ * @author Luís Leite (luis@leite.xyz)
+ * @brief Counters of libuncso2's decryption, key derivation and
+ * decompression work.
+ * @version 1.0
+ */
+
+#pragma once
+
+#include "uc2defs.h"
+
+#include <cstdint>
+
+/**
+ * @brief The libuncso2's namespace
+ */
+namespace uc2
+{
+/**
+ * @brief The work done by libuncso2 since the statistics were last reset.
+ *
+ * The statistics are disabled by default. While they are disabled, the
+ * counters are not updated and nothing is timed.
+ *
+ * Every thread updates its own counters, which are only summed when the
+ * statistics are read, so counting is cheap even when many threads decrypt
+ * or decompress at the same time.
+ *
+ * The times are wall clock times, in nanoseconds, summed across threads.
+ */
+struct UNCSO2_API Stats
+{
+    /**
+     * @brief Bytes decrypted with DES
+     */
+    std::uint64_t iDesBytesDecrypted;
+    /**
+     * @brief Bytes decrypted with AES
+     */
+    std::uint64_t iAesBytesDecrypted;
+    /**
+     * @brief Bytes decrypted with Blowfish
+     */
+    std::uint64_t iBlowfishBytesDecrypted;
+    /**
+     * @brief Cipher blocks decrypted, with any cipher
+     */
+    std::uint64_t iBlocksDecrypted;
+    /**
+     * @brief PKG entries parsed, including the ones found in an entry cache
+     */
+    std::uint64_t iEntriesParsed;
+    /**
+     * @brief PKG and index file keys derived
+     */
+    std::uint64_t iKeysDerived;
+    /**
+     * @brief LZMA chunks decompressed
+     */
+    std::uint64_t iLzmaChunksDecoded;
+    /**
+     * @brief Time spent setting up ciphers and decrypting data
+     */
+    std::uint64_t iDecryptNs;
+    /**
+     * @brief Time spent deriving PKG and index file keys
+     */
+    std::uint64_t iKeyDerivationNs;
+    /**
+     * @brief Time spent decompressing LZMA chunks
+     */
+    std::uint64_t iLzmaNs;
+
+    /**
+     * @brief Sums the counters of every thread.
+     *
+     * The counters of threads that have exited are kept.
+     *
+     * @return Stats The work done since the last reset
+     */
+    static Stats Get();
+
+    /**
+     * @brief Sets every counter to zero.
+     *
+     * Work done by other threads while the counters are being reset is
+     * counted either before or after the reset.
+     */
+    static void Reset();
+
+    /**
+     * @brief Starts or stops updating the counters.
+     *
+     * @param bEnabled true to start updating the counters, false to stop
+     */
+    static void SetEnabled(bool bEnabled);
+
+    /**
+     * @brief Checks if the counters are being updated
+     *
+     * @return true if they are, false if not
+     */
+    static bool IsEnabled();
+};
+}  // namespace uc2
@@ -0,0 +1,41 @@
+/**
+ * @file trace.h
+ * @author Luís Leite (luis@leite.xyz)
+ * @brief Timelines of libuncso2's work, in the Chrome trace format.
+ * @version 1.0
+ */
+
+#pragma once
+
+#include "uc2defs.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    /**
+     * @brief Checks if libuncso2 was built with tracing, with the
+     * PKG_ENABLE_TRACING CMake option.
+     *
+     * @return true if it was, false if not
+     */
+    UNCSO2_API bool UNCSO2_CALLMETHOD uncso2_Trace_IsAvailable();
+
+    /**
+     * @brief Writes the recorded events to a Chrome trace JSON file.
+     *
+     * @param tracePath The file to write the JSON to
+     *
+     * @return true if successful, false if libuncso2 was built without
+     * tracing or if the file could not be written
+     */
+    UNCSO2_API bool UNCSO2_CALLMETHOD
+    uncso2_Trace_DumpChromeTrace(const char* tracePath);
+
+    /**
+     * @brief Forgets every event recorded until now.
+     */
+    UNCSO2_API void UNCSO2_CALLMETHOD uncso2_Trace_Clear();
+#ifdef __cplusplus
+}
+#endif
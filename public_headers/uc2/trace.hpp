@@ -0,0 +1,75 @@
+/**
+ * @file trace.hpp
+ * @author Luís Leite (luis@leite.xyz)
+ * @brief Timelines of libuncso2's work, in the Chrome trace format.
+ * @version 1.0
+ */
+
+#pragma once
+
+#include "uc2defs.h"
+
+#include <filesystem>
+#include <ostream>
+
+/**
+ * @brief The libuncso2's namespace
+ */
+namespace uc2
+{
+/**
+ * @brief Writes the trace events recorded by libuncso2.
+ *
+ * The events are only recorded if libuncso2 was built with the
+ * PKG_ENABLE_TRACING CMake option. When it is, every thread records when it
+ * starts and finishes decrypting a PKG's header, parsing a PKG, decrypting
+ * an entry, parsing an index or decompressing a texture, along with the
+ * file and the entry it is working on.
+ *
+ * Only the last 63 bytes of the file names and entry paths are kept, without
+ * cutting UTF-8 characters in half, so longer ones lose their beginning.
+ *
+ * Each thread keeps its latest events in its own ring buffer, so older
+ * events are overwritten. The events of a task that has not finished yet,
+ * such as a stalled one, are written without an end.
+ *
+ * The traces can be opened with chrome://tracing or https://ui.perfetto.dev.
+ */
+class UNCSO2_API Trace
+{
+public:
+    /**
+     * @brief Checks if libuncso2 was built with tracing.
+     *
+     * @return true if it was, false if not
+     */
+    static bool IsAvailable();
+
+    /**
+     * @brief Writes the recorded events as Chrome trace JSON.
+     *
+     * Events can be recorded by other threads while they're written.
+     *
+     * @param os The stream to write the JSON to
+     *
+     * @return true if successful, false if libuncso2 was built without
+     * tracing
+     */
+    static bool WriteChromeTrace(std::ostream& os);
+
+    /**
+     * @brief Writes the recorded events to a Chrome trace JSON file.
+     *
+     * @param tracePath The file to write the JSON to
+     *
+     * @return true if successful, false if libuncso2 was built without
+     * tracing or if the file could not be written
+     */
+    static bool DumpChromeTrace(const std::filesystem::path& tracePath);
+
+    /**
+     * @brief Forgets every event recorded until now.
+     */
+    static void Clear();
+};
+}  // namespace uc2
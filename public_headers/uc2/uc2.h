@@ -8,9 +8,17 @@
 #pragma once
 
 #include "encryptedfile.h"
+#include "encryptedtable.h"
 #include "lzmatexture.h"
+#include "lzmatexturereader.h"
 #include "pkgentry.h"
+#include "pkgentrycache.h"
+#include "pkgentryreader.h"
+#include "pkgextractor.h"
 #include "pkgfile.h"
 #include "pkgfileoptions.h"
+#include "pkgfilesystem.h"
 #include "pkgindex.h"
+#include "stats.h"
+#include "trace.h"
 #include "uc2version.h"
@@ -8,9 +8,17 @@
 #pragma once
 
 #include "encryptedfile.hpp"
+#include "encryptedtable.hpp"
 #include "lzmatexture.hpp"
+#include "lzmatexturereader.hpp"
 #include "pkgentry.hpp"
+#include "pkgentrycache.hpp"
+#include "pkgentryreader.hpp"
+#include "pkgextractor.hpp"
 #include "pkgfile.hpp"
 #include "pkgfileoptions.hpp"
+#include "pkgfilesystem.hpp"
 #include "pkgindex.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
 #include "uc2version.hpp"
@@ -39,8 +39,14 @@
 #endif  // _MSC_VER
 
 typedef void* EncryptedFile_t;
+typedef void* EncryptedTable_t;
 typedef void* LzmaTexture_t;
+typedef void* LzmaTextureReader_t;
 typedef void* PkgEntry_t;
+typedef void* PkgEntryCache_t;
+typedef void* PkgEntryReader_t;
+typedef void* PkgExtractor_t;
 typedef void* PkgFile_t;
 typedef void* PkgFileOptions_t;
+typedef void* PkgFileSystem_t;
 typedef void* PkgIndex_t;
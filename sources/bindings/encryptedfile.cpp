@@ -68,6 +68,29 @@ extern "C"
             return false;
         }
     }
+
+    bool UNCSO2_CALLMETHOD uncso2_EncryptedFile_DecryptTo(
+        EncryptedFile_t fileHandle, void* outBuffer, uint64_t outBufferSize,
+        uint64_t* outSize)
+    {
+        if (fileHandle == NULL || outBuffer == NULL || outSize == NULL)
+        {
+            return false;
+        }
+
+        auto pFile = reinterpret_cast<uc2::EncryptedFile*>(fileHandle);
+
+        try
+        {
+            *outSize = pFile->DecryptTo(static_cast<uint8_t*>(outBuffer),
+                                        outBufferSize);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            return false;
+        }
+    }
 #endif
 
 #ifdef __cplusplus
@@ -0,0 +1,174 @@
+#include "encryptedtable.h"
+#include "encryptedtableimpl.hpp"
+
+#include "encryptedfile.hpp"
+
+#ifdef __cplusplus
+extern "C"
+{
+    EncryptedTable_t UNCSO2_CALLMETHOD
+    uncso2_EncryptedTable_Create(EncryptedFile_t fileHandle, char delimiter)
+    {
+        if (fileHandle == NULL)
+        {
+            return NULL;
+        }
+
+        auto pFile = reinterpret_cast<uc2::EncryptedFile*>(fileHandle);
+
+        try
+        {
+            auto newTable = uc2::EncryptedTable::Create(*pFile, delimiter);
+            return reinterpret_cast<EncryptedTable_t>(newTable.release());
+        }
+        catch (const std::exception& e)
+        {
+            return NULL;
+        }
+    }
+
+    EncryptedTable_t UNCSO2_CALLMETHOD uncso2_EncryptedTable_CreateFromText(
+        const char* text, uint64_t textSize, char delimiter)
+    {
+        if (text == NULL && textSize != 0)
+        {
+            return NULL;
+        }
+
+        try
+        {
+            auto newTable = uc2::EncryptedTable::Create(
+                std::string_view(text, textSize), delimiter);
+            return reinterpret_cast<EncryptedTable_t>(newTable.release());
+        }
+        catch (const std::exception& e)
+        {
+            return NULL;
+        }
+    }
+
+    void UNCSO2_CALLMETHOD
+    uncso2_EncryptedTable_Free(EncryptedTable_t tableHandle)
+    {
+        auto pTable = reinterpret_cast<uc2::EncryptedTable*>(tableHandle);
+        delete pTable;
+    }
+
+    uint64_t UNCSO2_CALLMETHOD
+    uncso2_EncryptedTable_GetRowsNum(EncryptedTable_t tableHandle)
+    {
+        if (tableHandle == NULL)
+        {
+            return 0;
+        }
+
+        auto pTable = reinterpret_cast<uc2::EncryptedTable*>(tableHandle);
+        return pTable->GetRowsNum();
+    }
+
+    uint64_t UNCSO2_CALLMETHOD uncso2_EncryptedTable_GetColumnsNum(
+        EncryptedTable_t tableHandle, uint64_t row)
+    {
+        if (tableHandle == NULL)
+        {
+            return 0;
+        }
+
+        auto pTable = reinterpret_cast<uc2::EncryptedTable*>(tableHandle);
+
+        try
+        {
+            return pTable->GetColumnsNum(row);
+        }
+        catch (const std::exception& e)
+        {
+            return 0;
+        }
+    }
+
+    bool UNCSO2_CALLMETHOD uncso2_EncryptedTable_GetCell(
+        EncryptedTable_t tableHandle, uint64_t row, uint64_t column,
+        const char** outCell, uint64_t* outSize)
+    {
+        if (tableHandle == NULL || outCell == NULL || outSize == NULL)
+        {
+            return false;
+        }
+
+        auto pTable = reinterpret_cast<uc2::EncryptedTable*>(tableHandle);
+
+        try
+        {
+            std::string_view szvCell = pTable->GetCell(row, column);
+
+            *outCell = szvCell.data();
+            *outSize = szvCell.length();
+
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            return false;
+        }
+    }
+
+    bool UNCSO2_CALLMETHOD uncso2_EncryptedTable_GetCellInteger(
+        EncryptedTable_t tableHandle, uint64_t row, uint64_t column,
+        int64_t* outValue)
+    {
+        if (tableHandle == NULL || outValue == NULL)
+        {
+            return false;
+        }
+
+        auto pTable = reinterpret_cast<uc2::EncryptedTable*>(tableHandle);
+
+        try
+        {
+            *outValue = pTable->GetCellInteger(row, column);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            return false;
+        }
+    }
+
+    bool UNCSO2_CALLMETHOD uncso2_EncryptedTable_GetCellFloat(
+        EncryptedTable_t tableHandle, uint64_t row, uint64_t column,
+        double* outValue)
+    {
+        if (tableHandle == NULL || outValue == NULL)
+        {
+            return false;
+        }
+
+        auto pTable = reinterpret_cast<uc2::EncryptedTable*>(tableHandle);
+
+        try
+        {
+            *outValue = pTable->GetCellFloat(row, column);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            return false;
+        }
+    }
+
+    uint64_t UNCSO2_CALLMETHOD uncso2_EncryptedTable_FindColumn(
+        EncryptedTable_t tableHandle, const char* name)
+    {
+        if (tableHandle == NULL || name == NULL)
+        {
+            return uc2::EncryptedTable::COLUMN_NOT_FOUND;
+        }
+
+        auto pTable = reinterpret_cast<uc2::EncryptedTable*>(tableHandle);
+        return pTable->FindColumn(name);
+    }
+#endif
+
+#ifdef __cplusplus
+}
+#endif
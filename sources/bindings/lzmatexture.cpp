@@ -1,5 +1,6 @@
 #include "lzmatexture.h"
 #include "lzmatextureimpl.hpp"
+#include "pkgentry.hpp"
 
 #ifdef __cplusplus
 extern "C"
@@ -19,6 +20,27 @@ extern "C"
         }
     }
 
+    LzmaTexture_t UNCSO2_CALLMETHOD
+    uncso2_LzmaTexture_CreateFromEntry(PkgEntry_t entryHandle)
+    {
+        if (entryHandle == NULL)
+        {
+            return NULL;
+        }
+
+        auto pEntry = reinterpret_cast<uc2::PkgEntry*>(entryHandle);
+
+        try
+        {
+            auto newTex = uc2::LzmaTexture::Create(*pEntry);
+            return reinterpret_cast<LzmaTexture_t>(newTex.release());
+        }
+        catch (const std::exception& e)
+        {
+            return NULL;
+        }
+    }
+
     void UNCSO2_CALLMETHOD uncso2_LzmaTexture_Free(LzmaTexture_t texHandle)
     {
         auto pTex = reinterpret_cast<uc2::LzmaTexture*>(texHandle);
@@ -76,6 +98,29 @@ extern "C"
             return 0;
         }
     }
+
+    bool UNCSO2_CALLMETHOD uncso2_LzmaTexture_DecompressParallel(
+        LzmaTexture_t texHandle, void* outBuffer, uint64_t outBufferSize,
+        uint32_t threadsNum)
+    {
+        if (texHandle == NULL)
+        {
+            return false;
+        }
+
+        auto pTex = reinterpret_cast<uc2::LzmaTexture*>(texHandle);
+
+        try
+        {
+            return pTex->DecompressParallel(
+                reinterpret_cast<uint8_t*>(outBuffer), outBufferSize,
+                threadsNum);
+        }
+        catch (const std::exception& e)
+        {
+            return false;
+        }
+    }
 #endif
 
 #ifdef __cplusplus
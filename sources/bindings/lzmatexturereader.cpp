@@ -0,0 +1,112 @@
+#include "lzmatexturereader.h"
+#include "lzmatexturereader.hpp"
+#include "pkgentryreader.hpp"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    LzmaTextureReader_t UNCSO2_CALLMETHOD
+    uncso2_LzmaTextureReader_Create(const void* texBuffer, uint64_t texSize)
+    {
+        if (texBuffer == NULL)
+        {
+            return NULL;
+        }
+
+        try
+        {
+            auto newReader = uc2::LzmaTextureReader::Create(
+                reinterpret_cast<const uint8_t*>(texBuffer), texSize);
+            return reinterpret_cast<LzmaTextureReader_t>(newReader.release());
+        }
+        catch (const std::exception& e)
+        {
+            return NULL;
+        }
+    }
+
+    LzmaTextureReader_t UNCSO2_CALLMETHOD
+    uncso2_LzmaTextureReader_CreateFromEntry(
+        PkgEntryReader_t entryReaderHandle)
+    {
+        if (entryReaderHandle == NULL)
+        {
+            return NULL;
+        }
+
+        auto pEntryReader =
+            reinterpret_cast<uc2::PkgEntryReader*>(entryReaderHandle);
+
+        try
+        {
+            auto newReader = uc2::LzmaTextureReader::Create(*pEntryReader);
+            return reinterpret_cast<LzmaTextureReader_t>(newReader.release());
+        }
+        catch (const std::exception& e)
+        {
+            return NULL;
+        }
+    }
+
+    void UNCSO2_CALLMETHOD
+    uncso2_LzmaTextureReader_Free(LzmaTextureReader_t readerHandle)
+    {
+        auto pReader = reinterpret_cast<uc2::LzmaTextureReader*>(readerHandle);
+        delete pReader;
+    }
+
+    bool UNCSO2_CALLMETHOD
+    uncso2_LzmaTextureReader_Next(LzmaTextureReader_t readerHandle,
+                                  const void** outBuffer, uint64_t* outSize)
+    {
+        if (readerHandle == NULL || outBuffer == NULL || outSize == NULL)
+        {
+            return false;
+        }
+
+        auto pReader = reinterpret_cast<uc2::LzmaTextureReader*>(readerHandle);
+
+        try
+        {
+            auto result = pReader->Next();
+
+            *outBuffer = result.first;
+            *outSize = result.second;
+
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            return false;
+        }
+    }
+
+    uint64_t UNCSO2_CALLMETHOD
+    uncso2_LzmaTextureReader_GetOriginalSize(LzmaTextureReader_t readerHandle)
+    {
+        if (readerHandle == NULL)
+        {
+            return 0;
+        }
+
+        auto pReader = reinterpret_cast<uc2::LzmaTextureReader*>(readerHandle);
+
+        try
+        {
+            return pReader->GetOriginalSize();
+        }
+        catch (const std::exception& e)
+        {
+            return 0;
+        }
+    }
+
+    uint64_t UNCSO2_CALLMETHOD uncso2_LzmaTextureReader_GetWindowSize()
+    {
+        return uc2::LzmaTextureReader::GetWindowSize();
+    }
+
+#ifdef __cplusplus
+}
+#endif
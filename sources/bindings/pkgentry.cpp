@@ -31,6 +31,54 @@ extern "C"
         }
     }
 
+    bool UNCSO2_CALLMETHOD uncso2_PkgEntry_DecryptTo(
+        PkgEntry_t entryHandle, void* outBuffer, uint64_t outBufferSize,
+        uint64_t* outSize, uint64_t bytesToDecrypt /*= 0 */)
+    {
+        if (entryHandle == NULL || outBuffer == NULL || outSize == NULL)
+        {
+            return false;
+        }
+
+        auto pEntry = reinterpret_cast<uc2::PkgEntry*>(entryHandle);
+
+        try
+        {
+            *outSize = pEntry->DecryptFileTo(static_cast<uint8_t*>(outBuffer),
+                                             outBufferSize, bytesToDecrypt);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            return false;
+        }
+    }
+
+    bool UNCSO2_CALLMETHOD uncso2_PkgEntry_ReadRange(PkgEntry_t entryHandle,
+                                                     uint64_t offset,
+                                                     uint64_t length,
+                                                     void* outBuffer,
+                                                     uint64_t* outSize)
+    {
+        if (entryHandle == NULL || outBuffer == NULL || outSize == NULL)
+        {
+            return false;
+        }
+
+        auto pEntry = reinterpret_cast<uc2::PkgEntry*>(entryHandle);
+
+        try
+        {
+            *outSize = pEntry->ReadRange(offset, length,
+                                         static_cast<uint8_t*>(outBuffer));
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            return false;
+        }
+    }
+
     const char* UNCSO2_CALLMETHOD
     uncso2_PkgEntry_GetPath(PkgEntry_t entryHandle)
     {
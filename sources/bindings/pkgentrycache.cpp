@@ -0,0 +1,69 @@
+#include "pkgentrycache.h"
+#include "pkgentrycache.hpp"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    PkgEntryCache_t UNCSO2_CALLMETHOD
+    uncso2_PkgEntryCache_Open(const char* cachePath)
+    {
+        if (cachePath == NULL)
+        {
+            return NULL;
+        }
+
+        try
+        {
+            auto newCache = uc2::PkgEntryCache::Open(cachePath);
+            return reinterpret_cast<PkgEntryCache_t>(newCache.release());
+        }
+        catch (const std::exception& e)
+        {
+            return NULL;
+        }
+    }
+
+    void UNCSO2_CALLMETHOD
+    uncso2_PkgEntryCache_Free(PkgEntryCache_t cacheHandle)
+    {
+        auto pCache = reinterpret_cast<uc2::PkgEntryCache*>(cacheHandle);
+        delete pCache;
+    }
+
+    bool UNCSO2_CALLMETHOD
+    uncso2_PkgEntryCache_Save(PkgEntryCache_t cacheHandle)
+    {
+        if (cacheHandle == NULL)
+        {
+            return false;
+        }
+
+        auto pCache = reinterpret_cast<uc2::PkgEntryCache*>(cacheHandle);
+
+        try
+        {
+            pCache->Save();
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            return false;
+        }
+    }
+
+    uint64_t UNCSO2_CALLMETHOD
+    uncso2_PkgEntryCache_GetArchivesNum(PkgEntryCache_t cacheHandle)
+    {
+        if (cacheHandle == NULL)
+        {
+            return 0;
+        }
+
+        auto pCache = reinterpret_cast<uc2::PkgEntryCache*>(cacheHandle);
+        return pCache->GetArchivesNum();
+    }
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,105 @@
+#include "pkgentry.hpp"
+#include "pkgentryreader.h"
+#include "pkgentryreader.hpp"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    PkgEntryReader_t UNCSO2_CALLMETHOD
+    uncso2_PkgEntryReader_Create(PkgEntry_t entryHandle)
+    {
+        if (entryHandle == NULL)
+        {
+            return NULL;
+        }
+
+        auto pEntry = reinterpret_cast<uc2::PkgEntry*>(entryHandle);
+
+        try
+        {
+            auto newReader = uc2::PkgEntryReader::Create(*pEntry);
+            return reinterpret_cast<PkgEntryReader_t>(newReader.release());
+        }
+        catch (const std::exception& e)
+        {
+            return NULL;
+        }
+    }
+
+    PkgEntryReader_t UNCSO2_CALLMETHOD
+    uncso2_PkgEntryReader_CreateFromFile(PkgEntry_t entryHandle,
+                                         int fileDescriptor)
+    {
+        if (entryHandle == NULL)
+        {
+            return NULL;
+        }
+
+        auto pEntry = reinterpret_cast<uc2::PkgEntry*>(entryHandle);
+
+        try
+        {
+            auto newReader =
+                uc2::PkgEntryReader::CreateFromFile(*pEntry, fileDescriptor);
+            return reinterpret_cast<PkgEntryReader_t>(newReader.release());
+        }
+        catch (const std::exception& e)
+        {
+            return NULL;
+        }
+    }
+
+    void UNCSO2_CALLMETHOD
+    uncso2_PkgEntryReader_Free(PkgEntryReader_t readerHandle)
+    {
+        auto pReader = reinterpret_cast<uc2::PkgEntryReader*>(readerHandle);
+        delete pReader;
+    }
+
+    bool UNCSO2_CALLMETHOD
+    uncso2_PkgEntryReader_Next(PkgEntryReader_t readerHandle,
+                               const void** outBuffer, uint64_t* outSize)
+    {
+        if (readerHandle == NULL || outBuffer == NULL || outSize == NULL)
+        {
+            return false;
+        }
+
+        auto pReader = reinterpret_cast<uc2::PkgEntryReader*>(readerHandle);
+
+        try
+        {
+            auto result = pReader->Next();
+
+            *outBuffer = result.first;
+            *outSize = result.second;
+
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            return false;
+        }
+    }
+
+    void UNCSO2_CALLMETHOD
+    uncso2_PkgEntryReader_Rewind(PkgEntryReader_t readerHandle)
+    {
+        if (readerHandle == NULL)
+        {
+            return;
+        }
+
+        auto pReader = reinterpret_cast<uc2::PkgEntryReader*>(readerHandle);
+        pReader->Rewind();
+    }
+
+    uint64_t UNCSO2_CALLMETHOD uncso2_PkgEntryReader_GetChunkSize()
+    {
+        return uc2::PkgEntryReader::GetChunkSize();
+    }
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,67 @@
+#include "pkgextractor.h"
+#include "pkgextractor.hpp"
+#include "pkgfile.hpp"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    PkgExtractor_t UNCSO2_CALLMETHOD
+    uncso2_PkgExtractor_Create(PkgFile_t pkgHandle, uint32_t threadsNum)
+    {
+        if (pkgHandle == NULL)
+        {
+            return NULL;
+        }
+
+        auto pPkg = reinterpret_cast<uc2::PkgFile*>(pkgHandle);
+
+        try
+        {
+            auto newExtractor = uc2::PkgExtractor::Create(*pPkg, threadsNum);
+            return reinterpret_cast<PkgExtractor_t>(newExtractor.release());
+        }
+        catch (const std::exception& e)
+        {
+            return NULL;
+        }
+    }
+
+    void UNCSO2_CALLMETHOD
+    uncso2_PkgExtractor_Free(PkgExtractor_t extractorHandle)
+    {
+        auto pExtractor = reinterpret_cast<uc2::PkgExtractor*>(extractorHandle);
+        delete pExtractor;
+    }
+
+    bool UNCSO2_CALLMETHOD uncso2_PkgExtractor_ExtractAll(
+        PkgExtractor_t extractorHandle, const char* outDirectory,
+        uint64_t* outExtractedNum)
+    {
+        if (extractorHandle == NULL || outDirectory == NULL)
+        {
+            return false;
+        }
+
+        auto pExtractor = reinterpret_cast<uc2::PkgExtractor*>(extractorHandle);
+
+        try
+        {
+            const uint64_t iExtractedNum = pExtractor->ExtractAll(outDirectory);
+
+            if (outExtractedNum != NULL)
+            {
+                *outExtractedNum = iExtractedNum;
+            }
+
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            return false;
+        }
+    }
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,6 +1,26 @@
 #include "pkgfile.h"
 #include "pkg/pkgfileimpl.hpp"
 
+#include <algorithm>
+
+// Writes the found entries that fit in outEntries, and returns how many
+// there are
+static uint64_t CopyFoundEntries(const std::vector<uc2::PkgEntry*>& vFound,
+                                 PkgEntry_t* outEntries, uint64_t maxEntries)
+{
+    if (outEntries != NULL)
+    {
+        const uint64_t iCopyNum = std::min<uint64_t>(vFound.size(), maxEntries);
+
+        for (uint64_t i = 0; i < iCopyNum; i++)
+        {
+            outEntries[i] = reinterpret_cast<PkgEntry_t>(vFound[i]);
+        }
+    }
+
+    return vFound.size();
+}
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -26,6 +46,29 @@ extern "C"
         }
     }
 
+    PkgFile_t UNCSO2_CALLMETHOD uncso2_PkgFile_Open(
+        const char* pkgPath, const char* szEntryKey, const char* szDataKey,
+        PkgFileOptions_t options /*= NULL*/)
+    {
+        if (pkgPath == NULL)
+        {
+            return NULL;
+        }
+
+        auto pOptions = reinterpret_cast<uc2::PkgFileOptions*>(options);
+
+        try
+        {
+            auto newPkg =
+                uc2::PkgFile::Open(pkgPath, szEntryKey, szDataKey, pOptions);
+            return reinterpret_cast<PkgFile_t>(newPkg.release());
+        }
+        catch (const std::exception& e)
+        {
+            return NULL;
+        }
+    }
+
     void UNCSO2_CALLMETHOD uncso2_PkgFile_Free(PkgFile_t pkgHandle)
     {
         auto pPkg = reinterpret_cast<uc2::PkgFile*>(pkgHandle);
@@ -184,7 +227,7 @@ extern "C"
 
         try
         {
-            return pPkg->GetEntries().size();
+            return pPkg->GetEntriesNum();
         }
         catch (const std::exception& e)
         {
@@ -211,6 +254,90 @@ extern "C"
         }
     }
 
+    PkgEntry_t UNCSO2_CALLMETHOD uncso2_PkgFile_GetEntry(PkgFile_t pkgHandle,
+                                                         uint64_t index)
+    {
+        if (pkgHandle == NULL)
+        {
+            return NULL;
+        }
+
+        auto pPkg = reinterpret_cast<uc2::PkgFile*>(pkgHandle);
+
+        try
+        {
+            return reinterpret_cast<PkgEntry_t>(&pPkg->GetEntry(index));
+        }
+        catch (const std::exception& e)
+        {
+            return NULL;
+        }
+    }
+
+    PkgEntry_t UNCSO2_CALLMETHOD uncso2_PkgFile_FindEntry(PkgFile_t pkgHandle,
+                                                          const char* path)
+    {
+        if (pkgHandle == NULL || path == NULL)
+        {
+            return NULL;
+        }
+
+        auto pPkg = reinterpret_cast<uc2::PkgFile*>(pkgHandle);
+
+        try
+        {
+            return reinterpret_cast<PkgEntry_t>(pPkg->FindEntry(path));
+        }
+        catch (const std::exception& e)
+        {
+            return NULL;
+        }
+    }
+
+    uint64_t UNCSO2_CALLMETHOD uncso2_PkgFile_FindEntriesByPrefix(
+        PkgFile_t pkgHandle, const char* prefix, PkgEntry_t* outEntries,
+        uint64_t maxEntries)
+    {
+        if (pkgHandle == NULL || prefix == NULL)
+        {
+            return 0;
+        }
+
+        auto pPkg = reinterpret_cast<uc2::PkgFile*>(pkgHandle);
+
+        try
+        {
+            return CopyFoundEntries(pPkg->FindEntriesByPrefix(prefix),
+                                    outEntries, maxEntries);
+        }
+        catch (const std::exception& e)
+        {
+            return 0;
+        }
+    }
+
+    uint64_t UNCSO2_CALLMETHOD uncso2_PkgFile_ListDirectory(
+        PkgFile_t pkgHandle, const char* directory, bool recursive,
+        PkgEntry_t* outEntries, uint64_t maxEntries)
+    {
+        if (pkgHandle == NULL || directory == NULL)
+        {
+            return 0;
+        }
+
+        auto pPkg = reinterpret_cast<uc2::PkgFile*>(pkgHandle);
+
+        try
+        {
+            return CopyFoundEntries(pPkg->ListDirectory(directory, recursive),
+                                    outEntries, maxEntries);
+        }
+        catch (const std::exception& e)
+        {
+            return 0;
+        }
+    }
+
     uint64_t UNCSO2_CALLMETHOD uncso2_PkgFile_GetHeaderSize(bool bTfoPkg)
     {
         return uc2::PkgFile::GetHeaderSize(bTfoPkg);
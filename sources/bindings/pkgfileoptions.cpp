@@ -1,5 +1,6 @@
 #include "pkgfileoptions.h"
 #include "pkgfileoptions.hpp"
+#include "pkgentrycache.hpp"
 
 #ifdef __cplusplus
 extern "C"
@@ -63,6 +64,107 @@ extern "C"
             return false;
         }
     }
+
+    void UNCSO2_CALLMETHOD uncso2_PkgFileOptions_SetDecryptThreads(
+        PkgFileOptions_t optionsHandle, uint32_t threadsNum)
+    {
+        if (optionsHandle == NULL)
+        {
+            return;
+        }
+
+        auto pOptions = reinterpret_cast<uc2::PkgFileOptions*>(optionsHandle);
+
+        try
+        {
+            pOptions->SetDecryptThreads(threadsNum);
+        }
+        catch (const std::exception& e)
+        {
+            return;
+        }
+    }
+
+    uint32_t UNCSO2_CALLMETHOD
+    uncso2_PkgFileOptions_GetDecryptThreads(PkgFileOptions_t optionsHandle)
+    {
+        if (optionsHandle == NULL)
+        {
+            return 0;
+        }
+
+        auto pOptions = reinterpret_cast<uc2::PkgFileOptions*>(optionsHandle);
+
+        try
+        {
+            return pOptions->GetDecryptThreads();
+        }
+        catch (const std::exception& e)
+        {
+            return 0;
+        }
+    }
+
+    void UNCSO2_CALLMETHOD uncso2_PkgFileOptions_SetEntryCache(
+        PkgFileOptions_t optionsHandle, PkgEntryCache_t cacheHandle)
+    {
+        if (optionsHandle == NULL)
+        {
+            return;
+        }
+
+        auto pOptions = reinterpret_cast<uc2::PkgFileOptions*>(optionsHandle);
+        auto pCache = reinterpret_cast<uc2::PkgEntryCache*>(cacheHandle);
+
+        try
+        {
+            pOptions->SetEntryCache(pCache);
+        }
+        catch (const std::exception& e)
+        {
+            return;
+        }
+    }
+
+    void UNCSO2_CALLMETHOD uncso2_PkgFileOptions_SetLazyEntries(
+        PkgFileOptions_t optionsHandle, bool state)
+    {
+        if (optionsHandle == NULL)
+        {
+            return;
+        }
+
+        auto pOptions = reinterpret_cast<uc2::PkgFileOptions*>(optionsHandle);
+
+        try
+        {
+            pOptions->SetLazyEntries(state);
+        }
+        catch (const std::exception& e)
+        {
+            return;
+        }
+    }
+
+    bool UNCSO2_CALLMETHOD
+    uncso2_PkgFileOptions_IsLazyEntries(PkgFileOptions_t optionsHandle)
+    {
+        if (optionsHandle == NULL)
+        {
+            return false;
+        }
+
+        auto pOptions = reinterpret_cast<uc2::PkgFileOptions*>(optionsHandle);
+
+        try
+        {
+            return pOptions->IsLazyEntries();
+        }
+        catch (const std::exception& e)
+        {
+            return false;
+        }
+    }
 #endif
 
 #ifdef __cplusplus
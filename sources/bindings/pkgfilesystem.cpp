@@ -0,0 +1,126 @@
+#include "pkgfilesystem.h"
+#include "pkgfilesystem.hpp"
+#include "pkgfileoptions.hpp"
+#include "pkgindex.hpp"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    PkgFileSystem_t UNCSO2_CALLMETHOD uncso2_PkgFileSystem_Create()
+    {
+        try
+        {
+            auto newFs = uc2::PkgFileSystem::Create();
+            return reinterpret_cast<PkgFileSystem_t>(newFs.release());
+        }
+        catch (const std::exception& e)
+        {
+            return NULL;
+        }
+    }
+
+    void UNCSO2_CALLMETHOD uncso2_PkgFileSystem_Free(PkgFileSystem_t fsHandle)
+    {
+        auto pFs = reinterpret_cast<uc2::PkgFileSystem*>(fsHandle);
+        delete pFs;
+    }
+
+    bool UNCSO2_CALLMETHOD uncso2_PkgFileSystem_AddArchive(
+        PkgFileSystem_t fsHandle, PkgFile_t pkgHandle)
+    {
+        if (fsHandle == NULL || pkgHandle == NULL)
+        {
+            return false;
+        }
+
+        auto pFs = reinterpret_cast<uc2::PkgFileSystem*>(fsHandle);
+        uc2::PkgFile::ptr_t pkgFile(reinterpret_cast<uc2::PkgFile*>(pkgHandle));
+
+        try
+        {
+            pFs->AddArchive(std::move(pkgFile));
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            // AddArchive only takes the ownership once the file was added,
+            // give it back to the caller
+            static_cast<void>(pkgFile.release());
+            return false;
+        }
+    }
+
+    bool UNCSO2_CALLMETHOD uncso2_PkgFileSystem_AddIndex(
+        PkgFileSystem_t fsHandle, PkgIndex_t indexHandle,
+        const char* pkgDirectory, const char* szEntryKey,
+        const char* szDataKey, PkgFileOptions_t options,
+        uint64_t* outAddedNum)
+    {
+        if (fsHandle == NULL || indexHandle == NULL || pkgDirectory == NULL ||
+            szEntryKey == NULL || szDataKey == NULL)
+        {
+            return false;
+        }
+
+        auto pFs = reinterpret_cast<uc2::PkgFileSystem*>(fsHandle);
+        auto pIndex = reinterpret_cast<uc2::PkgIndex*>(indexHandle);
+        auto pOptions = reinterpret_cast<uc2::PkgFileOptions*>(options);
+
+        try
+        {
+            const uint64_t iAddedNum = pFs->AddIndex(
+                *pIndex, pkgDirectory, szEntryKey, szDataKey, pOptions);
+
+            if (outAddedNum != NULL)
+            {
+                *outAddedNum = iAddedNum;
+            }
+
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            return false;
+        }
+    }
+
+    PkgEntry_t UNCSO2_CALLMETHOD
+    uncso2_PkgFileSystem_FindEntry(PkgFileSystem_t fsHandle, const char* szPath)
+    {
+        if (fsHandle == NULL || szPath == NULL)
+        {
+            return NULL;
+        }
+
+        auto pFs = reinterpret_cast<uc2::PkgFileSystem*>(fsHandle);
+        return reinterpret_cast<PkgEntry_t>(pFs->FindEntry(szPath));
+    }
+
+    uint64_t UNCSO2_CALLMETHOD
+    uncso2_PkgFileSystem_GetArchivesNum(PkgFileSystem_t fsHandle)
+    {
+        if (fsHandle == NULL)
+        {
+            return 0;
+        }
+
+        auto pFs = reinterpret_cast<uc2::PkgFileSystem*>(fsHandle);
+        return pFs->GetArchivesNum();
+    }
+
+    uint64_t UNCSO2_CALLMETHOD
+    uncso2_PkgFileSystem_GetEntriesNum(PkgFileSystem_t fsHandle)
+    {
+        if (fsHandle == NULL)
+        {
+            return 0;
+        }
+
+        auto pFs = reinterpret_cast<uc2::PkgFileSystem*>(fsHandle);
+        return pFs->GetEntriesNum();
+    }
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,59 @@
+#include "stats.h"
+#include "stats.hpp"
+
+#include <exception>
+
+static_assert(sizeof(Stats_t) == sizeof(uc2::Stats),
+              "The C and C++ stats must have the same members");
+
+#ifdef __cplusplus
+extern "C"
+{
+    bool UNCSO2_CALLMETHOD uncso2_Stats_Get(Stats_t* pOutStats)
+    {
+        if (pOutStats == NULL)
+        {
+            return false;
+        }
+
+        try
+        {
+            const uc2::Stats stats = uc2::Stats::Get();
+
+            pOutStats->iDesBytesDecrypted = stats.iDesBytesDecrypted;
+            pOutStats->iAesBytesDecrypted = stats.iAesBytesDecrypted;
+            pOutStats->iBlowfishBytesDecrypted = stats.iBlowfishBytesDecrypted;
+            pOutStats->iBlocksDecrypted = stats.iBlocksDecrypted;
+            pOutStats->iEntriesParsed = stats.iEntriesParsed;
+            pOutStats->iKeysDerived = stats.iKeysDerived;
+            pOutStats->iLzmaChunksDecoded = stats.iLzmaChunksDecoded;
+            pOutStats->iDecryptNs = stats.iDecryptNs;
+            pOutStats->iKeyDerivationNs = stats.iKeyDerivationNs;
+            pOutStats->iLzmaNs = stats.iLzmaNs;
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            return false;
+        }
+    }
+
+    void UNCSO2_CALLMETHOD uncso2_Stats_Reset()
+    {
+        uc2::Stats::Reset();
+    }
+
+    void UNCSO2_CALLMETHOD uncso2_Stats_SetEnabled(bool bEnabled)
+    {
+        uc2::Stats::SetEnabled(bEnabled);
+    }
+
+    bool UNCSO2_CALLMETHOD uncso2_Stats_IsEnabled()
+    {
+        return uc2::Stats::IsEnabled();
+    }
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,39 @@
+#include "trace.h"
+#include "trace.hpp"
+
+#include <exception>
+
+#ifdef __cplusplus
+extern "C"
+{
+    bool UNCSO2_CALLMETHOD uncso2_Trace_IsAvailable()
+    {
+        return uc2::Trace::IsAvailable();
+    }
+
+    bool UNCSO2_CALLMETHOD uncso2_Trace_DumpChromeTrace(const char* tracePath)
+    {
+        if (tracePath == NULL)
+        {
+            return false;
+        }
+
+        try
+        {
+            return uc2::Trace::DumpChromeTrace(tracePath);
+        }
+        catch (const std::exception& e)
+        {
+            return false;
+        }
+    }
+
+    void UNCSO2_CALLMETHOD uncso2_Trace_Clear()
+    {
+        uc2::Trace::Clear();
+    }
+#endif
+
+#ifdef __cplusplus
+}
+#endif
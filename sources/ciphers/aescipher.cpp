@@ -1,44 +1,78 @@
 #include "ciphers/aescipher.hpp"
 
-#include <aes.h>
-#include <filters.h>
-#include <modes.h>
+#include "statsimpl.hpp"
 
 namespace uc2
 {
-CAesCipher::CAesCipher() {}
+CAesCipher::CAesCipher() : m_Kernel(AesKernel::None) {}
 
 CAesCipher::~CAesCipher() {}
 
 void CAesCipher::Initialize(std::string_view key, std::string_view iv,
                             bool paddingEnabled /*= false*/)
 {
-    this->m_szvKey = key;
-    this->m_szvIV = iv;
+    this->SetIV(iv);
     this->m_bPaddingEnabled = paddingEnabled;
+
+    this->m_Kernel = GetBestAesKernel();
+
+    // the native kernels only handle 128 and 256 bits keys, the others are
+    // left to Crypto++
+    if (this->m_Kernel != AesKernel::None &&
+        ExpandAesDecryptionKeys(
+            reinterpret_cast<const std::uint8_t*>(key.data()), key.length(),
+            this->m_DecryptionKeys) == true)
+    {
+        return;
+    }
+
+    this->m_Kernel = AesKernel::None;
+
+    // schedule the key once, every Decrypt call only resets the IV
+    this->m_Decryption.SetKeyWithIV(
+        reinterpret_cast<const std::uint8_t*>(key.data()), key.length(),
+        this->m_IV.data());
 }
 
 std::uint64_t CAesCipher::Decrypt(gsl::span<const std::uint8_t> inData,
                                   gsl::span<std::uint8_t> outBuffer)
 {
-    CryptoPP::CBC_Mode<CryptoPP::AES>::Decryption dec;
+    constexpr const std::size_t iBlockSize = CryptoPP::AES::BLOCKSIZE;
 
-    dec.SetKeyWithIV(
-        reinterpret_cast<const std::uint8_t*>(this->m_szvKey.data()),
-        this->m_szvKey.length(),
-        reinterpret_cast<const std::uint8_t*>(this->m_szvIV.data()));
+    IBaseCipher::ValidateBuffers(inData, outBuffer, iBlockSize);
 
-    auto scheme = this->m_bPaddingEnabled ?
-                      CryptoPP::BlockPaddingSchemeDef::DEFAULT_PADDING :
-                      CryptoPP::BlockPaddingSchemeDef::NO_PADDING;
+    if (inData.empty() == true)
+    {
+        return 0;
+    }
 
-    auto sink =
-        new CryptoPP::ArraySink(outBuffer.data(), outBuffer.size_bytes());
-    auto filter = new CryptoPP::StreamTransformationFilter(dec, sink, scheme);
+    AddStat(StatsCounter::AesBytesDecrypted, inData.size_bytes());
+    AddStat(StatsCounter::BlocksDecrypted, inData.size_bytes() / iBlockSize);
 
-    CryptoPP::StringSource source(inData.data(), inData.size_bytes(), true,
-                                  filter);
+    if (this->m_Kernel != AesKernel::None)
+    {
+        DecryptAesCbc(this->m_Kernel, this->m_DecryptionKeys,
+                      this->m_IV.data(), inData.data(), outBuffer.data(),
+                      inData.size_bytes() / iBlockSize);
+    }
+    else
+    {
+        this->m_Decryption.Resynchronize(this->m_IV.data());
+        this->m_Decryption.ProcessData(outBuffer.data(), inData.data(),
+                                       inData.size_bytes());
+    }
 
-    return sink->TotalPutLength();
+    if (this->m_bPaddingEnabled == true)
+    {
+        return IBaseCipher::GetUnpaddedLength(
+            outBuffer.first(inData.size_bytes()), iBlockSize);
+    }
+
+    return inData.size_bytes();
+}
+
+std::size_t CAesCipher::GetBlockSize() const
+{
+    return CryptoPP::AES::BLOCKSIZE;
 }
-}  // namespace uc2
\ No newline at end of file
+}  // namespace uc2
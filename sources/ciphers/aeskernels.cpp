@@ -0,0 +1,434 @@
+#include "ciphers/aeskernels.hpp"
+
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
+    defined(_M_IX86)
+#define UC2_AES_KERNELS_X86
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// MSVC allows every instruction set's intrinsics anywhere, the other
+// compilers must be told which functions use them
+#if defined(UC2_AES_KERNELS_X86) && !defined(_MSC_VER)
+#define UC2_TARGET_AESNI __attribute__((target("sse2,aes")))
+#define UC2_TARGET_VAES512 __attribute__((target("sse2,aes,avx512f,vaes")))
+#else
+#define UC2_TARGET_AESNI
+#define UC2_TARGET_VAES512
+#endif
+
+// the blocks' states must stay in registers, which needs the loops over
+// them to be unrolled even without -O3
+#if defined(__GNUC__)
+#define UC2_UNROLL_LOOP _Pragma("GCC unroll 16")
+#else
+#define UC2_UNROLL_LOOP
+#endif
+
+namespace uc2
+{
+#ifdef UC2_AES_KERNELS_X86
+constexpr const std::size_t AES_BLOCK_SIZE = 16;
+constexpr const std::size_t AES_128_KEY_LENGTH = 16;
+constexpr const std::size_t AES_128_ROUNDS = 10;
+constexpr const std::size_t AES_256_KEY_LENGTH = 32;
+constexpr const std::size_t AES_256_ROUNDS = 14;
+// the blocks decrypted by each iteration of the kernels, enough to hide the
+// latency of the AES instructions
+constexpr const std::size_t AESNI_BLOCKS_PER_ITER = 8;
+constexpr const std::size_t VAES512_REGS_PER_ITER = 4;
+constexpr const std::size_t VAES512_BLOCKS_PER_ITER =
+    VAES512_REGS_PER_ITER * 4;
+
+static void GetCpuId(unsigned int iLeaf, unsigned int iSubLeaf,
+                     unsigned int (&outRegs)[4])
+{
+#ifdef _MSC_VER
+    int regs[4];
+    __cpuidex(regs, static_cast<int>(iLeaf), static_cast<int>(iSubLeaf));
+
+    for (int i = 0; i < 4; i++)
+    {
+        outRegs[i] = static_cast<unsigned int>(regs[i]);
+    }
+#else
+    if (__get_cpuid_count(iLeaf, iSubLeaf, &outRegs[0], &outRegs[1],
+                          &outRegs[2], &outRegs[3]) == 0)
+    {
+        outRegs[0] = outRegs[1] = outRegs[2] = outRegs[3] = 0;
+    }
+#endif
+}
+
+// The register states the OS saves on context switches
+static std::uint64_t GetEnabledXStates()
+{
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    std::uint32_t iLow;
+    std::uint32_t iHigh;
+    __asm__ volatile("xgetbv" : "=a"(iLow), "=d"(iHigh) : "c"(0));
+    return static_cast<std::uint64_t>(iHigh) << 32 | iLow;
+#endif
+}
+
+static AesKernel DetectAesKernel()
+{
+    unsigned int regs[4];
+    GetCpuId(0, 0, regs);
+    const unsigned int iMaxLeaf = regs[0];
+
+    GetCpuId(1, 0, regs);
+    const bool bHasAesNi = (regs[2] & (1u << 25)) != 0;
+    const bool bHasOsXSave = (regs[2] & (1u << 27)) != 0;
+
+    if (bHasAesNi == false)
+    {
+        return AesKernel::None;
+    }
+
+    if (bHasOsXSave == true && iMaxLeaf >= 7)
+    {
+        GetCpuId(7, 0, regs);
+        const bool bHasAvx512F = (regs[1] & (1u << 16)) != 0;
+        const bool bHasVaes = (regs[2] & (1u << 9)) != 0;
+
+        // the SSE, AVX, opmask and ZMM states
+        constexpr const std::uint64_t AVX512_XSTATES = 0xE6;
+        const bool bOsSavesZmm =
+            (GetEnabledXStates() & AVX512_XSTATES) == AVX512_XSTATES;
+
+        if (bHasAvx512F == true && bHasVaes == true && bOsSavesZmm == true)
+        {
+            return AesKernel::Vaes512;
+        }
+    }
+
+    return AesKernel::AesNi;
+}
+
+// One step of the key schedule, keyWord is the key generation assist's
+// result with the wanted word in every lane
+UC2_TARGET_AESNI
+static __m128i ExpandAesKeyStep(__m128i key, __m128i keyWord)
+{
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, keyWord);
+}
+
+// the round constants must be immediates, so they can't be looped over
+#define UC2_AES_128_ROUND_KEY(i, rcon)                                     \
+    encKeys[i] = ExpandAesKeyStep(                                         \
+        encKeys[i - 1],                                                    \
+        _mm_shuffle_epi32(_mm_aeskeygenassist_si128(encKeys[i - 1], rcon), \
+                          0xFF))
+
+#define UC2_AES_256_ROUND_KEYS(i, rcon)                                    \
+    encKeys[i] = ExpandAesKeyStep(                                         \
+        encKeys[i - 2],                                                    \
+        _mm_shuffle_epi32(_mm_aeskeygenassist_si128(encKeys[i - 1], rcon), \
+                          0xFF));                                          \
+    encKeys[i + 1] = ExpandAesKeyStep(                                     \
+        encKeys[i - 1],                                                    \
+        _mm_shuffle_epi32(_mm_aeskeygenassist_si128(encKeys[i], 0), 0xAA))
+
+UC2_TARGET_AESNI
+static void ExpandAesKeysAesNi(const std::uint8_t* pKey,
+                               std::size_t iKeyLength,
+                               AesDecryptionKeys_t& outKeys)
+{
+    auto pKeyWords = reinterpret_cast<const __m128i*>(pKey);
+    __m128i encKeys[AES_MAX_ROUNDS + 1];
+    std::size_t iRounds;
+
+    if (iKeyLength == AES_128_KEY_LENGTH)
+    {
+        iRounds = AES_128_ROUNDS;
+
+        encKeys[0] = _mm_loadu_si128(pKeyWords);
+        UC2_AES_128_ROUND_KEY(1, 0x01);
+        UC2_AES_128_ROUND_KEY(2, 0x02);
+        UC2_AES_128_ROUND_KEY(3, 0x04);
+        UC2_AES_128_ROUND_KEY(4, 0x08);
+        UC2_AES_128_ROUND_KEY(5, 0x10);
+        UC2_AES_128_ROUND_KEY(6, 0x20);
+        UC2_AES_128_ROUND_KEY(7, 0x40);
+        UC2_AES_128_ROUND_KEY(8, 0x80);
+        UC2_AES_128_ROUND_KEY(9, 0x1B);
+        UC2_AES_128_ROUND_KEY(10, 0x36);
+    }
+    else
+    {
+        iRounds = AES_256_ROUNDS;
+
+        encKeys[0] = _mm_loadu_si128(pKeyWords);
+        encKeys[1] = _mm_loadu_si128(pKeyWords + 1);
+        UC2_AES_256_ROUND_KEYS(2, 0x01);
+        UC2_AES_256_ROUND_KEYS(4, 0x02);
+        UC2_AES_256_ROUND_KEYS(6, 0x04);
+        UC2_AES_256_ROUND_KEYS(8, 0x08);
+        UC2_AES_256_ROUND_KEYS(10, 0x10);
+        UC2_AES_256_ROUND_KEYS(12, 0x20);
+        // the last round only needs the first half of the step
+        encKeys[14] = ExpandAesKeyStep(
+            encKeys[12],
+            _mm_shuffle_epi32(_mm_aeskeygenassist_si128(encKeys[13], 0x40),
+                              0xFF));
+    }
+
+    // the equivalent inverse cipher uses the keys backwards, and the
+    // middle ones with InvMixColumns applied
+    auto pOutKeys = reinterpret_cast<__m128i*>(outKeys.Bytes.data());
+
+    _mm_storeu_si128(pOutKeys, encKeys[iRounds]);
+
+    for (std::size_t i = 1; i < iRounds; i++)
+    {
+        _mm_storeu_si128(pOutKeys + i, _mm_aesimc_si128(encKeys[iRounds - i]));
+    }
+
+    _mm_storeu_si128(pOutKeys + iRounds, encKeys[0]);
+
+    outKeys.iRounds = iRounds;
+}
+
+#undef UC2_AES_128_ROUND_KEY
+#undef UC2_AES_256_ROUND_KEYS
+
+UC2_TARGET_AESNI
+static void DecryptAesCbcAesNi(const AesDecryptionKeys_t& keys,
+                               const std::uint8_t* pIV,
+                               const std::uint8_t* pInData,
+                               std::uint8_t* pOutBuffer,
+                               std::size_t iBlocksNum)
+{
+    auto pKeys = reinterpret_cast<const __m128i*>(keys.Bytes.data());
+    auto pIn = reinterpret_cast<const __m128i*>(pInData);
+    auto pOut = reinterpret_cast<__m128i*>(pOutBuffer);
+    const std::size_t iRounds = keys.iRounds;
+
+    __m128i roundKeys[AES_MAX_ROUNDS + 1];
+
+    for (std::size_t r = 0; r <= iRounds; r++)
+    {
+        roundKeys[r] = _mm_loadu_si128(pKeys + r);
+    }
+
+    __m128i prevCipher = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIV));
+    std::size_t i = 0;
+
+    // every block only depends on its ciphertext and the previous one, so
+    // many blocks can go through the rounds at once
+    for (; i + AESNI_BLOCKS_PER_ITER <= iBlocksNum; i += AESNI_BLOCKS_PER_ITER)
+    {
+        __m128i cipher[AESNI_BLOCKS_PER_ITER];
+        __m128i state[AESNI_BLOCKS_PER_ITER];
+
+        // load every block before storing any, the buffers may be the same
+        UC2_UNROLL_LOOP
+        for (std::size_t j = 0; j < AESNI_BLOCKS_PER_ITER; j++)
+        {
+            cipher[j] = _mm_loadu_si128(pIn + i + j);
+            state[j] = _mm_xor_si128(cipher[j], roundKeys[0]);
+        }
+
+        for (std::size_t r = 1; r < iRounds; r++)
+        {
+            UC2_UNROLL_LOOP
+            for (std::size_t j = 0; j < AESNI_BLOCKS_PER_ITER; j++)
+            {
+                state[j] = _mm_aesdec_si128(state[j], roundKeys[r]);
+            }
+        }
+
+        UC2_UNROLL_LOOP
+        for (std::size_t j = 0; j < AESNI_BLOCKS_PER_ITER; j++)
+        {
+            state[j] = _mm_aesdeclast_si128(state[j], roundKeys[iRounds]);
+        }
+
+        _mm_storeu_si128(pOut + i, _mm_xor_si128(state[0], prevCipher));
+
+        UC2_UNROLL_LOOP
+        for (std::size_t j = 1; j < AESNI_BLOCKS_PER_ITER; j++)
+        {
+            _mm_storeu_si128(pOut + i + j,
+                             _mm_xor_si128(state[j], cipher[j - 1]));
+        }
+
+        prevCipher = cipher[AESNI_BLOCKS_PER_ITER - 1];
+    }
+
+    for (; i < iBlocksNum; i++)
+    {
+        const __m128i cipher = _mm_loadu_si128(pIn + i);
+        __m128i state = _mm_xor_si128(cipher, roundKeys[0]);
+
+        for (std::size_t r = 1; r < iRounds; r++)
+        {
+            state = _mm_aesdec_si128(state, roundKeys[r]);
+        }
+
+        state = _mm_aesdeclast_si128(state, roundKeys[iRounds]);
+        _mm_storeu_si128(pOut + i, _mm_xor_si128(state, prevCipher));
+
+        prevCipher = cipher;
+    }
+}
+
+// GCC 12 warns about the undefined registers some AVX-512 intrinsics use
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+UC2_TARGET_VAES512
+static void DecryptAesCbcVaes512(const AesDecryptionKeys_t& keys,
+                                 const std::uint8_t* pIV,
+                                 const std::uint8_t* pInData,
+                                 std::uint8_t* pOutBuffer,
+                                 std::size_t iBlocksNum)
+{
+    auto pKeys = reinterpret_cast<const __m128i*>(keys.Bytes.data());
+    const std::size_t iRounds = keys.iRounds;
+
+    // every 128 bits lane of a register holds a block
+    __m512i roundKeys[AES_MAX_ROUNDS + 1];
+
+    for (std::size_t r = 0; r <= iRounds; r++)
+    {
+        roundKeys[r] = _mm512_broadcast_i32x4(_mm_loadu_si128(pKeys + r));
+    }
+
+    __m128i prevCipher = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIV));
+    std::size_t i = 0;
+
+    for (; i + VAES512_BLOCKS_PER_ITER <= iBlocksNum;
+         i += VAES512_BLOCKS_PER_ITER)
+    {
+        __m512i cipher[VAES512_REGS_PER_ITER];
+        __m512i state[VAES512_REGS_PER_ITER];
+
+        UC2_UNROLL_LOOP
+        for (std::size_t j = 0; j < VAES512_REGS_PER_ITER; j++)
+        {
+            cipher[j] = _mm512_loadu_si512(pInData + (i + j * 4) * 16);
+            state[j] = _mm512_xor_si512(cipher[j], roundKeys[0]);
+        }
+
+        for (std::size_t r = 1; r < iRounds; r++)
+        {
+            UC2_UNROLL_LOOP
+            for (std::size_t j = 0; j < VAES512_REGS_PER_ITER; j++)
+            {
+                state[j] = _mm512_aesdec_epi128(state[j], roundKeys[r]);
+            }
+        }
+
+        UC2_UNROLL_LOOP
+        for (std::size_t j = 0; j < VAES512_REGS_PER_ITER; j++)
+        {
+            state[j] = _mm512_aesdeclast_epi128(state[j], roundKeys[iRounds]);
+        }
+
+        // each block is XORed with the ciphertext one lane before it, so
+        // shift the ciphertexts up by a lane (two 64 bits elements)
+        __m512i prevLanes = _mm512_alignr_epi64(
+            cipher[0], _mm512_broadcast_i32x4(prevCipher), 6);
+
+        UC2_UNROLL_LOOP
+        for (std::size_t j = 0; j < VAES512_REGS_PER_ITER; j++)
+        {
+            if (j != 0)
+            {
+                prevLanes = _mm512_alignr_epi64(cipher[j], cipher[j - 1], 6);
+            }
+
+            _mm512_storeu_si512(pOutBuffer + (i + j * 4) * 16,
+                                _mm512_xor_si512(state[j], prevLanes));
+        }
+
+        prevCipher = _mm512_extracti32x4_epi32(
+            cipher[VAES512_REGS_PER_ITER - 1], 3);
+    }
+
+    if (i < iBlocksNum)
+    {
+        std::uint8_t prevBlock[AES_BLOCK_SIZE];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(prevBlock), prevCipher);
+
+        DecryptAesCbcAesNi(keys, prevBlock, pInData + i * AES_BLOCK_SIZE,
+                           pOutBuffer + i * AES_BLOCK_SIZE, iBlocksNum - i);
+    }
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+AesKernel GetBestAesKernel()
+{
+#ifdef UC2_AES_KERNELS_X86
+    static const AesKernel bestKernel = DetectAesKernel();
+    return bestKernel;
+#else
+    return AesKernel::None;
+#endif
+}
+
+bool ExpandAesDecryptionKeys([[maybe_unused]] const std::uint8_t* pKey,
+                             [[maybe_unused]] std::size_t iKeyLength,
+                             [[maybe_unused]] AesDecryptionKeys_t& outKeys)
+{
+#ifdef UC2_AES_KERNELS_X86
+    if (GetBestAesKernel() == AesKernel::None)
+    {
+        return false;
+    }
+
+    if (iKeyLength != AES_128_KEY_LENGTH && iKeyLength != AES_256_KEY_LENGTH)
+    {
+        return false;
+    }
+
+    ExpandAesKeysAesNi(pKey, iKeyLength, outKeys);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void DecryptAesCbc(AesKernel kernel,
+                   [[maybe_unused]] const AesDecryptionKeys_t& keys,
+                   [[maybe_unused]] const std::uint8_t* pIV,
+                   [[maybe_unused]] const std::uint8_t* pInData,
+                   [[maybe_unused]] std::uint8_t* pOutBuffer,
+                   [[maybe_unused]] std::size_t iBlocksNum)
+{
+    switch (kernel)
+    {
+#ifdef UC2_AES_KERNELS_X86
+        case AesKernel::AesNi:
+            DecryptAesCbcAesNi(keys, pIV, pInData, pOutBuffer, iBlocksNum);
+            return;
+        case AesKernel::Vaes512:
+            DecryptAesCbcVaes512(keys, pIV, pInData, pOutBuffer, iBlocksNum);
+            return;
+#endif
+        default:
+            throw std::invalid_argument("libuncso2: Invalid AES kernel used");
+    }
+}
+}  // namespace uc2
@@ -0,0 +1,120 @@
+#include "ciphers/basecipher.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace uc2
+{
+void IBaseCipher::SetIV(std::string_view iv)
+{
+    this->m_IV.fill(0);
+    std::copy_n(iv.begin(), std::min(iv.size(), this->m_IV.size()),
+                this->m_IV.begin());
+}
+
+void IBaseCipher::ValidateBuffers(gsl::span<const std::uint8_t> inData,
+                                  gsl::span<std::uint8_t> outBuffer,
+                                  std::size_t iBlockSize)
+{
+    if (inData.size_bytes() % iBlockSize != 0)
+    {
+        throw std::length_error("libuncso2: The encrypted data's size must be "
+                                "a multiple of the cipher's block size");
+    }
+
+    if (outBuffer.size_bytes() < inData.size_bytes())
+    {
+        throw std::length_error(
+            "libuncso2: The output buffer is smaller than the encrypted data");
+    }
+}
+
+std::uint64_t IBaseCipher::DecryptRecords(gsl::span<const std::uint8_t> inData,
+                                          gsl::span<std::uint8_t> outBuffer,
+                                          std::size_t iRecordSize)
+{
+    const std::size_t iBlockSize = this->GetBlockSize();
+
+    if (this->m_bPaddingEnabled == true)
+    {
+        throw std::invalid_argument(
+            "libuncso2: Records cannot be decrypted with padding enabled");
+    }
+
+    if (iRecordSize == 0 || iRecordSize % iBlockSize != 0 ||
+        inData.size_bytes() % iRecordSize != 0)
+    {
+        throw std::length_error("libuncso2: The records' size must be a "
+                                "multiple of the cipher's block size");
+    }
+
+    IBaseCipher::ValidateBuffers(inData, outBuffer, iBlockSize);
+
+    const std::size_t iRecordsNum = inData.size_bytes() / iRecordSize;
+
+    if (iRecordsNum == 0)
+    {
+        return 0;
+    }
+
+    // Decrypting every record in one go chains each record's first block to
+    // the previous record's last ciphertext block instead of the IV. Keep
+    // those blocks around (the buffers may overlap) to undo it afterwards.
+    std::vector<std::uint8_t> vChainBlocks((iRecordsNum - 1) * iBlockSize);
+
+    for (std::size_t i = 1; i < iRecordsNum; i++)
+    {
+        auto lastBlock =
+            inData.subspan(i * iRecordSize - iBlockSize, iBlockSize);
+        std::copy(lastBlock.begin(), lastBlock.end(),
+                  vChainBlocks.begin() + (i - 1) * iBlockSize);
+    }
+
+    this->Decrypt(inData, outBuffer);
+
+    for (std::size_t i = 1; i < iRecordsNum; i++)
+    {
+        std::uint8_t* pFirstBlock = outBuffer.data() + i * iRecordSize;
+        const std::uint8_t* pChainBlock =
+            vChainBlocks.data() + (i - 1) * iBlockSize;
+
+        for (std::size_t j = 0; j < iBlockSize; j++)
+        {
+            pFirstBlock[j] ^= pChainBlock[j] ^ this->m_IV[j];
+        }
+    }
+
+    return inData.size_bytes();
+}
+
+std::uint64_t IBaseCipher::GetUnpaddedLength(
+    gsl::span<const std::uint8_t> decryptedData, std::size_t iBlockSize)
+{
+    const std::uint64_t iDataLength = decryptedData.size_bytes();
+
+    if (iDataLength == 0)
+    {
+        throw std::runtime_error(
+            "libuncso2: Cannot remove the padding of empty data");
+    }
+
+    const std::uint8_t iPadLength = decryptedData[iDataLength - 1];
+
+    if (iPadLength == 0 || iPadLength > iBlockSize ||
+        iPadLength > iDataLength)
+    {
+        throw std::runtime_error("libuncso2: Invalid block padding found");
+    }
+
+    for (std::uint64_t i = iDataLength - iPadLength; i < iDataLength; i++)
+    {
+        if (decryptedData[i] != iPadLength)
+        {
+            throw std::runtime_error("libuncso2: Invalid block padding found");
+        }
+    }
+
+    return iDataLength - iPadLength;
+}
+}  // namespace uc2
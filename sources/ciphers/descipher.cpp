@@ -1,8 +1,6 @@
 #include "ciphers/descipher.hpp"
 
-#include <des.h>
-#include <filters.h>
-#include <modes.h>
+#include "statsimpl.hpp"
 
 namespace uc2
 {
@@ -13,32 +11,44 @@ CDesCipher::~CDesCipher() {}
 void CDesCipher::Initialize(std::string_view key, std::string_view iv,
                             bool paddingEnabled /*= false*/)
 {
-    this->m_szvKey = key;
-    this->m_szvIV = iv;
+    this->SetIV(iv);
     this->m_bPaddingEnabled = paddingEnabled;
+
+    this->m_Decryption.SetKeyWithIV(
+        reinterpret_cast<const std::uint8_t*>(key.data()), key.length() / 2,
+        this->m_IV.data());
 }
 
 std::uint64_t CDesCipher::Decrypt(gsl::span<const std::uint8_t> inData,
                                   gsl::span<std::uint8_t> outBuffer)
 {
-    CryptoPP::CBC_Mode<CryptoPP::DES>::Decryption dec;
+    constexpr const std::size_t iBlockSize = CryptoPP::DES::BLOCKSIZE;
+
+    IBaseCipher::ValidateBuffers(inData, outBuffer, iBlockSize);
 
-    dec.SetKeyWithIV(
-        reinterpret_cast<const std::uint8_t*>(this->m_szvKey.data()),
-        this->m_szvKey.length() / 2,
-        reinterpret_cast<const std::uint8_t*>(this->m_szvIV.data()));
+    if (inData.empty() == true)
+    {
+        return 0;
+    }
 
-    auto scheme = this->m_bPaddingEnabled ?
-                      CryptoPP::BlockPaddingSchemeDef::DEFAULT_PADDING :
-                      CryptoPP::BlockPaddingSchemeDef::NO_PADDING;
+    AddStat(StatsCounter::DesBytesDecrypted, inData.size_bytes());
+    AddStat(StatsCounter::BlocksDecrypted, inData.size_bytes() / iBlockSize);
 
-    auto sink =
-        new CryptoPP::ArraySink(outBuffer.data(), outBuffer.size_bytes());
-    auto filter = new CryptoPP::StreamTransformationFilter(dec, sink, scheme);
+    this->m_Decryption.Resynchronize(this->m_IV.data());
+    this->m_Decryption.ProcessData(outBuffer.data(), inData.data(),
+                                   inData.size_bytes());
 
-    CryptoPP::StringSource source(inData.data(), inData.size_bytes(), true,
-                                  filter);
+    if (this->m_bPaddingEnabled == true)
+    {
+        return IBaseCipher::GetUnpaddedLength(
+            outBuffer.first(inData.size_bytes()), iBlockSize);
+    }
 
-    return sink->TotalPutLength();
+    return inData.size_bytes();
+}
+
+std::size_t CDesCipher::GetBlockSize() const
+{
+    return CryptoPP::DES::BLOCKSIZE;
 }
 }  // namespace uc2
@@ -9,6 +9,7 @@
 #include "ciphers/basecipher.hpp"
 #include "ciphers/blowfishcipher.hpp"
 #include "ciphers/descipher.hpp"
+#include "statsimpl.hpp"
 
 namespace uc2
 {
@@ -60,6 +61,8 @@ CDecryptor::CDecryptor(IBaseCipher* cipher,
 void CDecryptor::Initialize(std::string_view key, std::string_view iv,
                             bool paddingEnabled)
 {
+    CStatsTimer timer(StatsCounter::DecryptNs);
+
     if (iv.empty() == true)
     {
         constexpr std::string_view szvNullIv = {
@@ -81,6 +84,8 @@ std::vector<std::uint8_t> CDecryptor::Decrypt(
 std::size_t CDecryptor::Decrypt(const void* pStart, void* pOutBuffer,
                                 const std::size_t iLength) const
 {
+    CStatsTimer timer(StatsCounter::DecryptNs);
+
     gsl::span<const std::uint8_t> inData(
         static_cast<const std::uint8_t*>(pStart), iLength);
     gsl::span<std::uint8_t> outData(static_cast<std::uint8_t*>(pOutBuffer),
@@ -91,6 +96,8 @@ std::size_t CDecryptor::Decrypt(const void* pStart, void* pOutBuffer,
 std::size_t CDecryptor::DecryptInBuffer(void* pBuffer,
                                         const std::size_t iLength) const
 {
+    CStatsTimer timer(StatsCounter::DecryptNs);
+
     gsl::span<const std::uint8_t> inData(
         static_cast<const std::uint8_t*>(pBuffer), iLength);
     gsl::span<std::uint8_t> outData(static_cast<std::uint8_t*>(pBuffer),
@@ -98,9 +105,26 @@ std::size_t CDecryptor::DecryptInBuffer(void* pBuffer,
     return this->m_pCipher->Decrypt(inData, outData);
 }
 
+std::size_t CDecryptor::DecryptRecordsInBuffer(
+    void* pBuffer, const std::size_t iRecordSize,
+    const std::size_t iRecordsNum) const
+{
+    CStatsTimer timer(StatsCounter::DecryptNs);
+
+    const std::size_t iLength = iRecordSize * iRecordsNum;
+
+    gsl::span<const std::uint8_t> inData(
+        static_cast<const std::uint8_t*>(pBuffer), iLength);
+    gsl::span<std::uint8_t> outData(static_cast<std::uint8_t*>(pBuffer),
+                                    iLength);
+    return this->m_pCipher->DecryptRecords(inData, outData, iRecordSize);
+}
+
 std::vector<std::uint8_t> CDecryptor::Decrypt(const void* pStart,
                                               const std::size_t iLength) const
 {
+    CStatsTimer timer(StatsCounter::DecryptNs);
+
     std::vector<std::uint8_t> vOutData(iLength);
 
     gsl::span<const std::uint8_t> inData(
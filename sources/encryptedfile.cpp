@@ -141,4 +141,33 @@ std::pair<std::uint8_t*, std::size_t> EncryptedFileImpl::Decrypt()
 
     return { pDataStart, iNewDataSize };
 }
+
+std::size_t EncryptedFileImpl::DecryptTo(std::uint8_t* pOutBuffer,
+                                         const std::uint64_t iOutBufferSize)
+{
+    auto pHeader = AddOffsetToBase<const EncryptedFileHeader_t>(
+        this->m_FileDataView.data());
+
+    if (pOutBuffer == nullptr || iOutBufferSize < pHeader->fileSize)
+    {
+        throw std::length_error("libuncso2: The output buffer is smaller than "
+                                "the encrypted data");
+    }
+
+    std::vector<std::uint8_t> digestedKey = GeneratePkgIndexKey(
+        pHeader->flag, this->m_szvFileName, this->m_KeyCollectionView);
+
+    auto pDataStart = AddOffsetToBase<const std::uint8_t>(
+        this->m_FileDataView.data(), sizeof(EncryptedFileHeader_t));
+
+    auto pCipher = CreateIndexCipher(pHeader->cipher);
+    CDecryptor decryptor(pCipher.get(), digestedKey);
+
+    std::size_t iNewDataSize =
+        decryptor.Decrypt(pDataStart, pOutBuffer, pHeader->fileSize);
+
+    assert(iNewDataSize <= pHeader->fileSize);
+
+    return iNewDataSize;
+}
 }  // namespace uc2
@@ -0,0 +1,306 @@
+#include "encryptedtableimpl.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+// strtod_l and its locales
+#include <locale.h>
+#include <stdlib.h>
+#ifdef __APPLE__
+#include <xlocale.h>
+#endif
+
+#include "encryptedfile.hpp"
+
+namespace uc2
+{
+constexpr const std::string_view UTF8_BOM("\xEF\xBB\xBF", 3);
+
+// The "C" locale, so numbers are parsed the same whatever the host
+// application's locale is. It's never freed.
+#ifdef _WIN32
+static _locale_t GetClassicLocale()
+{
+    static const _locale_t classicLocale = _create_locale(LC_ALL, "C");
+    return classicLocale;
+}
+#else
+static locale_t GetClassicLocale()
+{
+    static const locale_t classicLocale =
+        newlocale(LC_ALL_MASK, "C", static_cast<locale_t>(0));
+    return classicLocale;
+}
+#endif
+
+// Parses a whole cell with strtod in the "C" locale. Throws
+// std::invalid_argument if it isn't a number, or if it's too big for a
+// double. Numbers too small for one are rounded.
+static double ParseClassicDouble(std::string_view szvCell)
+{
+    // strtod needs a null terminated string, the cells are not
+    std::array<char, 64> szSmallCell;
+    std::string szBigCell;
+    const char* szCell;
+
+    if (szvCell.length() < szSmallCell.size())
+    {
+        std::copy(szvCell.begin(), szvCell.end(), szSmallCell.begin());
+        szSmallCell[szvCell.length()] = '\0';
+        szCell = szSmallCell.data();
+    }
+    else
+    {
+        szBigCell = szvCell;
+        szCell = szBigCell.c_str();
+    }
+
+    char* pParsedEnd;
+    errno = 0;
+
+#ifdef _WIN32
+    const double fValue = _strtod_l(szCell, &pParsedEnd, GetClassicLocale());
+#else
+    const double fValue = strtod_l(szCell, &pParsedEnd, GetClassicLocale());
+#endif
+
+    const bool bOverflowed =
+        errno == ERANGE && (fValue == HUGE_VAL || fValue == -HUGE_VAL);
+
+    if (bOverflowed == true || pParsedEnd != szCell + szvCell.length())
+    {
+        throw std::invalid_argument("libuncso2: The cell is not a number");
+    }
+
+    return fValue;
+}
+
+EncryptedTable::ptr_t EncryptedTable::Create(EncryptedFile& file,
+                                             char cDelimiter /*= ','*/)
+{
+    auto [pData, iDataSize] = file.Decrypt();
+    std::string_view szvText(reinterpret_cast<const char*>(pData), iDataSize);
+    return std::make_unique<EncryptedTableImpl>(szvText, cDelimiter);
+}
+
+EncryptedTable::ptr_t EncryptedTable::Create(std::string_view szvText,
+                                             char cDelimiter /*= ','*/)
+{
+    return std::make_unique<EncryptedTableImpl>(szvText, cDelimiter);
+}
+
+EncryptedTableImpl::EncryptedTableImpl(std::string_view szvText,
+                                       char cDelimiter)
+{
+    this->Parse(szvText, cDelimiter);
+}
+
+EncryptedTableImpl::~EncryptedTableImpl() {}
+
+void EncryptedTableImpl::Parse(std::string_view szvText, char cDelimiter)
+{
+    if (szvText.substr(0, UTF8_BOM.length()) == UTF8_BOM)
+    {
+        szvText.remove_prefix(UTF8_BOM.length());
+    }
+
+    // every line and every delimiter adds at most one row and one cell, so
+    // counting them first allocates both vectors only once
+    const std::size_t iLinesNum =
+        std::count(szvText.begin(), szvText.end(), '\n') + 1;
+    const std::size_t iDelimitersNum =
+        std::count(szvText.begin(), szvText.end(), cDelimiter);
+
+    this->m_vCells.reserve(iLinesNum + iDelimitersNum);
+    this->m_vRowStarts.reserve(iLinesNum + 1);
+    this->m_vRowStarts.push_back(0);
+
+    const char* pCur = szvText.data();
+    const char* const pEnd = pCur + szvText.length();
+
+    while (pCur != pEnd)
+    {
+        const char* pCellStart = pCur;
+        const char* pCellEnd;
+
+        if (*pCur == '"')
+        {
+            pCellStart = ++pCur;
+
+            // a doubled quote does not close the cell
+            while (pCur != pEnd &&
+                   (*pCur != '"' || (pCur + 1 != pEnd && pCur[1] == '"')))
+            {
+                pCur += *pCur == '"' ? 2 : 1;
+            }
+
+            pCellEnd = pCur;
+
+            // skip the closing quote, and anything after it up to the next
+            // delimiter or line break
+            while (pCur != pEnd && *pCur != cDelimiter && *pCur != '\n')
+            {
+                pCur++;
+            }
+        }
+        else
+        {
+            while (pCur != pEnd && *pCur != cDelimiter && *pCur != '\n')
+            {
+                pCur++;
+            }
+
+            pCellEnd = pCur;
+
+            if (pCellEnd != pCellStart && pCellEnd[-1] == '\r')
+            {
+                pCellEnd--;
+            }
+        }
+
+        this->m_vCells.emplace_back(pCellStart, pCellEnd - pCellStart);
+
+        if (pCur == pEnd)
+        {
+            break;
+        }
+
+        if (*pCur++ == '\n')
+        {
+            this->EndRow();
+        }
+        else if (pCur == pEnd)
+        {
+            // the text ends with a delimiter, so the last cell is empty
+            this->m_vCells.emplace_back();
+        }
+    }
+
+    this->EndRow();
+}
+
+void EncryptedTableImpl::EndRow()
+{
+    const std::size_t iRowStart = this->m_vRowStarts.back();
+    const std::size_t iRowEnd = this->m_vCells.size();
+
+    // an empty line has a single empty cell, drop it
+    if (iRowEnd - iRowStart == 1 && this->m_vCells.back().empty() == true)
+    {
+        this->m_vCells.pop_back();
+        return;
+    }
+
+    if (iRowEnd != iRowStart)
+    {
+        this->m_vRowStarts.push_back(iRowEnd);
+    }
+}
+
+std::uint64_t EncryptedTableImpl::GetRowsNum()
+{
+    return this->m_vRowStarts.size() - 1;
+}
+
+std::uint64_t EncryptedTableImpl::GetColumnsNum(std::uint64_t iRow)
+{
+    if (iRow >= this->GetRowsNum())
+    {
+        throw std::out_of_range("libuncso2: The row index is out of range");
+    }
+
+    return this->m_vRowStarts[iRow + 1] - this->m_vRowStarts[iRow];
+}
+
+std::string_view EncryptedTableImpl::GetCell(std::uint64_t iRow,
+                                             std::uint64_t iColumn)
+{
+    if (iColumn >= this->GetColumnsNum(iRow))
+    {
+        throw std::out_of_range("libuncso2: The column index is out of range");
+    }
+
+    return this->m_vCells[this->m_vRowStarts[iRow] + iColumn];
+}
+
+std::int64_t EncryptedTableImpl::GetCellInteger(std::uint64_t iRow,
+                                                std::uint64_t iColumn)
+{
+    const std::string_view szvCell = this->GetCell(iRow, iColumn);
+    const char* pCellEnd = szvCell.data() + szvCell.length();
+
+    std::int64_t iValue;
+    auto [pParsedEnd, err] =
+        std::from_chars(szvCell.data(), pCellEnd, iValue);
+
+    if (err != std::errc() || pParsedEnd != pCellEnd)
+    {
+        throw std::invalid_argument("libuncso2: The cell is not an integer");
+    }
+
+    return iValue;
+}
+
+double EncryptedTableImpl::GetCellFloat(std::uint64_t iRow,
+                                        std::uint64_t iColumn)
+{
+    const std::string_view szvCell = this->GetCell(iRow, iColumn);
+
+    // like from_chars, which older standard libraries lack for floating
+    // point numbers, don't allow whitespace, plus signs or hex numbers
+    if (szvCell.empty() == true || szvCell.front() == '+' ||
+        std::isspace(static_cast<unsigned char>(szvCell.front())) != 0 ||
+        szvCell.find_first_of("xX") != std::string_view::npos)
+    {
+        throw std::invalid_argument("libuncso2: The cell is not a number");
+    }
+
+#ifdef __cpp_lib_to_chars
+    const char* pCellEnd = szvCell.data() + szvCell.length();
+
+    double fValue;
+    auto [pParsedEnd, err] =
+        std::from_chars(szvCell.data(), pCellEnd, fValue);
+
+    if (err == std::errc() && pParsedEnd == pCellEnd)
+    {
+        return fValue;
+    }
+
+    // from_chars doesn't tell underflows, which are fine, from overflows
+    if (err != std::errc::result_out_of_range)
+    {
+        throw std::invalid_argument("libuncso2: The cell is not a number");
+    }
+#endif
+
+    return ParseClassicDouble(szvCell);
+}
+
+std::uint64_t EncryptedTableImpl::FindColumn(std::string_view szvName)
+{
+    if (this->GetRowsNum() == 0)
+    {
+        return COLUMN_NOT_FOUND;
+    }
+
+    const std::uint64_t iColumnsNum = this->GetColumnsNum(0);
+
+    for (std::uint64_t i = 0; i < iColumnsNum; i++)
+    {
+        if (this->m_vCells[i] == szvName)
+        {
+            return i;
+        }
+    }
+
+    return COLUMN_NOT_FOUND;
+}
+}  // namespace uc2
@@ -1,17 +1,61 @@
 #include "keyhashes.hpp"
 
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 
-#include <hex.h>
 #include <md5.h>
 
+#include "statsimpl.hpp"
+
 namespace uc2
 {
+// how many derived keys GetCachedPkgFileKeyHex remembers before starting over
+constexpr const std::size_t PKG_FILE_KEY_CACHE_MAX_SIZE = 0x40000;
+
+struct CachedPkgFileKey_t
+{
+    std::string szPkgName;
+    std::string szKey;
+    PkgFileKeyHex_t KeyHex;
+};
+
+static std::mutex g_PkgFileKeyCacheMutex;
+static std::unordered_map<std::uint64_t, CachedPkgFileKey_t>
+    g_PkgFileKeyCache;
+
+static std::uint64_t HashPkgFileKeyPair(std::string_view szvPkgName,
+                                        std::string_view szKey)
+{
+    // 64 bits FNV-1a over the key, a separator and the name
+    constexpr const std::uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325;
+    constexpr const std::uint64_t FNV_PRIME = 0x100000001b3;
+
+    std::uint64_t iHash = FNV_OFFSET_BASIS;
+
+    auto hashBytes = [&iHash](std::string_view szvBytes) {
+        for (const char c : szvBytes)
+        {
+            iHash ^= static_cast<std::uint8_t>(c);
+            iHash *= FNV_PRIME;
+        }
+    };
+
+    hashBytes(szKey);
+    hashBytes({ "", 1 });
+    hashBytes(szvPkgName);
+
+    return iHash;
+}
+
 std::vector<std::uint8_t> GeneratePkgIndexKey(
     int iKey, std::string_view szPkgName,
     gsl::span<const std::uint8_t[4][16]> keyCollectionView)
 {
+    CStatsTimer timer(StatsCounter::KeyDerivationNs);
+    AddStat(StatsCounter::KeysDerived, 1);
+
     constexpr const std::uint32_t iVersion = 2;
     static_assert(sizeof(iVersion) == 4, "iVersion's size must be 4 bytes");
 
@@ -49,10 +93,20 @@ std::vector<std::uint8_t> GeneratePkgIndexKey(
 
 std::string GeneratePkgFileKey(std::string_view szvPkgName,
                                std::string_view szKey)
+{
+    const PkgFileKeyHex_t keyHex = GeneratePkgFileKeyHex(szvPkgName, szKey);
+    return std::string(keyHex.data(), keyHex.size());
+}
+
+PkgFileKeyHex_t GeneratePkgFileKeyHex(std::string_view szvPkgName,
+                                      std::string_view szKey)
 {
     if (szvPkgName.empty())
         throw std::invalid_argument("libuncso2: The pkg name cannot be empty");
 
+    CStatsTimer timer(StatsCounter::KeyDerivationNs);
+    AddStat(StatsCounter::KeysDerived, 1);
+
     CryptoPP::Weak::MD5 hash;
 
     if (szKey.empty() == false)
@@ -65,11 +119,53 @@ std::string GeneratePkgFileKey(std::string_view szvPkgName,
     std::array<std::uint8_t, CryptoPP::Weak::MD5::DIGESTSIZE> digestedKey;
     hash.Final(digestedKey.data());
 
-    std::string szOutHash;
-    CryptoPP::HexEncoder encoder(new CryptoPP::StringSink(szOutHash), false);
-    encoder.Put(digestedKey.data(), digestedKey.size());
-    encoder.MessageEnd();
+    static_assert(sizeof(PkgFileKeyHex_t) == digestedKey.size() * 2,
+                  "The hex key must hold two characters per digest byte");
+
+    constexpr const char szHexDigits[] = "0123456789abcdef";
+
+    PkgFileKeyHex_t outHex;
+
+    for (std::size_t i = 0; i < digestedKey.size(); i++)
+    {
+        outHex[i * 2] = szHexDigits[digestedKey[i] >> 4];
+        outHex[i * 2 + 1] = szHexDigits[digestedKey[i] & 0xF];
+    }
+
+    return outHex;
+}
+
+PkgFileKeyHex_t GetCachedPkgFileKeyHex(std::string_view szvPkgName,
+                                       std::string_view szKey)
+{
+    const std::uint64_t iHash = HashPkgFileKeyPair(szvPkgName, szKey);
+
+    {
+        std::lock_guard<std::mutex> lock(g_PkgFileKeyCacheMutex);
+
+        auto it = g_PkgFileKeyCache.find(iHash);
+
+        if (it != g_PkgFileKeyCache.end() &&
+            it->second.szPkgName == szvPkgName && it->second.szKey == szKey)
+        {
+            return it->second.KeyHex;
+        }
+    }
+
+    // derive the key without holding the lock
+    const PkgFileKeyHex_t keyHex = GeneratePkgFileKeyHex(szvPkgName, szKey);
+
+    std::lock_guard<std::mutex> lock(g_PkgFileKeyCacheMutex);
+
+    if (g_PkgFileKeyCache.size() >= PKG_FILE_KEY_CACHE_MAX_SIZE)
+    {
+        g_PkgFileKeyCache.clear();
+    }
+
+    // on a hash collision, the newest pair takes the slot
+    g_PkgFileKeyCache[iHash] = CachedPkgFileKey_t{ std::string(szvPkgName),
+                                                   std::string(szKey), keyHex };
 
-    return szOutHash;
+    return keyHex;
 }
 }  // namespace uc2
\ No newline at end of file
@@ -16,7 +16,10 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <cstddef>
+#include <cstdlib>
 #include <memory>
+#include <vector>
 
 #include <7zTypes.h>
 #include <LzmaDec.h>
@@ -25,6 +28,7 @@
 // CLzmaDec in the header.
 #define CLzmaDec_t CLzmaDec
 #include "lzmaDecoder.h"
+#include "statsimpl.hpp"
 
 // Allocator to pass to LZMA functions
 static void* SzAlloc(ISzAllocPtr p, std::size_t size)
@@ -37,6 +41,119 @@ static void SzFree(ISzAllocPtr p, void* address)
 }
 static ISzAlloc g_Alloc = { SzAlloc, SzFree };
 
+//-----------------------------------------------------------------------------
+// An allocator that keeps the blocks freed by the LZMA decoder and hands them
+// out again, so decoding many chunks doesn't go through malloc every time.
+// It's not thread safe, each thread must use its own.
+//-----------------------------------------------------------------------------
+class CLzmaBlockCache
+{
+public:
+    CLzmaBlockCache()
+    {
+        m_Alloc.Interface.Alloc = &CLzmaBlockCache::Alloc;
+        m_Alloc.Interface.Free = &CLzmaBlockCache::Free;
+        m_Alloc.pCache = this;
+    }
+
+    ~CLzmaBlockCache()
+    {
+        for (void* pBlock : m_FreeBlocks)
+        {
+            free(pBlock);
+        }
+    }
+
+    ISzAllocPtr GetAlloc() const { return &m_Alloc.Interface; }
+
+private:
+    // LZMA only passes the interface around, keep the cache next to it
+    struct AllocHandle_t
+    {
+        ISzAlloc Interface;
+        CLzmaBlockCache* pCache;
+    };
+
+    // every block starts with its size, so it can be matched when it's freed
+    struct BlockHeader_t
+    {
+        alignas(std::max_align_t) std::size_t iSize;
+    };
+
+    static constexpr const std::size_t MAX_FREE_BLOCKS = 8;
+
+    static void* Alloc(ISzAllocPtr p, std::size_t size)
+    {
+        auto pThis = reinterpret_cast<const AllocHandle_t*>(p)->pCache;
+
+        for (auto it = pThis->m_FreeBlocks.begin();
+             it != pThis->m_FreeBlocks.end(); ++it)
+        {
+            auto pHeader = static_cast<BlockHeader_t*>(*it);
+
+            // don't waste a big block in a small request
+            if (pHeader->iSize >= size && pHeader->iSize / 2 <= size)
+            {
+                pThis->m_FreeBlocks.erase(it);
+                return pHeader + 1;
+            }
+        }
+
+        auto pHeader = static_cast<BlockHeader_t*>(
+            malloc(sizeof(BlockHeader_t) + size));
+
+        if (pHeader == NULL)
+        {
+            return NULL;
+        }
+
+        pHeader->iSize = size;
+        return pHeader + 1;
+    }
+
+    static void Free(ISzAllocPtr p, void* address)
+    {
+        if (address == NULL)
+        {
+            return;
+        }
+
+        auto pThis = reinterpret_cast<const AllocHandle_t*>(p)->pCache;
+        auto pHeader = static_cast<BlockHeader_t*>(address) - 1;
+
+        if (pThis->m_FreeBlocks.size() == MAX_FREE_BLOCKS)
+        {
+            free(pThis->m_FreeBlocks.front());
+            pThis->m_FreeBlocks.erase(pThis->m_FreeBlocks.begin());
+        }
+
+        pThis->m_FreeBlocks.push_back(pHeader);
+    }
+
+private:
+    AllocHandle_t m_Alloc;
+    std::vector<void*> m_FreeBlocks;
+};
+
+//-----------------------------------------------------------------------------
+// The decoder state used by CLZMA::Uncompress in a thread. Its probability
+// tables are kept between calls, and only reallocated when a stream needs a
+// different number of them.
+//-----------------------------------------------------------------------------
+struct LzmaThreadDecoder_t
+{
+    LzmaThreadDecoder_t() { LzmaDec_Construct(&State); }
+    ~LzmaThreadDecoder_t()
+    {
+        LzmaDec_FreeProbs(&State, BlockCache.GetAlloc());
+    }
+
+    CLzmaBlockCache BlockCache;
+    CLzmaDec State;
+};
+
+static thread_local LzmaThreadDecoder_t g_ThreadDecoder;
+
 //-----------------------------------------------------------------------------
 // Returns true if buffer is compressed.
 //-----------------------------------------------------------------------------
@@ -84,33 +201,49 @@ unsigned int CLZMA::Uncompress(unsigned char* pInput, unsigned char* pOutput)
         return false;
     }
 
-    CLzmaDec state;
+    uc2::CStatsTimer timer(uc2::StatsCounter::LzmaNs);
 
-    LzmaDec_Construct(&state);
+    LzmaThreadDecoder_t& decoder = g_ThreadDecoder;
 
-    if (LzmaDec_Allocate(&state, pHeader->properties, LZMA_PROPS_SIZE,
-                         &g_Alloc) != SZ_OK)
+    // only the probability tables are needed, the output is the dictionary
+    if (LzmaDec_AllocateProbs(&decoder.State, pHeader->properties,
+                              LZMA_PROPS_SIZE,
+                              decoder.BlockCache.GetAlloc()) != SZ_OK)
     {
         assert(false);
         return 0;
     }
 
-    // These are in/out variables
-    SizeT outProcessed = pHeader->actualSize;
+    decoder.State.dic = (Byte*)pOutput;
+    decoder.State.dicBufSize = pHeader->actualSize;
+    LzmaDec_Init(&decoder.State);
+
+    // This is an in/out variable
     SizeT inProcessed = pHeader->lzmaSize;
     ELzmaStatus status;
-    SRes result = LzmaDecode(
-        (Byte*)pOutput, &outProcessed, (Byte*)(pInput + sizeof(lzma_header_t)),
-        &inProcessed, (Byte*)pHeader->properties, LZMA_PROPS_SIZE,
-        LZMA_FINISH_END, &status, &g_Alloc);
+    SRes result = LzmaDec_DecodeToDic(
+        &decoder.State, pHeader->actualSize,
+        (Byte*)(pInput + sizeof(lzma_header_t)), &inProcessed,
+        LZMA_FINISH_END, &status);
+
+    SizeT outProcessed = decoder.State.dicPos;
+
+    // don't keep the caller's buffer around
+    decoder.State.dic = NULL;
+    decoder.State.dicBufSize = 0;
 
-    LzmaDec_Free(&state, &g_Alloc);
+    if (result == SZ_OK && status == LZMA_STATUS_NEEDS_MORE_INPUT)
+    {
+        result = SZ_ERROR_INPUT_EOF;
+    }
 
     if (result != SZ_OK || pHeader->actualSize != outProcessed)
     {
         return 0;
     }
 
+    uc2::AddStat(uc2::StatsCounter::LzmaChunksDecoded, 1);
+
     return outProcessed;
 }
 
@@ -131,6 +264,7 @@ void CLZMAStream::FreeDecoderState()
     if (m_pDecoderState)
     {
         LzmaDec_Free(m_pDecoderState, &g_Alloc);
+        delete m_pDecoderState;
         m_pDecoderState = NULL;
     }
 }
@@ -150,6 +284,7 @@ bool CLZMAStream::CreateDecoderState(const unsigned char* pProperties)
                          &g_Alloc) != SZ_OK)
     {
         assert(!"Failed to allocate lzma decoder state");
+        delete m_pDecoderState;
         m_pDecoderState = NULL;
         return false;
     }
@@ -1,12 +1,45 @@
 #include "lzmatextureimpl.hpp"
 
 #include <assert.h>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
 
 #include "lzmaDecoder.h"
+#include "pkg/pkgstructures.hpp"
+#include "pkgentry.hpp"
+#include "threadpool.hpp"
+#include "traceimpl.hpp"
 
 namespace uc2
 {
+// Calls fn for every chunk index with up to iThreadsNum threads. The
+// threads come from a pool shared by every texture, with one thread per CPU
+// core, so they aren't spawned again on each call. The pool is never
+// destroyed, as joining its threads at exit can deadlock while the library
+// is being unloaded on Windows.
+static void ForEachChunk(std::size_t iChunksNum, std::uint32_t iThreadsNum,
+                         const std::function<void(std::size_t)>& fn)
+{
+    if (iThreadsNum <= 1)
+    {
+        for (std::size_t i = 0; i < iChunksNum; i++)
+        {
+            fn(i);
+        }
+
+        return;
+    }
+
+    static CThreadPool* pPool =
+        new CThreadPool(std::max(std::thread::hardware_concurrency(), 1u));
+
+    pPool->ParallelFor(iChunksNum, iThreadsNum, fn);
+}
+
 LzmaTexture::ptr_t LzmaTexture::Create(std::vector<std::uint8_t>& texData)
 {
     return std::make_unique<LzmaTextureImpl>(texData);
@@ -19,8 +52,13 @@ LzmaTexture::ptr_t LzmaTexture::Create(std::uint8_t* pData,
         gsl::span<std::uint8_t>(pData, iDataSize));
 }
 
+LzmaTexture::ptr_t LzmaTexture::Create(PkgEntry& entry)
+{
+    return std::make_unique<LzmaTextureImpl>(entry);
+}
+
 LzmaTextureImpl::LzmaTextureImpl(std::vector<std::uint8_t>& texData)
-    : m_TexDataView(texData)
+    : m_TexDataView(texData), m_pEntry(nullptr), m_iDecryptedSize(0)
 {
     if (LzmaTexture::IsLzmaTexture(this->m_TexDataView.data(),
                                    this->m_TexDataView.size_bytes()) == false)
@@ -30,7 +68,7 @@ LzmaTextureImpl::LzmaTextureImpl(std::vector<std::uint8_t>& texData)
 }
 
 LzmaTextureImpl::LzmaTextureImpl(gsl::span<std::uint8_t> texDataView)
-    : m_TexDataView(texDataView)
+    : m_TexDataView(texDataView), m_pEntry(nullptr), m_iDecryptedSize(0)
 {
     if (LzmaTexture::IsLzmaTexture(this->m_TexDataView.data(),
                                    this->m_TexDataView.size_bytes()) == false)
@@ -39,6 +77,22 @@ LzmaTextureImpl::LzmaTextureImpl(gsl::span<std::uint8_t> texDataView)
     }
 }
 
+LzmaTextureImpl::LzmaTextureImpl(PkgEntry& entry)
+    : m_pEntry(&entry), m_iDecryptedSize(0)
+{
+    this->m_vEntryData.resize(entry.GetDecryptedSize());
+    this->m_TexDataView = this->m_vEntryData;
+
+    // the header and the chunk table always fit in the first block
+    this->DecryptNextEntryBlock();
+
+    if (LzmaTexture::IsLzmaTexture(this->m_TexDataView.data(),
+                                   this->m_iDecryptedSize) == false)
+    {
+        throw std::invalid_argument("libuncso2: The file's header is invalid");
+    }
+}
+
 LzmaTextureImpl::~LzmaTextureImpl() {}
 
 std::uint64_t LzmaTextureImpl::GetOriginalSize()
@@ -52,6 +106,14 @@ std::uint64_t LzmaTextureImpl::GetOriginalSize()
 bool LzmaTextureImpl::Decompress(std::uint8_t* outBuffer,
                                  std::uint64_t outBufferSize)
 {
+    UC2_TRACE_SPAN("LzmaTexture::Decompress", {}, this->GetEntryPath());
+
+    if (this->m_iDecryptedSize < this->m_vEntryData.size())
+    {
+        // interleave the decryption with the decompression on this thread
+        return this->DecompressEntry(outBuffer, outBufferSize, 1);
+    }
+
     auto pHeader =
         reinterpret_cast<LzmaVtfHeader_t*>(this->m_TexDataView.data());
 
@@ -95,6 +157,345 @@ bool LzmaTextureImpl::Decompress(std::uint8_t* outBuffer,
     return true;
 }
 
+bool LzmaTextureImpl::DecompressParallel(std::uint8_t* outBuffer,
+                                         std::uint64_t outBufferSize,
+                                         std::uint32_t iThreadsNum /*= 0*/)
+{
+    UC2_TRACE_SPAN("LzmaTexture::DecompressParallel", {},
+                   this->GetEntryPath());
+
+    if (this->m_iDecryptedSize < this->m_vEntryData.size())
+    {
+        return this->DecompressEntry(outBuffer, outBufferSize, iThreadsNum);
+    }
+
+    if (this->GetOriginalSize() != outBufferSize)
+    {
+        return false;
+    }
+
+    std::vector<Chunk_t> vChunks;
+
+    // the chunks are written concurrently, so they must be in bounds first
+    if (this->BuildChunkTable(vChunks) == false)
+    {
+        return false;
+    }
+
+    if (iThreadsNum == 0)
+    {
+        // hardware_concurrency may not know the number of cores
+        iThreadsNum = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    iThreadsNum = std::min(iThreadsNum,
+                           static_cast<std::uint32_t>(vChunks.size()));
+
+    std::atomic<bool> bFailed(false);
+
+    ForEachChunk(vChunks.size(), iThreadsNum, [&](std::size_t i) {
+        UC2_TRACE_SPAN("LzmaTexture::DecompressChunk", {},
+                       this->GetEntryPath());
+
+        const Chunk_t& chunk = vChunks[i];
+        std::uint8_t* pOut = outBuffer + chunk.iOutOffset;
+
+        if (chunk.bIsCompressed == true)
+        {
+            if (CLZMA::Uncompress(chunk.pSource, pOut) != chunk.iOutSize)
+            {
+                bFailed = true;
+            }
+        }
+        else
+        {
+            std::copy_n(chunk.pSource, chunk.iOutSize, pOut);
+        }
+    });
+
+    return bFailed == false;
+}
+
+bool LzmaTextureImpl::BuildChunkTable(std::vector<Chunk_t>& vOutChunks) const
+{
+    auto pHeader =
+        reinterpret_cast<LzmaVtfHeader_t*>(this->m_TexDataView.data());
+
+    const std::uint64_t iDataSize = this->m_TexDataView.size_bytes();
+    const std::uint64_t iTableEnd =
+        sizeof(LzmaVtfHeader_t) +
+        pHeader->iProbs * 2 * sizeof(pHeader->iChunkSizes[0]);
+
+    if (iTableEnd > iDataSize)
+    {
+        return false;
+    }
+
+    std::uint8_t* pBuffer = this->m_TexDataView.data();
+    std::uint64_t iOutOffset = 0;
+
+    vOutChunks.reserve(pHeader->iProbs);
+
+    for (std::uint8_t i = 0; i < pHeader->iProbs; i++)
+    {
+        const std::uint32_t iChunkInfo = pHeader->iChunkSizes[i * 2];
+        const std::uint64_t iChunkOffset = iChunkInfo >> 1;
+
+        Chunk_t chunk;
+        chunk.pSource = pBuffer + iChunkOffset;
+        chunk.iOutOffset = iOutOffset;
+        chunk.bIsCompressed = (iChunkInfo & 1) != 0;
+
+        if (chunk.bIsCompressed == true)
+        {
+            // the output size comes from the chunk's own LZMA header, which
+            // is what CLZMA::Uncompress writes
+            if (iChunkOffset > iDataSize ||
+                iDataSize - iChunkOffset < sizeof(lzma_header_t))
+            {
+                return false;
+            }
+
+            auto pLzmaHeader = reinterpret_cast<lzma_header_t*>(chunk.pSource);
+
+            if (CLZMA::IsCompressed(chunk.pSource) == false ||
+                iDataSize - iChunkOffset - sizeof(lzma_header_t) <
+                    pLzmaHeader->lzmaSize)
+            {
+                return false;
+            }
+
+            chunk.iSourceSize = sizeof(lzma_header_t) + pLzmaHeader->lzmaSize;
+            chunk.iOutSize = pLzmaHeader->actualSize;
+        }
+        else
+        {
+            chunk.iOutSize = pHeader->iChunkSizes[i * 2 + 1];
+            chunk.iSourceSize = chunk.iOutSize;
+
+            if (iChunkOffset > iDataSize ||
+                iDataSize - iChunkOffset < chunk.iOutSize)
+            {
+                return false;
+            }
+        }
+
+        iOutOffset += chunk.iOutSize;
+        vOutChunks.push_back(chunk);
+    }
+
+    return iOutOffset == pHeader->iOriginalSize;
+}
+
+bool LzmaTextureImpl::PlaceDecryptedChunks(
+    std::vector<Chunk_t>& vChunks, std::size_t& iPlacedChunks,
+    std::uint64_t& iNextOutOffset, const std::uint64_t iOutBufferSize) const
+{
+    auto pHeader =
+        reinterpret_cast<LzmaVtfHeader_t*>(this->m_TexDataView.data());
+
+    const std::uint64_t iDataSize = this->m_TexDataView.size_bytes();
+    std::uint8_t* pBuffer = this->m_TexDataView.data();
+
+    while (iPlacedChunks < vChunks.size())
+    {
+        const std::uint32_t iChunkInfo =
+            pHeader->iChunkSizes[iPlacedChunks * 2];
+        const std::uint64_t iChunkOffset = iChunkInfo >> 1;
+
+        Chunk_t& chunk = vChunks[iPlacedChunks];
+        chunk.pSource = pBuffer + iChunkOffset;
+        chunk.iOutOffset = iNextOutOffset;
+        chunk.bIsCompressed = (iChunkInfo & 1) != 0;
+
+        if (chunk.bIsCompressed == true)
+        {
+            if (iChunkOffset > iDataSize ||
+                iDataSize - iChunkOffset < sizeof(lzma_header_t))
+            {
+                return false;
+            }
+
+            // the chunk's output size is in its LZMA header, so the chunks
+            // after it can only be placed once that header is decrypted
+            if (iChunkOffset + sizeof(lzma_header_t) > this->m_iDecryptedSize)
+            {
+                return true;
+            }
+
+            auto pLzmaHeader = reinterpret_cast<lzma_header_t*>(chunk.pSource);
+
+            if (CLZMA::IsCompressed(chunk.pSource) == false ||
+                iDataSize - iChunkOffset - sizeof(lzma_header_t) <
+                    pLzmaHeader->lzmaSize)
+            {
+                return false;
+            }
+
+            chunk.iSourceSize = sizeof(lzma_header_t) + pLzmaHeader->lzmaSize;
+            chunk.iOutSize = pLzmaHeader->actualSize;
+        }
+        else
+        {
+            chunk.iOutSize = pHeader->iChunkSizes[iPlacedChunks * 2 + 1];
+            chunk.iSourceSize = chunk.iOutSize;
+
+            if (iChunkOffset > iDataSize ||
+                iDataSize - iChunkOffset < chunk.iOutSize)
+            {
+                return false;
+            }
+        }
+
+        if (iOutBufferSize - iNextOutOffset < chunk.iOutSize)
+        {
+            return false;
+        }
+
+        iNextOutOffset += chunk.iOutSize;
+        iPlacedChunks++;
+    }
+
+    return iNextOutOffset == pHeader->iOriginalSize;
+}
+
+bool LzmaTextureImpl::DecryptNextEntryBlock()
+{
+    const std::uint64_t iDataSize = this->m_vEntryData.size();
+
+    if (this->m_iDecryptedSize >= iDataSize)
+    {
+        return false;
+    }
+
+    // whole blocks are read so every block is decrypted only once
+    const std::uint64_t iBlockSize =
+        std::min(PKG_DATA_BLOCK_SIZE, iDataSize - this->m_iDecryptedSize);
+
+    this->m_pEntry->ReadRange(
+        this->m_iDecryptedSize, iBlockSize,
+        this->m_vEntryData.data() + this->m_iDecryptedSize);
+    this->m_iDecryptedSize += iBlockSize;
+
+    return true;
+}
+
+bool LzmaTextureImpl::DecompressEntry(std::uint8_t* outBuffer,
+                                      std::uint64_t outBufferSize,
+                                      std::uint32_t iThreadsNum)
+{
+    auto pHeader =
+        reinterpret_cast<LzmaVtfHeader_t*>(this->m_TexDataView.data());
+
+    if (pHeader->iOriginalSize != outBufferSize)
+    {
+        return false;
+    }
+
+    const std::uint64_t iTableEnd =
+        sizeof(LzmaVtfHeader_t) +
+        pHeader->iProbs * 2 * sizeof(pHeader->iChunkSizes[0]);
+
+    if (iTableEnd > this->m_iDecryptedSize)
+    {
+        return false;
+    }
+
+    if (iThreadsNum == 0)
+    {
+        // hardware_concurrency may not know the number of cores
+        iThreadsNum = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    iThreadsNum =
+        std::min(iThreadsNum, static_cast<std::uint32_t>(pHeader->iProbs));
+
+    std::vector<Chunk_t> vChunks(pHeader->iProbs);
+    std::size_t iPlacedChunks = 0;
+    std::uint64_t iNextOutOffset = 0;
+    std::mutex placeMutex;
+
+    std::atomic<bool> bFailed(false);
+
+    // the chunks are handed out in order, and each task decrypts the blocks
+    // up to the end of its chunk before decompressing it, so the other
+    // threads decompress the chunks before it in the meantime
+    ForEachChunk(vChunks.size(), iThreadsNum, [&](std::size_t i) {
+        if (bFailed == true)
+        {
+            return;
+        }
+
+        UC2_TRACE_SPAN("LzmaTexture::DecompressChunk", {},
+                       this->GetEntryPath());
+
+        Chunk_t chunk;
+
+        {
+            std::lock_guard<std::mutex> lock(placeMutex);
+
+            while (true)
+            {
+                if (this->PlaceDecryptedChunks(vChunks, iPlacedChunks,
+                                               iNextOutOffset,
+                                               outBufferSize) == false)
+                {
+                    bFailed = true;
+                    return;
+                }
+
+                if (i < iPlacedChunks)
+                {
+                    const Chunk_t& placed = vChunks[i];
+                    const std::uint64_t iChunkEnd =
+                        (placed.pSource - this->m_TexDataView.data()) +
+                        placed.iSourceSize;
+
+                    if (iChunkEnd <= this->m_iDecryptedSize)
+                    {
+                        chunk = placed;
+                        break;
+                    }
+                }
+
+                if (this->DecryptNextEntryBlock() == false)
+                {
+                    bFailed = true;
+                    return;
+                }
+            }
+        }
+
+        std::uint8_t* pOut = outBuffer + chunk.iOutOffset;
+
+        if (chunk.bIsCompressed == true)
+        {
+            if (CLZMA::Uncompress(chunk.pSource, pOut) != chunk.iOutSize)
+            {
+                bFailed = true;
+            }
+        }
+        else
+        {
+            std::copy_n(chunk.pSource, chunk.iOutSize, pOut);
+        }
+    });
+
+    if (bFailed == true)
+    {
+        return false;
+    }
+
+    return iPlacedChunks == vChunks.size() &&
+           iNextOutOffset == pHeader->iOriginalSize;
+}
+
+std::string_view LzmaTextureImpl::GetEntryPath() const
+{
+    return this->m_pEntry != nullptr ? this->m_pEntry->GetFilePath() :
+                                       std::string_view();
+}
+
 bool LzmaTexture::IsLzmaTexture(std::uint8_t* pData,
                                 const std::uint64_t iDataSize)
 {
@@ -0,0 +1,368 @@
+#include "lzmatexturereaderimpl.hpp"
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <stdexcept>
+
+#include "lzmaDecoder.h"
+#include "lzmatextureimpl.hpp"
+#include "pkgentryreader.hpp"
+
+namespace uc2
+{
+constexpr const std::uint64_t LZMA_TEXTURE_WINDOW_SIZE = 0x10000;
+
+std::uint64_t LzmaTextureReader::GetWindowSize()
+{
+    return LZMA_TEXTURE_WINDOW_SIZE;
+}
+
+LzmaTextureReader::ptr_t LzmaTextureReader::Create(
+    const std::uint8_t* pData, const std::uint64_t iDataSize)
+{
+    bool bWasRead = false;
+
+    // the whole buffer is a single piece of input
+    return std::make_unique<LzmaTextureReaderImpl>(
+        [pData, iDataSize,
+         bWasRead]() mutable -> std::pair<const std::uint8_t*, std::uint64_t> {
+            if (bWasRead == true)
+            {
+                return { nullptr, 0 };
+            }
+
+            bWasRead = true;
+            return { pData, iDataSize };
+        });
+}
+
+LzmaTextureReader::ptr_t LzmaTextureReader::Create(
+    PkgEntryReader& entryReader)
+{
+    return std::make_unique<LzmaTextureReaderImpl>(
+        [&entryReader]() { return entryReader.Next(); });
+}
+
+LzmaTextureReaderImpl::LzmaTextureReaderImpl(InputSource_t inputSource)
+    : m_InputSource(std::move(inputSource)), m_pInput(nullptr),
+      m_iInputLeft(0), m_iInputOffset(0), m_bHeaderRead(false),
+      m_iOriginalSize(0), m_iCurChunk(0), m_bChunkStarted(false),
+      m_iPlainLeft(0), m_iPosition(0), m_vWindow(LZMA_TEXTURE_WINDOW_SIZE)
+{
+}
+
+LzmaTextureReaderImpl::~LzmaTextureReaderImpl() {}
+
+std::pair<const std::uint8_t*, std::uint64_t> LzmaTextureReaderImpl::Next()
+{
+    this->ReadHeader();
+
+    std::uint8_t* pWindow = this->m_vWindow.data();
+    std::uint64_t iWritten = 0;
+
+    while (iWritten < LZMA_TEXTURE_WINDOW_SIZE &&
+           this->m_iCurChunk < this->m_Chunks.size())
+    {
+        if (this->m_bChunkStarted == false)
+        {
+            this->StartChunk();
+        }
+
+        std::uint8_t* pOutput = pWindow + iWritten;
+        const std::uint64_t iOutputSize = LZMA_TEXTURE_WINDOW_SIZE - iWritten;
+
+        if (this->m_Chunks[this->m_iCurChunk].bIsCompressed == true)
+        {
+            iWritten += this->ReadCompressedChunk(pOutput, iOutputSize);
+        }
+        else
+        {
+            iWritten += this->ReadPlainChunk(pOutput, iOutputSize);
+        }
+    }
+
+    this->m_iPosition += iWritten;
+
+    if (this->m_iPosition > this->m_iOriginalSize ||
+        (this->IsFinished() == true &&
+         this->m_iPosition != this->m_iOriginalSize))
+    {
+        throw std::runtime_error("libuncso2: The texture's chunks do not add "
+                                 "up to its original size");
+    }
+
+    if (iWritten == 0)
+    {
+        return { nullptr, 0 };
+    }
+
+    return { pWindow, iWritten };
+}
+
+std::uint64_t LzmaTextureReaderImpl::GetOriginalSize()
+{
+    this->ReadHeader();
+    return this->m_iOriginalSize;
+}
+
+std::uint64_t LzmaTextureReaderImpl::GetPosition()
+{
+    return this->m_iPosition;
+}
+
+bool LzmaTextureReaderImpl::IsFinished()
+{
+    return this->m_bHeaderRead == true &&
+           this->m_iCurChunk >= this->m_Chunks.size();
+}
+
+void LzmaTextureReaderImpl::ReadHeader()
+{
+    if (this->m_bHeaderRead == true)
+    {
+        return;
+    }
+
+    std::vector<std::uint8_t> vHeader;
+
+    auto readHeaderBytes = [this, &vHeader](std::uint64_t iHeaderSize) {
+        while (vHeader.size() < iHeaderSize)
+        {
+            if (this->PullInput() == false)
+            {
+                throw std::runtime_error(
+                    "libuncso2: The texture's header is truncated");
+            }
+
+            const std::uint64_t iBytes =
+                std::min(iHeaderSize - vHeader.size(), this->m_iInputLeft);
+            vHeader.insert(vHeader.end(), this->m_pInput,
+                           this->m_pInput + iBytes);
+            this->ConsumeInput(iBytes);
+        }
+    };
+
+    readHeaderBytes(sizeof(LzmaVtfHeader_t));
+
+    if (LzmaTextureImpl::IsLzmaTextureSpan(vHeader) == false)
+    {
+        throw std::runtime_error("libuncso2: The file's header is invalid");
+    }
+
+    const std::uint8_t iProbs =
+        reinterpret_cast<LzmaVtfHeader_t*>(vHeader.data())->iProbs;
+    readHeaderBytes(sizeof(LzmaVtfHeader_t) +
+                    iProbs * 2 * sizeof(std::uint32_t));
+
+    auto pHeader = reinterpret_cast<LzmaVtfHeader_t*>(vHeader.data());
+
+    this->m_iOriginalSize = pHeader->iOriginalSize;
+    this->m_Chunks.reserve(iProbs);
+
+    for (std::uint8_t i = 0; i < iProbs; i++)
+    {
+        const std::uint32_t iChunkInfo = pHeader->iChunkSizes[i * 2];
+
+        Chunk_t chunk;
+        chunk.iSourceOffset = iChunkInfo >> 1;
+        chunk.iPlainSize = pHeader->iChunkSizes[i * 2 + 1];
+        chunk.bIsCompressed = (iChunkInfo & 1) != 0;
+
+        this->m_Chunks.push_back(chunk);
+    }
+
+    this->m_bHeaderRead = true;
+}
+
+bool LzmaTextureReaderImpl::PullInput()
+{
+    while (this->m_iInputLeft == 0)
+    {
+        auto [pInput, iInputSize] = this->m_InputSource();
+
+        if (iInputSize == 0)
+        {
+            return false;
+        }
+
+        this->m_pInput = pInput;
+        this->m_iInputLeft = iInputSize;
+    }
+
+    return true;
+}
+
+void LzmaTextureReaderImpl::ConsumeInput(std::uint64_t iBytes)
+{
+    this->m_pInput += iBytes;
+    this->m_iInputLeft -= iBytes;
+    this->m_iInputOffset += iBytes;
+}
+
+void LzmaTextureReaderImpl::SkipInputTo(std::uint64_t iSourceOffset)
+{
+    // the input can't go backwards
+    if (iSourceOffset < this->m_iInputOffset)
+    {
+        throw std::runtime_error(
+            "libuncso2: The texture's chunks are not stored in order");
+    }
+
+    while (this->m_iInputOffset < iSourceOffset)
+    {
+        if (this->PullInput() == false)
+        {
+            throw std::runtime_error("libuncso2: The texture is truncated");
+        }
+
+        this->ConsumeInput(std::min(iSourceOffset - this->m_iInputOffset,
+                                    this->m_iInputLeft));
+    }
+}
+
+void LzmaTextureReaderImpl::StartChunk()
+{
+    const Chunk_t& chunk = this->m_Chunks[this->m_iCurChunk];
+
+    this->SkipInputTo(chunk.iSourceOffset);
+
+    if (chunk.bIsCompressed == false)
+    {
+        this->m_iPlainLeft = chunk.iPlainSize;
+        this->m_bChunkStarted = true;
+        return;
+    }
+
+    // CLZMAStream needs the whole LZMA header in a single read, and it may be
+    // split between two pieces of input
+    std::array<std::uint8_t, sizeof(lzma_header_t)> lzmaHeader;
+    std::uint64_t iHeaderBytes = 0;
+
+    while (iHeaderBytes < lzmaHeader.size())
+    {
+        if (this->PullInput() == false)
+        {
+            throw std::runtime_error("libuncso2: The texture is truncated");
+        }
+
+        const std::uint64_t iBytes =
+            std::min(lzmaHeader.size() - iHeaderBytes, this->m_iInputLeft);
+        std::copy_n(this->m_pInput, iBytes, lzmaHeader.data() + iHeaderBytes);
+        this->ConsumeInput(iBytes);
+        iHeaderBytes += iBytes;
+    }
+
+    if (CLZMA::IsCompressed(lzmaHeader.data()) == false)
+    {
+        throw std::runtime_error(
+            "libuncso2: A texture chunk has an invalid LZMA header");
+    }
+
+    this->m_pLzmaStream = std::make_unique<CLZMAStream>();
+
+    unsigned int iConsumed = 0;
+    unsigned int iWritten = 0;
+
+    if (this->m_pLzmaStream->Read(
+            lzmaHeader.data(), static_cast<unsigned int>(lzmaHeader.size()),
+            this->m_vWindow.data(), 0, iConsumed, iWritten) == false ||
+        iConsumed != lzmaHeader.size())
+    {
+        throw std::runtime_error(
+            "libuncso2: A texture chunk has an invalid LZMA header");
+    }
+
+    this->m_bChunkStarted = true;
+}
+
+void LzmaTextureReaderImpl::FinishChunk()
+{
+    this->m_pLzmaStream.reset();
+    this->m_bChunkStarted = false;
+    this->m_iCurChunk++;
+}
+
+std::uint64_t LzmaTextureReaderImpl::ReadPlainChunk(std::uint8_t* pOutput,
+                                                    std::uint64_t iOutputSize)
+{
+    std::uint64_t iWritten = 0;
+
+    while (this->m_iPlainLeft > 0 && iWritten < iOutputSize)
+    {
+        if (this->PullInput() == false)
+        {
+            throw std::runtime_error("libuncso2: The texture is truncated");
+        }
+
+        const std::uint64_t iBytes = std::min(
+            { this->m_iPlainLeft, this->m_iInputLeft, iOutputSize - iWritten });
+
+        std::copy_n(this->m_pInput, iBytes, pOutput + iWritten);
+        this->ConsumeInput(iBytes);
+
+        this->m_iPlainLeft -= iBytes;
+        iWritten += iBytes;
+    }
+
+    if (this->m_iPlainLeft == 0)
+    {
+        this->FinishChunk();
+    }
+
+    return iWritten;
+}
+
+std::uint64_t LzmaTextureReaderImpl::ReadCompressedChunk(
+    std::uint8_t* pOutput, std::uint64_t iOutputSize)
+{
+    std::uint64_t iWritten = 0;
+    unsigned int iOutputLeft = 0;
+
+    this->m_pLzmaStream->GetExpectedBytesRemaining(iOutputLeft);
+
+    while (iOutputLeft > 0 && iWritten < iOutputSize)
+    {
+        // the decoder may still have buffered input to decode when there's
+        // none left
+        const bool bHasInput = this->PullInput();
+
+        const auto iInputSize = static_cast<unsigned int>(
+            std::min<std::uint64_t>(this->m_iInputLeft, UINT_MAX));
+        const auto iMaxOutput = static_cast<unsigned int>(
+            std::min<std::uint64_t>(iOutputSize - iWritten, UINT_MAX));
+
+        unsigned int iConsumed = 0;
+        unsigned int iDecoded = 0;
+
+        if (this->m_pLzmaStream->Read(const_cast<std::uint8_t*>(this->m_pInput),
+                                      iInputSize, pOutput + iWritten,
+                                      iMaxOutput, iConsumed,
+                                      iDecoded) == false)
+        {
+            throw std::runtime_error(
+                "libuncso2: A texture chunk could not be decompressed");
+        }
+
+        if (iConsumed == 0 && iDecoded == 0)
+        {
+            throw std::runtime_error(
+                bHasInput == true ?
+                    "libuncso2: A texture chunk could not be decompressed" :
+                    "libuncso2: The texture is truncated");
+        }
+
+        this->ConsumeInput(iConsumed);
+        iWritten += iDecoded;
+
+        this->m_pLzmaStream->GetExpectedBytesRemaining(iOutputLeft);
+    }
+
+    if (iOutputLeft == 0)
+    {
+        this->FinishChunk();
+    }
+
+    return iWritten;
+}
+}  // namespace uc2
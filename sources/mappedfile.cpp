@@ -0,0 +1,131 @@
+#include "mappedfile.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace uc2
+{
+CMappedFile::CMappedFile(const std::filesystem::path& filePath)
+    : m_FilePath(filePath), m_pData(nullptr), m_iSize(0)
+{
+    const std::string szErrorMsg =
+        "libuncso2: Could not map the file " + filePath.string();
+
+#ifdef _WIN32
+    HANDLE hFile = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                               NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                               NULL);
+
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error(szErrorMsg);
+    }
+
+    LARGE_INTEGER fileSize;
+
+    if (GetFileSizeEx(hFile, &fileSize) == FALSE)
+    {
+        CloseHandle(hFile);
+        throw std::runtime_error(szErrorMsg);
+    }
+
+    this->m_iSize = static_cast<std::uint64_t>(fileSize.QuadPart);
+
+    // empty files cannot be mapped, leave the view empty
+    if (this->m_iSize == 0)
+    {
+        CloseHandle(hFile);
+        return;
+    }
+
+    HANDLE hMapping =
+        CreateFileMappingW(hFile, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    CloseHandle(hFile);
+
+    if (hMapping == NULL)
+    {
+        throw std::runtime_error(szErrorMsg);
+    }
+
+    void* pView = MapViewOfFile(hMapping, FILE_MAP_COPY, 0, 0, 0);
+    CloseHandle(hMapping);
+
+    if (pView == NULL)
+    {
+        throw std::runtime_error(szErrorMsg);
+    }
+#else
+    const int fd = open(filePath.c_str(), O_RDONLY);
+
+    if (fd == -1)
+    {
+        throw std::runtime_error(szErrorMsg);
+    }
+
+    struct stat fileStat;
+
+    if (fstat(fd, &fileStat) == -1)
+    {
+        close(fd);
+        throw std::runtime_error(szErrorMsg);
+    }
+
+    this->m_iSize = static_cast<std::uint64_t>(fileStat.st_size);
+
+    // empty files cannot be mapped, leave the view empty
+    if (this->m_iSize == 0)
+    {
+        close(fd);
+        return;
+    }
+
+    // the changes made to a private mapping never reach the file
+    void* pView = mmap(nullptr, this->m_iSize, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (pView == MAP_FAILED)
+    {
+        throw std::runtime_error(szErrorMsg);
+    }
+#endif
+
+    this->m_pData = static_cast<std::uint8_t*>(pView);
+}
+
+CMappedFile::~CMappedFile()
+{
+    if (this->m_pData == nullptr)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(this->m_pData);
+#else
+    munmap(this->m_pData, this->m_iSize);
+#endif
+}
+
+const std::filesystem::path& CMappedFile::GetPath() const
+{
+    return this->m_FilePath;
+}
+
+gsl::span<std::uint8_t> CMappedFile::GetView() const
+{
+    return gsl::span<std::uint8_t>(this->m_pData, this->m_iSize);
+}
+}  // namespace uc2
@@ -7,6 +7,9 @@
 #include <ciphers/aescipher.hpp>
 #include "decryptor.hpp"
 #include "keyhashes.hpp"
+#include "pkg/pkgstructures.hpp"
+#include "threadpool.hpp"
+#include "traceimpl.hpp"
 
 static std::string MakeUnixSeparated(std::string_view inPath)
 {
@@ -15,7 +18,7 @@ static std::string MakeUnixSeparated(std::string_view inPath)
     std::string szNewPath;
     szNewPath.reserve(sizeof(rootCharacter) + inPath.length());
     szNewPath = rootCharacter;
-    szNewPath += inPath.data();
+    szNewPath += inPath;
     std::replace(szNewPath.begin(), szNewPath.end(), '\\', '/');
 
     return szNewPath;
@@ -30,16 +33,15 @@ constexpr inline NoConstNumType RoundNumberToBlock(const NumType num)
 
 namespace uc2
 {
-constexpr const std::size_t PKG_ENTRY_KEY_LEN = 16;
-constexpr const std::uint64_t PKG_DATA_BLOCK_SIZE = 0x10000;
-
 PkgEntryImpl::PkgEntryImpl(std::string_view szFilePath,
                            std::uint64_t pkgFileOffset,
                            std::uint64_t encryptedSize,
                            std::uint64_t decryptedSize, bool isEncrypted,
                            gsl::span<std::uint8_t> fileDataView,
-                           std::string_view szvPkgKey /*= {}*/)
-    : m_FileDataView(fileDataView), m_szFilePath(MakeUnixSeparated(szFilePath)),
+                           std::string_view szvPkgKey /*= {}*/,
+                           CThreadPool* pDecryptPool /*= nullptr*/)
+    : m_FileDataView(fileDataView), m_pDecryptPool(pDecryptPool),
+      m_szFilePath(MakeUnixSeparated(szFilePath)),
       m_iPkgFileOffset(pkgFileOffset), m_iEncryptedSize(encryptedSize),
       m_iDecryptedSize(decryptedSize), m_bIsEncrypted(isEncrypted)
 {
@@ -52,10 +54,14 @@ PkgEntryImpl::PkgEntryImpl(std::string_view szFilePath,
                                         "bigger than the encrypted size");
         }
 
-        fs::path filePath = this->m_szFilePath;
-        this->m_szHashedKey =
-            GeneratePkgFileKey(filePath.filename().string(), szvPkgKey);
-        this->m_szHashedKey.resize(PKG_ENTRY_KEY_LEN);
+        // the path is unix separated, so its file name follows the last '/'
+        std::string_view szvFilename = this->m_szFilePath;
+        szvFilename.remove_prefix(szvFilename.rfind('/') + 1);
+
+        const PkgFileKeyHex_t keyHex =
+            GetCachedPkgFileKeyHex(szvFilename, szvPkgKey);
+        std::copy_n(keyHex.begin(), this->m_HashedKey.size(),
+                    this->m_HashedKey.begin());
     }
 }
 
@@ -64,6 +70,9 @@ PkgEntryImpl::~PkgEntryImpl() {}
 std::pair<std::uint8_t*, std::uint64_t> PkgEntryImpl::DecryptFile(
     const std::uint64_t iBytesToDecrypt /*= 0 */)
 {
+    UC2_TRACE_SPAN("PkgEntry::DecryptFile", this->m_szvPkgFilename,
+                   this->m_szFilePath);
+
     if (this->m_FileDataView.empty() == true)
     {
         throw std::invalid_argument(
@@ -96,6 +105,87 @@ std::pair<std::uint8_t*, std::uint64_t> PkgEntryImpl::DecryptFile(
     }
 }
 
+std::uint64_t PkgEntryImpl::DecryptFileTo(
+    std::uint8_t* pOutBuffer, const std::uint64_t iOutBufferSize,
+    const std::uint64_t iBytesToDecrypt /*= 0 */)
+{
+    UC2_TRACE_SPAN("PkgEntry::DecryptFileTo", this->m_szvPkgFilename,
+                   this->m_szFilePath);
+
+    const std::uint64_t iTargetDecDataSize =
+        iBytesToDecrypt == 0 ?
+            this->m_iDecryptedSize :
+            std::min(iBytesToDecrypt, this->m_iDecryptedSize);
+
+    if (iOutBufferSize < iTargetDecDataSize)
+    {
+        throw std::length_error("libuncso2: The output buffer is smaller than "
+                                "the data to decrypt");
+    }
+
+    return this->ReadRange(0, iTargetDecDataSize, pOutBuffer);
+}
+
+std::uint64_t PkgEntryImpl::ReadRange(const std::uint64_t iOffset,
+                                      const std::uint64_t iLength,
+                                      std::uint8_t* pOutBuffer)
+{
+    if (this->m_FileDataView.empty() == true)
+    {
+        throw std::invalid_argument(
+            "libuncso2: The entry's file data is empty.");
+    }
+
+    if (iOffset > this->m_iDecryptedSize)
+    {
+        throw std::out_of_range(
+            "libuncso2: The range starts after the end of the file");
+    }
+
+    const std::uint64_t iReadLength =
+        std::min(iLength, this->m_iDecryptedSize - iOffset);
+
+    if (iReadLength == 0)
+    {
+        return 0;
+    }
+
+    if (pOutBuffer == nullptr)
+    {
+        throw std::invalid_argument("libuncso2: The output buffer is null");
+    }
+
+    // only the blocks holding the requested bytes are decrypted
+    const std::uint64_t iRangeEnd = iOffset + iReadLength;
+    const std::uint64_t iRequiredDataSize =
+        this->IsEncrypted() == true ? RoundNumberToBlock(iRangeEnd) :
+                                      iRangeEnd;
+
+    const std::uint64_t iRequiredFileSize =
+        this->m_iPkgFileOffset + iRequiredDataSize;
+    const std::uint64_t iFileDataSize = this->m_FileDataView.size_bytes();
+
+    if (iRequiredFileSize > iFileDataSize)
+    {
+        throw std::runtime_error("libuncso2: The file in this entry cannot be "
+                                 "larger than the pkg file");
+    }
+
+    const std::uint8_t* pFileStart =
+        this->m_FileDataView.data() + this->m_iPkgFileOffset;
+
+    if (this->IsEncrypted() == true)
+    {
+        this->DecryptRange(pFileStart, pOutBuffer, iOffset, iReadLength);
+    }
+    else
+    {
+        std::copy_n(pFileStart + iOffset, iReadLength, pOutBuffer);
+    }
+
+    return iReadLength;
+}
+
 const std::string_view PkgEntryImpl::GetFilePath()
 {
     return this->m_szFilePath;
@@ -134,9 +224,6 @@ std::pair<std::uint8_t*, std::uint64_t> PkgEntryImpl::HandleEncryptedFile(
         this->m_iPkgFileOffset;
     std::uint8_t* pFileStart = reinterpret_cast<std::uint8_t*>(dwBlockStart);
 
-    CAesCipher cipher;
-    CDecryptor decryptor(&cipher, this->m_szHashedKey, false);
-
     bool bDecryptAll = iBytesToDecrypt == 0;
 
     const std::uint64_t iTargetEncDataSize =
@@ -144,19 +231,7 @@ std::pair<std::uint8_t*, std::uint64_t> PkgEntryImpl::HandleEncryptedFile(
     const std::uint64_t iTargetDecDataSize =
         bDecryptAll == true ? this->m_iDecryptedSize : iBytesToDecrypt;
 
-    // The data must be decrypted each PKG_DATA_BLOCK_SIZE (which at the
-    // time of writing this is 65536), or else only the first 65536
-    // bytes will be correct
-    for (std::uint64_t curOff = 0; curOff < iTargetEncDataSize;
-         curOff += PKG_DATA_BLOCK_SIZE)
-    {
-        std::uint8_t* pBlock =
-            reinterpret_cast<std::uint8_t*>(dwBlockStart + curOff);
-        const std::uint64_t iCurBlockSize =
-            std::min(iTargetEncDataSize - curOff, PKG_DATA_BLOCK_SIZE);
-
-        decryptor.DecryptInBuffer(pBlock, iCurBlockSize);
-    }
+    this->DecryptRange(pFileStart, pFileStart, 0, iTargetEncDataSize);
 
     return { pFileStart, iTargetDecDataSize };
 }
@@ -176,6 +251,129 @@ std::pair<std::uint8_t*, std::uint64_t> PkgEntryImpl::HandlePlainFile(
     return { pFileStart, iTargetDecDataSize };
 }
 
+void PkgEntryImpl::DecryptRange(const std::uint8_t* pInData,
+                                std::uint8_t* pOutBuffer,
+                                const std::uint64_t iOffset,
+                                const std::uint64_t iLength) const
+{
+    constexpr const std::uint64_t iCipherBlockSize = 16;
+
+    const std::uint64_t iRangeEnd = iOffset + iLength;
+
+    // The data must be decrypted each PKG_DATA_BLOCK_SIZE (which at the
+    // time of writing this is 65536), or else only the first 65536
+    // bytes will be correct
+    const std::uint64_t iFirstBlock = iOffset / PKG_DATA_BLOCK_SIZE;
+    const std::uint64_t iBlocksNum =
+        (iRangeEnd + PKG_DATA_BLOCK_SIZE - 1) / PKG_DATA_BLOCK_SIZE -
+        iFirstBlock;
+
+    auto fnDecryptBlocks = [this, pInData, pOutBuffer, iOffset,
+                            iRangeEnd](std::uint64_t iStartBlock,
+                                       std::uint64_t iEndBlock) {
+        UC2_TRACE_SPAN("PkgEntry::DecryptBlocks", this->m_szvPkgFilename,
+                       this->m_szFilePath);
+
+        CAesCipher cipher;
+        const std::string_view szvKey(this->m_HashedKey.data(),
+                                      this->m_HashedKey.size());
+        CDecryptor decryptor(&cipher, szvKey, false);
+
+        std::vector<std::uint8_t> vBlock;
+
+        for (std::uint64_t i = iStartBlock; i < iEndBlock; i++)
+        {
+            const std::uint64_t iBlockStart = i * PKG_DATA_BLOCK_SIZE;
+            const std::uint64_t iBlockEnd = iBlockStart + PKG_DATA_BLOCK_SIZE;
+
+            // the bytes wanted from this block
+            const std::uint64_t iCopyStart = std::max(iOffset, iBlockStart);
+            const std::uint64_t iCopyEnd = std::min(iRangeEnd, iBlockEnd);
+
+            // the cipher blocks holding them
+            const std::uint64_t iDecStart =
+                iCopyStart - iCopyStart % iCipherBlockSize;
+            const std::uint64_t iDecEnd =
+                std::min(RoundNumberToBlock(iCopyEnd), iBlockEnd);
+            const std::uint64_t iDecSize = iDecEnd - iDecStart;
+
+            const bool bDirectOutput =
+                iDecStart == iCopyStart && iDecEnd == iCopyEnd;
+
+            std::uint8_t* pDecOut;
+
+            if (bDirectOutput == true)
+            {
+                pDecOut = pOutBuffer + (iCopyStart - iOffset);
+            }
+            else
+            {
+                // the output buffer cannot hold the bytes around the range
+                vBlock.resize(iDecSize);
+                pDecOut = vBlock.data();
+            }
+
+            decryptor.Decrypt(pInData + iDecStart, pDecOut, iDecSize);
+
+            // Only the first cipher block of the PKG block uses the null IV,
+            // the others are chained to the ciphertext before them
+            if (iDecStart != iBlockStart)
+            {
+                const std::uint8_t* pPrevCipherBlock =
+                    pInData + iDecStart - iCipherBlockSize;
+
+                for (std::uint64_t j = 0; j < iCipherBlockSize; j++)
+                {
+                    pDecOut[j] ^= pPrevCipherBlock[j];
+                }
+            }
+
+            if (bDirectOutput == false)
+            {
+                std::copy_n(vBlock.begin() + (iCopyStart - iDecStart),
+                            iCopyEnd - iCopyStart,
+                            pOutBuffer + (iCopyStart - iOffset));
+            }
+        }
+    };
+
+    // Since every block starts with a null IV, they can be decrypted
+    // independently from each other
+    if (this->m_pDecryptPool != nullptr && iBlocksNum > 1)
+    {
+        const std::uint64_t iTasksNum = std::min<std::uint64_t>(
+            this->m_pDecryptPool->GetThreadsNum(), iBlocksNum);
+        const std::uint64_t iBlocksPerTask =
+            (iBlocksNum + iTasksNum - 1) / iTasksNum;
+
+        this->m_pDecryptPool->ParallelFor(iTasksNum, [&](std::size_t iTask) {
+            const std::uint64_t iStartBlock =
+                iFirstBlock + iTask * iBlocksPerTask;
+            const std::uint64_t iEndBlock = std::min(
+                iStartBlock + iBlocksPerTask, iFirstBlock + iBlocksNum);
+            fnDecryptBlocks(iStartBlock, iEndBlock);
+        });
+    }
+    else
+    {
+        fnDecryptBlocks(iFirstBlock, iFirstBlock + iBlocksNum);
+    }
+}
+
+void PkgEntryImpl::DecryptDataInBuffer(std::uint8_t* pData,
+                                       const std::uint64_t iDataSize) const
+{
+    this->DecryptRange(pData, pData, 0, iDataSize);
+}
+
+void PkgEntryImpl::SetPkgFilename(
+    [[maybe_unused]] std::string_view szvPkgFilename)
+{
+#ifdef UNCSO2_TRACING
+    this->m_szvPkgFilename = szvPkgFilename;
+#endif
+}
+
 void PkgEntryImpl::SetDataBufferView(gsl::span<std::uint8_t> newDataView)
 {
     this->m_FileDataView = newDataView;
@@ -0,0 +1,251 @@
+#include "pkg/pkgentrycacheimpl.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "mappedfile.hpp"
+
+namespace uc2
+{
+constexpr const char PKG_ENTRY_CACHE_MAGIC[8] = { 'U', 'C', '2', 'E',
+                                                  'C', 'A', 'C', 'H' };
+constexpr const std::uint32_t PKG_ENTRY_CACHE_VERSION = 1;
+
+PkgEntryCache::ptr_t PkgEntryCache::Open(const std::filesystem::path& cachePath)
+{
+    return std::make_unique<PkgEntryCacheImpl>(cachePath);
+}
+
+PkgEntryCacheImpl::PkgEntryCacheImpl(const std::filesystem::path& cachePath)
+    : m_CachePath(cachePath), m_bHasNewTables(false)
+{
+    this->Load();
+}
+
+PkgEntryCacheImpl::~PkgEntryCacheImpl() {}
+
+void PkgEntryCacheImpl::Save()
+{
+    std::lock_guard<std::mutex> lock(this->m_TablesMutex);
+
+    if (this->m_bHasNewTables == false)
+    {
+        return;
+    }
+
+    std::vector<PkgEntryCacheArchive_t> vArchives;
+    vArchives.reserve(this->m_Tables.size());
+
+    std::uint64_t iCurOffset =
+        sizeof(PkgEntryCacheHeader_t) +
+        this->m_Tables.size() * sizeof(PkgEntryCacheArchive_t);
+
+    for (auto&& [szMd5Hash, table] : this->m_Tables)
+    {
+        PkgEntryCacheArchive_t archive{};
+        szMd5Hash.copy(archive.szMd5Hash, sizeof(archive.szMd5Hash) - 1);
+        archive.iFileSize = table.iFileSize;
+        archive.iDataStartOffset = table.iDataStartOffset;
+        archive.iEntriesOffset = iCurOffset;
+        archive.iEntries = table.Entries.size();
+
+        iCurOffset += table.Entries.size_bytes();
+        vArchives.push_back(archive);
+    }
+
+    PkgEntryCacheHeader_t header{};
+    std::copy_n(PKG_ENTRY_CACHE_MAGIC, sizeof(header.Magic), header.Magic);
+    header.iVersion = PKG_ENTRY_CACHE_VERSION;
+    header.iArchives = static_cast<std::uint32_t>(vArchives.size());
+
+    // write a new file and swap it in, so a failed save keeps the old cache
+    std::filesystem::path tempPath = this->m_CachePath;
+    tempPath += ".tmp";
+
+    {
+        std::ofstream os(tempPath, std::ios::binary | std::ios::trunc);
+
+        os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        os.write(reinterpret_cast<const char*>(vArchives.data()),
+                 vArchives.size() * sizeof(PkgEntryCacheArchive_t));
+
+        for (auto&& [szMd5Hash, table] : this->m_Tables)
+        {
+            os.write(reinterpret_cast<const char*>(table.Entries.data()),
+                     table.Entries.size_bytes());
+        }
+
+        if (os.good() == false)
+        {
+            throw std::runtime_error(
+                "libuncso2: Could not write the entry cache to " +
+                tempPath.string());
+        }
+    }
+
+    // the loaded tables point to the old file, which cannot be replaced
+    // while it's mapped on some systems
+    this->m_Tables.clear();
+    this->m_pMappedFile.reset();
+
+    try
+    {
+        std::filesystem::rename(tempPath, this->m_CachePath);
+    }
+    catch (const std::filesystem::filesystem_error&)
+    {
+        this->Load();
+        throw;
+    }
+
+    this->Load();
+}
+
+std::uint64_t PkgEntryCacheImpl::GetArchivesNum()
+{
+    std::lock_guard<std::mutex> lock(this->m_TablesMutex);
+    return this->m_Tables.size();
+}
+
+const PkgEntryCacheImpl::Table_t* PkgEntryCacheImpl::FindTable(
+    std::string_view szvMd5Hash, std::uint64_t iFileSize)
+{
+    std::lock_guard<std::mutex> lock(this->m_TablesMutex);
+
+    auto it = this->m_Tables.find(std::string(szvMd5Hash));
+
+    if (it == this->m_Tables.end() || it->second.iFileSize != iFileSize)
+    {
+        return nullptr;
+    }
+
+    return &it->second;
+}
+
+void PkgEntryCacheImpl::StoreTable(std::string_view szvMd5Hash,
+                                   std::uint64_t iFileSize,
+                                   std::uint64_t iDataStartOffset,
+                                   gsl::span<const PkgEntryHeader_t> entries)
+{
+    if (szvMd5Hash.empty() == true ||
+        szvMd5Hash.length() >= sizeof(PkgEntryCacheArchive_t::szMd5Hash))
+    {
+        return;
+    }
+
+    Table_t newTable;
+    newTable.iFileSize = iFileSize;
+    newTable.iDataStartOffset = iDataStartOffset;
+    newTable.vOwnedEntries.assign(entries.begin(), entries.end());
+    newTable.Entries = newTable.vOwnedEntries;
+
+    std::lock_guard<std::mutex> lock(this->m_TablesMutex);
+
+    auto it = this->m_Tables.find(std::string(szvMd5Hash));
+
+    if (it != this->m_Tables.end())
+    {
+        if (it->second.iFileSize == iFileSize)
+        {
+            return;
+        }
+
+        // other parsers may still be reading the old table, so keep its node
+        // alive instead of overwriting it
+        this->m_vRetiredTables.push_back(this->m_Tables.extract(it));
+    }
+
+    // moving the vector keeps its buffer, so the span stays valid
+    this->m_Tables.emplace(std::string(szvMd5Hash), std::move(newTable));
+    this->m_bHasNewTables = true;
+}
+
+void PkgEntryCacheImpl::Load()
+{
+    this->m_Tables.clear();
+    this->m_vRetiredTables.clear();
+    this->m_pMappedFile.reset();
+    this->m_bHasNewTables = false;
+
+    if (std::filesystem::exists(this->m_CachePath) == false)
+    {
+        return;
+    }
+
+    try
+    {
+        this->m_pMappedFile = std::make_unique<CMappedFile>(this->m_CachePath);
+    }
+    catch (const std::runtime_error&)
+    {
+        return;
+    }
+
+    if (this->LoadTables(this->m_pMappedFile->GetView()) == false)
+    {
+        this->m_Tables.clear();
+        this->m_pMappedFile.reset();
+    }
+}
+
+bool PkgEntryCacheImpl::LoadTables(gsl::span<const std::uint8_t> cacheData)
+{
+    if (cacheData.size() < sizeof(PkgEntryCacheHeader_t))
+    {
+        return false;
+    }
+
+    auto pHeader =
+        reinterpret_cast<const PkgEntryCacheHeader_t*>(cacheData.data());
+
+    if (std::memcmp(pHeader->Magic, PKG_ENTRY_CACHE_MAGIC,
+                    sizeof(pHeader->Magic)) != 0 ||
+        pHeader->iVersion != PKG_ENTRY_CACHE_VERSION)
+    {
+        return false;
+    }
+
+    const std::uint64_t iArchivesSize =
+        pHeader->iArchives * sizeof(PkgEntryCacheArchive_t);
+
+    if (cacheData.size() - sizeof(PkgEntryCacheHeader_t) < iArchivesSize)
+    {
+        return false;
+    }
+
+    auto pArchives = reinterpret_cast<const PkgEntryCacheArchive_t*>(
+        cacheData.data() + sizeof(PkgEntryCacheHeader_t));
+
+    for (std::uint32_t i = 0; i < pHeader->iArchives; i++)
+    {
+        const PkgEntryCacheArchive_t& archive = pArchives[i];
+
+        const auto pHashEnd =
+            std::find(std::begin(archive.szMd5Hash),
+                      std::end(archive.szMd5Hash), '\0');
+
+        if (pHashEnd == std::end(archive.szMd5Hash) ||
+            archive.iEntriesOffset > cacheData.size() ||
+            archive.iEntries > (cacheData.size() - archive.iEntriesOffset) /
+                                   sizeof(PkgEntryHeader_t))
+        {
+            return false;
+        }
+
+        Table_t table;
+        table.iFileSize = archive.iFileSize;
+        table.iDataStartOffset = archive.iDataStartOffset;
+        table.Entries = gsl::span<const PkgEntryHeader_t>(
+            reinterpret_cast<const PkgEntryHeader_t*>(cacheData.data() +
+                                                      archive.iEntriesOffset),
+            archive.iEntries);
+
+        this->m_Tables.insert_or_assign(
+            std::string(archive.szMd5Hash, pHashEnd), std::move(table));
+    }
+
+    return true;
+}
+}  // namespace uc2
@@ -0,0 +1,162 @@
+#include "pkg/pkgentryreaderimpl.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <io.h>
+#include <windows.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+#include "pkg/pkgentryimpl.hpp"
+#include "pkg/pkgstructures.hpp"
+
+namespace uc2
+{
+constexpr const std::uint64_t PKG_CIPHER_BLOCK_SIZE = 16;
+
+std::uint64_t PkgEntryReader::GetChunkSize()
+{
+    return PKG_DATA_BLOCK_SIZE;
+}
+
+PkgEntryReader::ptr_t PkgEntryReader::Create(PkgEntry& entry)
+{
+    return std::make_unique<PkgEntryReaderImpl>(
+        static_cast<PkgEntryImpl*>(&entry));
+}
+
+PkgEntryReader::ptr_t PkgEntryReader::CreateFromFile(PkgEntry& entry,
+                                                     int iFileDescriptor)
+{
+    if (iFileDescriptor < 0)
+    {
+        throw std::invalid_argument("libuncso2: Invalid file descriptor");
+    }
+
+    return std::make_unique<PkgEntryReaderImpl>(
+        static_cast<PkgEntryImpl*>(&entry), iFileDescriptor);
+}
+
+PkgEntryReaderImpl::PkgEntryReaderImpl(PkgEntryImpl* pEntry,
+                                       int iFileDescriptor /*= -1*/)
+    : m_pEntry(pEntry), m_iFileDescriptor(iFileDescriptor), m_iPosition(0),
+      m_vChunk(PKG_DATA_BLOCK_SIZE)
+{
+}
+
+PkgEntryReaderImpl::~PkgEntryReaderImpl() {}
+
+std::pair<const std::uint8_t*, std::uint64_t> PkgEntryReaderImpl::Next()
+{
+    const std::uint64_t iFileSize = this->m_pEntry->GetDecryptedSize();
+
+    if (this->m_iPosition >= iFileSize)
+    {
+        return { nullptr, 0 };
+    }
+
+    const std::uint64_t iChunkSize =
+        std::min(iFileSize - this->m_iPosition, PKG_DATA_BLOCK_SIZE);
+
+    if (this->m_iFileDescriptor == -1)
+    {
+        this->m_pEntry->ReadRange(this->m_iPosition, iChunkSize,
+                                  this->m_vChunk.data());
+    }
+    else if (this->m_pEntry->IsEncrypted() == true)
+    {
+        // the last chunk still needs its padding to be decrypted
+        const std::uint64_t iEncChunkSize =
+            (iChunkSize + PKG_CIPHER_BLOCK_SIZE - 1) / PKG_CIPHER_BLOCK_SIZE *
+            PKG_CIPHER_BLOCK_SIZE;
+
+        this->ReadFromFile(
+            this->m_pEntry->GetPkgFileOffset() + this->m_iPosition,
+            this->m_vChunk.data(), iEncChunkSize);
+        this->m_pEntry->DecryptDataInBuffer(this->m_vChunk.data(),
+                                            iEncChunkSize);
+    }
+    else
+    {
+        this->ReadFromFile(
+            this->m_pEntry->GetPkgFileOffset() + this->m_iPosition,
+            this->m_vChunk.data(), iChunkSize);
+    }
+
+    this->m_iPosition += iChunkSize;
+
+    return { this->m_vChunk.data(), iChunkSize };
+}
+
+std::uint64_t PkgEntryReaderImpl::GetPosition()
+{
+    return this->m_iPosition;
+}
+
+bool PkgEntryReaderImpl::IsFinished()
+{
+    return this->m_iPosition >= this->m_pEntry->GetDecryptedSize();
+}
+
+void PkgEntryReaderImpl::Rewind()
+{
+    this->m_iPosition = 0;
+}
+
+void PkgEntryReaderImpl::ReadFromFile(std::uint64_t iFileOffset,
+                                      std::uint8_t* pOutBuffer,
+                                      std::uint64_t iLength) const
+{
+    while (iLength > 0)
+    {
+#ifdef _WIN32
+        HANDLE hFile = reinterpret_cast<HANDLE>(
+            _get_osfhandle(this->m_iFileDescriptor));
+
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(iFileOffset);
+        overlapped.OffsetHigh = static_cast<DWORD>(iFileOffset >> 32);
+
+        // a DWORD can't hold lengths of 4 GiB or more
+        DWORD dwRead = 0;
+        const DWORD dwToRead = static_cast<DWORD>(
+            std::min<std::uint64_t>(iLength, MAXDWORD));
+
+        if (ReadFile(hFile, pOutBuffer, dwToRead, &dwRead, &overlapped) ==
+            FALSE)
+        {
+            dwRead = 0;
+        }
+
+        const std::int64_t iRead = dwRead;
+#else
+        const std::int64_t iRead =
+            pread(this->m_iFileDescriptor, pOutBuffer, iLength,
+                  static_cast<off_t>(iFileOffset));
+
+        // a signal interrupted the read before it got any data
+        if (iRead == -1 && errno == EINTR)
+        {
+            continue;
+        }
+#endif
+
+        if (iRead <= 0)
+        {
+            throw std::runtime_error(
+                "libuncso2: Could not read the entry's data from the file");
+        }
+
+        iFileOffset += iRead;
+        pOutBuffer += iRead;
+        iLength -= iRead;
+    }
+}
+}  // namespace uc2
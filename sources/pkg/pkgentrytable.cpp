@@ -0,0 +1,366 @@
+#include "pkg/pkgentrytable.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "pkg/pkgpath.hpp"
+
+namespace uc2
+{
+static inline std::string_view GetPoolString(
+    const std::string& szPool, const std::vector<std::uint32_t>& vOffsets,
+    std::size_t iIndex)
+{
+    const std::uint32_t iStart = vOffsets[iIndex];
+    const std::uint32_t iEnd = vOffsets[iIndex + 1];
+
+    return std::string_view(szPool).substr(iStart, iEnd - iStart);
+}
+
+// Compares two paths split in two pieces each, like strcmp does, after
+// normalizing their characters
+static int ComparePathPieces(
+    const std::pair<std::string_view, std::string_view>& pathA,
+    const std::pair<std::string_view, std::string_view>& pathB)
+{
+    const std::size_t iLengthA = pathA.first.length() + pathA.second.length();
+    const std::size_t iLengthB = pathB.first.length() + pathB.second.length();
+    const std::size_t iLength = std::min(iLengthA, iLengthB);
+
+    auto getChar = [](const std::pair<std::string_view, std::string_view>& path,
+                      std::size_t i) {
+        const char c = i < path.first.length() ?
+                           path.first[i] :
+                           path.second[i - path.first.length()];
+        return static_cast<std::uint8_t>(NormalizePathChar(c));
+    };
+
+    for (std::size_t i = 0; i < iLength; i++)
+    {
+        const std::uint8_t cA = getChar(pathA, i);
+        const std::uint8_t cB = getChar(pathB, i);
+
+        if (cA != cB)
+        {
+            return cA < cB ? -1 : 1;
+        }
+    }
+
+    return iLengthA < iLengthB ? -1 : (iLengthA > iLengthB ? 1 : 0);
+}
+
+CPkgEntryTable::CPkgEntryTable()
+    : m_iDataStartOffset(0), m_vDirectoryOffsets(1, 0),
+      m_vFileNameOffsets(1, 0)
+{
+}
+
+CPkgEntryTable::CPkgEntryTable(gsl::span<const PkgEntryHeader_t> entries,
+                               std::uint64_t iDataStartOffset)
+    : m_iDataStartOffset(iDataStartOffset)
+{
+    const std::size_t iEntriesNum = entries.size();
+
+    // every path is at most sizeof(PkgEntryHeader_t::szFilePath) long, so
+    // this keeps the pools' offsets in 32 bits
+    if (iEntriesNum > std::numeric_limits<std::uint32_t>::max() /
+                          sizeof(PkgEntryHeader_t::szFilePath))
+    {
+        throw std::range_error("libuncso2: The PKG has too many entries");
+    }
+
+    std::size_t iPathsSize = 0;
+
+    for (const PkgEntryHeader_t& entry : entries)
+    {
+        iPathsSize += strnlen(entry.szFilePath, sizeof(entry.szFilePath));
+    }
+
+    this->m_vOffsets.reserve(iEntriesNum);
+    this->m_vEncryptedSizes.reserve(iEntriesNum);
+    this->m_vDecryptedSizes.reserve(iEntriesNum);
+    this->m_vIsEncrypted.reserve(iEntriesNum);
+    this->m_vDirectoryIds.reserve(iEntriesNum);
+    this->m_vFileNameOffsets.reserve(iEntriesNum + 1);
+
+    // the directory pool never outgrows this, so the map's views into it
+    // stay valid while the pool is filled
+    this->m_szDirectoryPool.reserve(iPathsSize);
+    this->m_szFileNamePool.reserve(iPathsSize);
+
+    std::unordered_map<std::string_view, std::uint32_t> directoryIds;
+
+    for (const PkgEntryHeader_t& entry : entries)
+    {
+        // the packed fields are copied, since references to them would be
+        // misaligned
+        this->m_vOffsets.push_back(static_cast<std::uint32_t>(entry.iOffset));
+        this->m_vEncryptedSizes.push_back(
+            static_cast<std::uint32_t>(entry.iEncryptedSize));
+        this->m_vDecryptedSizes.push_back(
+            static_cast<std::uint32_t>(entry.iDecryptedSize));
+        this->m_vIsEncrypted.push_back(entry.bIsEncrypted != 0);
+
+        // the path may fill the whole field without a terminator
+        const std::string_view szvPath(
+            entry.szFilePath,
+            strnlen(entry.szFilePath, sizeof(entry.szFilePath)));
+
+        const std::size_t iLastSeparator = szvPath.find_last_of("/\\");
+        const std::size_t iNameStart =
+            iLastSeparator != std::string_view::npos ? iLastSeparator + 1 : 0;
+
+        const std::string_view szvDirectory = szvPath.substr(0, iNameStart);
+        auto it = directoryIds.find(szvDirectory);
+
+        if (it == directoryIds.end())
+        {
+            const auto iNewId =
+                static_cast<std::uint32_t>(this->m_vDirectoryOffsets.size());
+            const std::size_t iDirStart = this->m_szDirectoryPool.size();
+
+            this->m_vDirectoryOffsets.push_back(
+                static_cast<std::uint32_t>(iDirStart));
+            this->m_szDirectoryPool.append(szvDirectory);
+
+            const std::string_view szvPooled =
+                std::string_view(this->m_szDirectoryPool)
+                    .substr(iDirStart, szvDirectory.size());
+            it = directoryIds.emplace(szvPooled, iNewId).first;
+        }
+
+        this->m_vDirectoryIds.push_back(it->second);
+
+        this->m_vFileNameOffsets.push_back(
+            static_cast<std::uint32_t>(this->m_szFileNamePool.size()));
+        this->m_szFileNamePool.append(szvPath.substr(iNameStart));
+    }
+
+    this->m_vDirectoryOffsets.push_back(
+        static_cast<std::uint32_t>(this->m_szDirectoryPool.size()));
+    this->m_vFileNameOffsets.push_back(
+        static_cast<std::uint32_t>(this->m_szFileNamePool.size()));
+
+    // the pools were reserved for the worst case
+    this->m_szDirectoryPool.shrink_to_fit();
+    this->m_szFileNamePool.shrink_to_fit();
+    this->m_vDirectoryOffsets.shrink_to_fit();
+
+    this->BuildPathSlots();
+}
+
+std::size_t CPkgEntryTable::GetSize() const
+{
+    return this->m_vOffsets.size();
+}
+
+std::string CPkgEntryTable::GetFilePath(std::size_t iIndex) const
+{
+    const std::string_view szvDirectory = this->GetDirectory(iIndex);
+    const std::string_view szvFileName = this->GetFileName(iIndex);
+
+    std::string szPath;
+    szPath.reserve(szvDirectory.size() + szvFileName.size());
+    szPath = szvDirectory;
+    szPath += szvFileName;
+
+    return szPath;
+}
+
+std::string_view CPkgEntryTable::GetDirectory(std::size_t iIndex) const
+{
+    return GetPoolString(this->m_szDirectoryPool, this->m_vDirectoryOffsets,
+                         this->m_vDirectoryIds[iIndex]);
+}
+
+std::string_view CPkgEntryTable::GetFileName(std::size_t iIndex) const
+{
+    return GetPoolString(this->m_szFileNamePool, this->m_vFileNameOffsets,
+                         iIndex);
+}
+
+std::uint64_t CPkgEntryTable::GetPkgFileOffset(std::size_t iIndex) const
+{
+    return this->m_iDataStartOffset + this->m_vOffsets[iIndex];
+}
+
+std::uint64_t CPkgEntryTable::GetEncryptedSize(std::size_t iIndex) const
+{
+    return this->m_vEncryptedSizes[iIndex];
+}
+
+std::uint64_t CPkgEntryTable::GetDecryptedSize(std::size_t iIndex) const
+{
+    return this->m_vDecryptedSizes[iIndex];
+}
+
+bool CPkgEntryTable::IsEncrypted(std::size_t iIndex) const
+{
+    return this->m_vIsEncrypted[iIndex];
+}
+
+std::size_t CPkgEntryTable::FindPath(std::string_view szvPath) const
+{
+    if (this->m_vPathSlots.empty() == true)
+    {
+        return PKG_ENTRY_NOT_FOUND;
+    }
+
+    szvPath = SkipRootSeparators(szvPath);
+
+    const std::size_t iMask = this->m_vPathSlots.size() - 1;
+    std::size_t iSlot = HashPathChars(szvPath) & iMask;
+
+    while (this->m_vPathSlots[iSlot] != 0)
+    {
+        const std::size_t iIndex = this->m_vPathSlots[iSlot] - 1;
+
+        if (this->IsEntryPath(iIndex, szvPath) == true)
+        {
+            return iIndex;
+        }
+
+        iSlot = (iSlot + 1) & iMask;
+    }
+
+    return PKG_ENTRY_NOT_FOUND;
+}
+
+void CPkgEntryTable::FindPathsByPrefix(std::string_view szvPrefix,
+                                       std::vector<std::uint32_t>& vOutIndexes)
+{
+    if (this->m_vSortedIndexes.size() != this->GetSize())
+    {
+        this->BuildSortedIndexes();
+    }
+
+    const std::pair<std::string_view, std::string_view> prefix(
+        SkipRootSeparators(szvPrefix), std::string_view());
+
+    // the paths starting with the prefix are right after the paths smaller
+    // than the prefix
+    auto it = std::lower_bound(
+        this->m_vSortedIndexes.begin(), this->m_vSortedIndexes.end(), prefix,
+        [this](std::uint32_t iIndex,
+               const std::pair<std::string_view, std::string_view>& prefix) {
+            return ComparePathPieces(this->GetPathPieces(iIndex), prefix) < 0;
+        });
+
+    for (; it != this->m_vSortedIndexes.end(); it++)
+    {
+        auto [szvDirectory, szvFileName] = this->GetPathPieces(*it);
+
+        // compare only the path's first prefix.length() characters
+        const std::size_t iDirLength =
+            std::min(szvDirectory.length(), prefix.first.length());
+        szvDirectory = szvDirectory.substr(0, iDirLength);
+        szvFileName = szvFileName.substr(
+            0, std::min(szvFileName.length(),
+                        prefix.first.length() - iDirLength));
+
+        if (ComparePathPieces({ szvDirectory, szvFileName }, prefix) != 0)
+        {
+            break;
+        }
+
+        vOutIndexes.push_back(*it);
+    }
+}
+
+void CPkgEntryTable::BuildPathSlots()
+{
+    const std::size_t iEntriesNum = this->GetSize();
+
+    if (iEntriesNum == 0)
+    {
+        return;
+    }
+
+    // keep the load factor at or under one half, so the probes stay short
+    std::size_t iSlotsNum = 16;
+
+    while (iSlotsNum < iEntriesNum * 2)
+    {
+        iSlotsNum *= 2;
+    }
+
+    this->m_vPathSlots.assign(iSlotsNum, 0);
+
+    const std::size_t iMask = iSlotsNum - 1;
+
+    for (std::size_t i = 0; i < iEntriesNum; i++)
+    {
+        auto [szvDirectory, szvFileName] = this->GetPathPieces(i);
+        std::size_t iSlot =
+            HashPathChars(szvFileName, HashPathChars(szvDirectory)) & iMask;
+
+        bool bIsDuplicate = false;
+
+        while (this->m_vPathSlots[iSlot] != 0)
+        {
+            const std::size_t iOther = this->m_vPathSlots[iSlot] - 1;
+
+            if (ComparePathPieces(this->GetPathPieces(iOther),
+                                  { szvDirectory, szvFileName }) == 0)
+            {
+                bIsDuplicate = true;
+                break;
+            }
+
+            iSlot = (iSlot + 1) & iMask;
+        }
+
+        // the first entry with a path is the one found
+        if (bIsDuplicate == false)
+        {
+            this->m_vPathSlots[iSlot] = static_cast<std::uint32_t>(i + 1);
+        }
+    }
+}
+
+void CPkgEntryTable::BuildSortedIndexes()
+{
+    this->m_vSortedIndexes.resize(this->GetSize());
+
+    for (std::size_t i = 0; i < this->m_vSortedIndexes.size(); i++)
+    {
+        this->m_vSortedIndexes[i] = static_cast<std::uint32_t>(i);
+    }
+
+    // stable, so entries sharing a path stay in the table's order
+    std::stable_sort(this->m_vSortedIndexes.begin(),
+                     this->m_vSortedIndexes.end(),
+                     [this](std::uint32_t iIndexA, std::uint32_t iIndexB) {
+                         return ComparePathPieces(
+                                    this->GetPathPieces(iIndexA),
+                                    this->GetPathPieces(iIndexB)) < 0;
+                     });
+}
+
+std::pair<std::string_view, std::string_view> CPkgEntryTable::GetPathPieces(
+    std::size_t iIndex) const
+{
+    // file names never have separators, the directory holds all of them
+    return { SkipRootSeparators(this->GetDirectory(iIndex)),
+             this->GetFileName(iIndex) };
+}
+
+bool CPkgEntryTable::IsEntryPath(std::size_t iIndex,
+                                 std::string_view szvPath) const
+{
+    auto [szvDirectory, szvFileName] = this->GetPathPieces(iIndex);
+
+    if (szvPath.length() != szvDirectory.length() + szvFileName.length())
+    {
+        return false;
+    }
+
+    return ArePathCharsEqual(szvDirectory,
+                             szvPath.substr(0, szvDirectory.length())) &&
+           ArePathCharsEqual(szvFileName,
+                             szvPath.substr(szvDirectory.length()));
+}
+}  // namespace uc2
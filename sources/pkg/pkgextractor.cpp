@@ -0,0 +1,130 @@
+#include "pkg/pkgextractorimpl.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "pkgentry.hpp"
+#include "pkgentryreader.hpp"
+#include "pkgfile.hpp"
+#include "threadpool.hpp"
+
+namespace uc2
+{
+PkgExtractor::ptr_t PkgExtractor::Create(PkgFile& pkgFile,
+                                         std::uint32_t iThreadsNum /*= 0*/)
+{
+    return std::make_unique<PkgExtractorImpl>(&pkgFile, iThreadsNum);
+}
+
+PkgExtractorImpl::PkgExtractorImpl(PkgFile* pPkgFile,
+                                   std::uint32_t iThreadsNum)
+    : m_pPkgFile(pPkgFile)
+{
+    if (iThreadsNum == 0)
+    {
+        // hardware_concurrency may not know the number of cores
+        iThreadsNum = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    this->m_pPool = std::make_unique<CThreadPool>(iThreadsNum);
+}
+
+PkgExtractorImpl::~PkgExtractorImpl() {}
+
+std::uint64_t PkgExtractorImpl::ExtractAll(
+    const std::filesystem::path& outDirectory)
+{
+    auto& entries = this->m_pPkgFile->GetEntries();
+
+    std::vector<std::filesystem::path> vOutPaths;
+    vOutPaths.reserve(entries.size());
+
+    // create the directories beforehand, so the workers only write files
+    std::set<std::filesystem::path> parentDirs;
+
+    for (auto&& entry : entries)
+    {
+        vOutPaths.push_back(
+            PkgExtractorImpl::GetEntryOutPath(*entry, outDirectory));
+        parentDirs.insert(vOutPaths.back().parent_path());
+    }
+
+    for (auto&& dir : parentDirs)
+    {
+        std::filesystem::create_directories(dir);
+    }
+
+    // ParallelFor hands out the indexes in order, so the biggest entries
+    // start first and the small ones fill the gaps at the end
+    std::vector<std::size_t> vOrder(entries.size());
+    std::iota(vOrder.begin(), vOrder.end(), 0);
+    std::stable_sort(vOrder.begin(), vOrder.end(),
+                     [&entries](std::size_t a, std::size_t b) {
+                         return entries[a]->GetDecryptedSize() >
+                                entries[b]->GetDecryptedSize();
+                     });
+
+    this->m_pPool->ParallelFor(vOrder.size(), [&](std::size_t i) {
+        const std::size_t iEntry = vOrder[i];
+        PkgExtractorImpl::ExtractEntry(*entries[iEntry], vOutPaths[iEntry]);
+    });
+
+    return entries.size();
+}
+
+std::uint32_t PkgExtractorImpl::GetThreadsNum()
+{
+    return this->m_pPool->GetThreadsNum();
+}
+
+std::filesystem::path PkgExtractorImpl::GetEntryOutPath(
+    PkgEntry& entry, const std::filesystem::path& outDirectory)
+{
+    // the entries' paths start at the PKG's root directory
+    std::filesystem::path entryPath =
+        std::filesystem::path(entry.GetFilePath()).relative_path();
+
+    for (auto&& part : entryPath)
+    {
+        if (part == "..")
+        {
+            throw std::runtime_error(
+                "libuncso2: The entry's path leaves the output directory");
+        }
+    }
+
+    return outDirectory / entryPath;
+}
+
+void PkgExtractorImpl::ExtractEntry(PkgEntry& entry,
+                                    const std::filesystem::path& outPath)
+{
+    std::ofstream os(outPath, std::ios::binary | std::ios::trunc);
+
+    if (os.is_open() == false)
+    {
+        throw std::runtime_error("libuncso2: Could not create the file " +
+                                 outPath.string());
+    }
+
+    // write each chunk while it's still hot in the cache
+    auto pReader = PkgEntryReader::Create(entry);
+
+    for (auto [pChunk, iChunkSize] = pReader->Next(); iChunkSize != 0;
+         std::tie(pChunk, iChunkSize) = pReader->Next())
+    {
+        os.write(reinterpret_cast<const char*>(pChunk), iChunkSize);
+    }
+
+    if (os.good() == false)
+    {
+        throw std::runtime_error("libuncso2: Could not write the file " +
+                                 outPath.string());
+    }
+}
+}  // namespace uc2
@@ -1,12 +1,19 @@
 #include "pkg/pkgfileimpl.hpp"
 
+#include <cstring>
 #include <vector>
 
 #include "ciphers/aescipher.hpp"
 #include "decryptor.hpp"
 #include "keyhashes.hpp"
+#include "mappedfile.hpp"
+#include "pkg/pkgentrycacheimpl.hpp"
 #include "pkg/pkgentryimpl.hpp"
 #include "pkg/pkgfileoptionsimpl.hpp"
+#include "pkg/pkgpath.hpp"
+#include "statsimpl.hpp"
+#include "threadpool.hpp"
+#include "traceimpl.hpp"
 
 namespace uc2
 {
@@ -23,6 +30,16 @@ PkgFile::ptr_t PkgFile::Create(std::string szFilename,
                                          szDataKey, options);
 }
 
+PkgFile::ptr_t PkgFile::Open(const std::filesystem::path& pkgPath,
+                             std::string szEntryKey /*= {}*/,
+                             std::string szDataKey /*= {}*/,
+                             PkgFileOptions* options /*= nullptr*/)
+{
+    return std::make_unique<PkgFileImpl>(
+        std::make_unique<CMappedFile>(pkgPath), szEntryKey, szDataKey,
+        options);
+}
+
 std::uint64_t PkgFile::GetHeaderSize(bool bTfoPkg)
 {
     if (bTfoPkg == true)
@@ -68,11 +85,37 @@ PkgFileImpl::PkgFileImpl(std::string szFilename,
     this->Initialize(szEntryKey, pOptions);
 }
 
+PkgFileImpl::PkgFileImpl(std::unique_ptr<CMappedFile> pMappedFile,
+                         std::string szEntryKey /*= {}*/,
+                         std::string szDataKey /*= {}*/,
+                         PkgFileOptions* pOptions /* = nullptr*/)
+    : m_szFilename(pMappedFile->GetPath().filename().string()),
+      m_szHashedEntryKey(), m_szDataKey(szDataKey),
+      m_pMappedFile(std::move(pMappedFile)),
+      m_FileDataView(this->m_pMappedFile->GetView()), m_bParsed(false)
+{
+    this->Initialize(szEntryKey, pOptions);
+}
+
 PkgFileImpl::~PkgFileImpl() {}
 
 void PkgFileImpl::Initialize(std::string szEntryKey, PkgFileOptions* pOptions)
 {
     this->m_bIsTfoPkg = pOptions != nullptr ? pOptions->IsTfoPkg() : false;
+    this->m_bLazyEntries =
+        pOptions != nullptr ? pOptions->IsLazyEntries() : false;
+    this->m_pEntryCache =
+        pOptions != nullptr ?
+            static_cast<PkgEntryCacheImpl*>(pOptions->GetEntryCache()) :
+            nullptr;
+
+    const std::uint32_t iDecryptThreads =
+        pOptions != nullptr ? pOptions->GetDecryptThreads() : 1;
+
+    if (iDecryptThreads > 1)
+    {
+        this->m_pDecryptPool = std::make_unique<CThreadPool>(iDecryptThreads);
+    }
 
     if (this->m_bIsTfoPkg == true)
     {
@@ -148,18 +191,21 @@ void PkgFileImpl::SetTfoPkg(bool bNewState)
 void PkgFileImpl::SetDataBuffer(std::vector<std::uint8_t>& newFileData)
 {
     this->m_FileDataView = newFileData;
+    this->m_pMappedFile.reset();
     this->UpdateEntriesDataView();
 }
 
 void PkgFileImpl::SetDataBufferSpan(gsl::span<std::uint8_t> newDataBuffer)
 {
     this->m_FileDataView = newDataBuffer;
+    this->m_pMappedFile.reset();
     this->UpdateEntriesDataView();
 }
 
 void PkgFileImpl::ReleaseDataBuffer()
 {
     this->m_FileDataView = {};
+    this->m_pMappedFile.reset();
 }
 
 std::uint64_t PkgFileImpl::GetFullHeaderSize()
@@ -202,6 +248,8 @@ std::uint64_t PkgFileImpl::GetFullHeaderSizeInternal() const
 
 bool PkgFileImpl::DecryptHeader()
 {
+    UC2_TRACE_SPAN("PkgFile::DecryptHeader", this->m_szFilename);
+
     if (this->m_FileDataView.empty() == true)
     {
         throw std::runtime_error("The file data provided is empty.");
@@ -234,6 +282,8 @@ void PkgFileImpl::Parse()
         return;
     }
 
+    UC2_TRACE_SPAN("PkgFile::Parse", this->m_szFilename);
+
     if (this->m_FileDataView.empty() == true)
     {
         throw std::runtime_error("The file data provided is empty.");
@@ -251,9 +301,139 @@ void PkgFileImpl::Parse()
 
 std::vector<PkgFileImpl::entryptr_t>& PkgFileImpl::GetEntries()
 {
+    if (this->AreAllEntriesCreated() == true)
+    {
+        return this->m_Entries;
+    }
+
+    const std::size_t iEntriesNum = this->m_EntryTable.GetSize();
+    std::vector<entryptr_t> vNewEntries(iEntriesNum);
+
+    // create the missing entries first, so the created ones are left as they
+    // were if an entry is invalid
+    for (std::size_t i = 0; i < iEntriesNum; i++)
+    {
+        auto it = this->m_CreatedEntries.find(static_cast<std::uint32_t>(i));
+
+        if (it == this->m_CreatedEntries.end() || it->second == nullptr)
+        {
+            vNewEntries[i] = this->CreateEntry(i);
+        }
+    }
+
+    // the entries that were requested are kept, as they may be referenced
+    for (auto&& [iIndex, entry] : this->m_CreatedEntries)
+    {
+        if (entry != nullptr)
+        {
+            vNewEntries[iIndex] = std::move(entry);
+        }
+    }
+
+    this->m_CreatedEntries.clear();
+    this->m_Entries = std::move(vNewEntries);
+
     return this->m_Entries;
 }
 
+std::uint64_t PkgFileImpl::GetEntriesNum()
+{
+    return this->m_EntryTable.GetSize();
+}
+
+PkgEntry& PkgFileImpl::GetEntry(std::uint64_t iIndex)
+{
+    if (iIndex >= this->m_EntryTable.GetSize())
+    {
+        throw std::out_of_range("libuncso2: The entry index is out of range");
+    }
+
+    if (this->AreAllEntriesCreated() == true)
+    {
+        return *this->m_Entries[iIndex];
+    }
+
+    const auto iEntryIndex = static_cast<std::uint32_t>(iIndex);
+    auto it = this->m_CreatedEntries.find(iEntryIndex);
+
+    if (it != this->m_CreatedEntries.end())
+    {
+        return *it->second;
+    }
+
+    // only store the entry once it's created, CreateEntry throws if the
+    // entry is invalid
+    entryptr_t pNewEntry = this->CreateEntry(iIndex);
+    PkgEntry& newEntry = *pNewEntry;
+    this->m_CreatedEntries.emplace(iEntryIndex, std::move(pNewEntry));
+
+    return newEntry;
+}
+
+PkgEntry* PkgFileImpl::FindEntry(std::string_view szvPath)
+{
+    const std::size_t iIndex = this->m_EntryTable.FindPath(szvPath);
+
+    if (iIndex == PKG_ENTRY_NOT_FOUND)
+    {
+        return nullptr;
+    }
+
+    return &this->GetEntry(iIndex);
+}
+
+std::vector<PkgEntry*> PkgFileImpl::FindEntriesByPrefix(
+    std::string_view szvPrefix)
+{
+    std::vector<std::uint32_t> vIndexes;
+    this->m_EntryTable.FindPathsByPrefix(szvPrefix, vIndexes);
+
+    std::vector<PkgEntry*> vEntries;
+    vEntries.reserve(vIndexes.size());
+
+    for (std::uint32_t iIndex : vIndexes)
+    {
+        vEntries.push_back(&this->GetEntry(iIndex));
+    }
+
+    return vEntries;
+}
+
+std::vector<PkgEntry*> PkgFileImpl::ListDirectory(
+    std::string_view szvDirectory, bool bRecursive /*= false*/)
+{
+    std::string szPrefix(SkipRootSeparators(szvDirectory));
+
+    if (szPrefix.empty() == false && szPrefix.back() != '/' &&
+        szPrefix.back() != '\\')
+    {
+        szPrefix += '/';
+    }
+
+    std::vector<std::uint32_t> vIndexes;
+    this->m_EntryTable.FindPathsByPrefix(szPrefix, vIndexes);
+
+    std::vector<PkgEntry*> vEntries;
+
+    for (std::uint32_t iIndex : vIndexes)
+    {
+        // the entries right in the directory have it as their whole
+        // directory
+        const std::string_view szvEntryDirectory =
+            SkipRootSeparators(this->m_EntryTable.GetDirectory(iIndex));
+
+        if (bRecursive == false &&
+            szvEntryDirectory.length() != szPrefix.length())
+        {
+            continue;
+        }
+
+        vEntries.push_back(&this->GetEntry(iIndex));
+    }
+
+    return vEntries;
+}
+
 template <typename PkgHeaderType>
 bool PkgFileImpl::DecryptHeaderInternal()
 {
@@ -280,15 +460,34 @@ bool PkgFileImpl::DecryptHeaderInternal()
 template <typename PkgHeaderType>
 void PkgFileImpl::ParseEntries()
 {
+    this->m_szMd5Hash.assign(
+        reinterpret_cast<const char*>(this->m_FileDataView.data()),
+        strnlen(reinterpret_cast<const char*>(this->m_FileDataView.data()),
+                PKG_HEADER_SKIP_HASH_OFFSET));
+
+    const std::uint64_t iFileSize = this->m_FileDataView.size_bytes();
+
+    if (this->m_pEntryCache != nullptr)
+    {
+        auto pCachedTable =
+            this->m_pEntryCache->FindTable(this->m_szMd5Hash, iFileSize);
+
+        // the entry table was decrypted before, skip its decryption
+        if (pCachedTable != nullptr)
+        {
+            this->CreateEntries(pCachedTable->Entries,
+                                pCachedTable->iDataStartOffset);
+            this->m_bParsed = true;
+            return;
+        }
+    }
+
     if (this->IsHeaderDecryptedInternal<PkgHeaderType>() == false)
     {
         throw std::runtime_error("libuncso2: The header is encrypted, could "
                                  "not parse the PKG file.");
     }
 
-    this->m_szMd5Hash = reinterpret_cast<const char*>(
-        this->m_FileDataView.subspan(0, PKG_HEADER_SKIP_HASH_OFFSET).data());
-
     auto pPkgHeader = this->GetPkgHeader<PkgHeaderType>();
     auto pEntries = this->GetEntriesHeader<PkgHeaderType>();
 
@@ -299,29 +498,71 @@ void PkgFileImpl::ParseEntries()
     CAesCipher cipher;
     CDecryptor decryptor(&cipher, this->m_szHashedEntryKey, false);
 
-    for (std::uint32_t i = 0; i < pPkgHeader->iEntries; i++)
-    {
-        PkgEntryHeader_t* entry = &pEntries[i];
-        decryptor.DecryptInBuffer(entry, sizeof(PkgEntryHeader_t));
+    // every entry header is encrypted on its own, but they can all be
+    // decrypted with a single pass over the table
+    decryptor.DecryptRecordsInBuffer(pEntries, sizeof(PkgEntryHeader_t),
+                                     pPkgHeader->iEntries);
+
+    gsl::span<const PkgEntryHeader_t> entries(pEntries, pPkgHeader->iEntries);
 
-        auto pNewEntry = std::make_unique<PkgEntryImpl>(
-            entry->szFilePath, iDataStartOffset + entry->iOffset,
-            entry->iEncryptedSize, entry->iDecryptedSize, entry->bIsEncrypted,
-            this->m_FileDataView, this->m_szDataKey);
+    this->CreateEntries(entries, iDataStartOffset);
 
-        this->m_Entries.push_back(std::move(pNewEntry));
+    if (this->m_pEntryCache != nullptr)
+    {
+        this->m_pEntryCache->StoreTable(this->m_szMd5Hash, iFileSize,
+                                        iDataStartOffset, entries);
     }
 
     this->m_bParsed = true;
 }
 
+void PkgFileImpl::CreateEntries(gsl::span<const PkgEntryHeader_t> entries,
+                                std::uint64_t iDataStartOffset)
+{
+    this->m_EntryTable = CPkgEntryTable(entries, iDataStartOffset);
+
+    AddStat(StatsCounter::EntriesParsed, entries.size());
+
+    // lazy entries are created when they're first requested
+    if (this->m_bLazyEntries == false)
+    {
+        this->GetEntries();
+    }
+}
+
+PkgFileImpl::entryptr_t PkgFileImpl::CreateEntry(std::size_t iIndex) const
+{
+    const CPkgEntryTable& table = this->m_EntryTable;
+
+    auto pEntry = std::make_unique<PkgEntryImpl>(
+        table.GetFilePath(iIndex), table.GetPkgFileOffset(iIndex),
+        table.GetEncryptedSize(iIndex), table.GetDecryptedSize(iIndex),
+        table.IsEncrypted(iIndex), this->m_FileDataView, this->m_szDataKey,
+        this->m_pDecryptPool.get());
+    pEntry->SetPkgFilename(this->m_szFilename);
+
+    return pEntry;
+}
+
+bool PkgFileImpl::AreAllEntriesCreated() const
+{
+    return this->m_Entries.size() == this->m_EntryTable.GetSize();
+}
+
 void PkgFileImpl::UpdateEntriesDataView()
 {
+    // lazy entries get the current view when they're created
     for (auto&& entry : this->m_Entries)
     {
         auto pEntryImpl = static_cast<PkgEntryImpl*>(entry.get());
         pEntryImpl->SetDataBufferView(this->m_FileDataView);
     }
+
+    for (auto&& [iIndex, entry] : this->m_CreatedEntries)
+    {
+        auto pEntryImpl = static_cast<PkgEntryImpl*>(entry.get());
+        pEntryImpl->SetDataBufferView(this->m_FileDataView);
+    }
 }
 
 template <typename PkgHeaderType>
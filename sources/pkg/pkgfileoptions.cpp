@@ -7,7 +7,11 @@ PkgFileOptions::ptr_t PkgFileOptions::Create()
     return std::make_unique<PkgFileOptionsImpl>();
 }
 
-PkgFileOptionsImpl::PkgFileOptionsImpl() : m_bIsTfoPkg(false) {}
+PkgFileOptionsImpl::PkgFileOptionsImpl()
+    : m_bIsTfoPkg(false), m_iDecryptThreads(1), m_pEntryCache(nullptr),
+      m_bLazyEntries(false)
+{
+}
 
 PkgFileOptionsImpl::~PkgFileOptionsImpl() {}
 
@@ -20,4 +24,34 @@ bool PkgFileOptionsImpl::IsTfoPkg()
 {
     return m_bIsTfoPkg;
 }
+
+void PkgFileOptionsImpl::SetDecryptThreads(std::uint32_t iThreadsNum)
+{
+    this->m_iDecryptThreads = iThreadsNum;
+}
+
+std::uint32_t PkgFileOptionsImpl::GetDecryptThreads()
+{
+    return this->m_iDecryptThreads;
+}
+
+void PkgFileOptionsImpl::SetEntryCache(PkgEntryCache* pCache)
+{
+    this->m_pEntryCache = pCache;
+}
+
+PkgEntryCache* PkgFileOptionsImpl::GetEntryCache()
+{
+    return this->m_pEntryCache;
+}
+
+void PkgFileOptionsImpl::SetLazyEntries(bool bNewState)
+{
+    this->m_bLazyEntries = bNewState;
+}
+
+bool PkgFileOptionsImpl::IsLazyEntries()
+{
+    return this->m_bLazyEntries;
+}
 }  // namespace uc2
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include "pkg/pkgfilesystemimpl.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "pkg/pkgpath.hpp"
+#include "pkgentry.hpp"
+#include "pkgindex.hpp"
+
+namespace uc2
+{
+constexpr const std::size_t PKG_FS_MIN_SLOTS = 64;
+
+PkgFileSystem::ptr_t PkgFileSystem::Create()
+{
+    return std::make_unique<PkgFileSystemImpl>();
+}
+
+PkgFileSystemImpl::PkgFileSystemImpl() : m_iUsedSlots(0) {}
+
+PkgFileSystemImpl::~PkgFileSystemImpl() {}
+
+void PkgFileSystemImpl::AddArchive(PkgFile::ptr_t&& pkgFile)
+{
+    if (pkgFile->DecryptHeader() == false)
+    {
+        throw std::runtime_error(
+            "libuncso2: Could not decrypt the PKG file's header");
+    }
+
+    pkgFile->Parse();
+
+    auto& vEntries = pkgFile->GetEntries();
+
+    // allocate everything before the first insertion, so a failure can't
+    // leave slots pointing to a PKG file that the file system doesn't own
+    this->m_Archives.reserve(this->m_Archives.size() + 1);
+
+    while ((this->m_iUsedSlots + vEntries.size()) * 2 > this->m_Slots.size())
+    {
+        this->Grow();
+    }
+
+    const auto iArchive = static_cast<std::uint32_t>(this->m_Archives.size());
+
+    for (auto&& entry : vEntries)
+    {
+        this->Insert(entry.get(), iArchive);
+    }
+
+    this->m_Archives.push_back(std::move(pkgFile));
+}
+
+std::uint64_t PkgFileSystemImpl::AddIndex(
+    PkgIndex& index, const std::filesystem::path& pkgDirectory,
+    std::string szEntryKey, std::string szDataKey,
+    PkgFileOptions* options /*= nullptr*/)
+{
+    auto& vFilenames = index.GetFilenames();
+    std::uint64_t iAddedNum = 0;
+
+    // the first file name is the index's own
+    for (std::size_t i = 1; i < vFilenames.size(); i++)
+    {
+        const std::filesystem::path pkgPath = pkgDirectory / vFilenames[i];
+
+        if (std::filesystem::exists(pkgPath) == false)
+        {
+            continue;
+        }
+
+        this->AddArchive(
+            PkgFile::Open(pkgPath, szEntryKey, szDataKey, options));
+        iAddedNum++;
+    }
+
+    return iAddedNum;
+}
+
+std::pair<PkgFile*, PkgEntry*> PkgFileSystemImpl::Find(
+    std::string_view szvPath)
+{
+    if (this->m_iUsedSlots == 0)
+    {
+        return { nullptr, nullptr };
+    }
+
+    const Slot_t& slot =
+        this->m_Slots[this->FindSlot(szvPath, HashPath(szvPath))];
+
+    if (slot.pEntry == nullptr)
+    {
+        return { nullptr, nullptr };
+    }
+
+    return { this->m_Archives[slot.iArchive].get(), slot.pEntry };
+}
+
+PkgEntry* PkgFileSystemImpl::FindEntry(std::string_view szvPath)
+{
+    return this->Find(szvPath).second;
+}
+
+std::uint64_t PkgFileSystemImpl::GetArchivesNum()
+{
+    return this->m_Archives.size();
+}
+
+std::uint64_t PkgFileSystemImpl::GetEntriesNum()
+{
+    return this->m_iUsedSlots;
+}
+
+void PkgFileSystemImpl::Insert(PkgEntry* pEntry, std::uint32_t iArchive)
+{
+    // keep the load factor at or under one half, so the probes stay short
+    if ((this->m_iUsedSlots + 1) * 2 > this->m_Slots.size())
+    {
+        this->Grow();
+    }
+
+    const std::string_view szvPath = pEntry->GetFilePath();
+    const std::uint64_t iHash = HashPath(szvPath);
+
+    Slot_t& slot = this->m_Slots[this->FindSlot(szvPath, iHash)];
+
+    if (slot.pEntry == nullptr)
+    {
+        this->m_iUsedSlots++;
+    }
+
+    slot = { iHash, pEntry, iArchive };
+}
+
+void PkgFileSystemImpl::Grow()
+{
+    std::vector<Slot_t> vOldSlots = std::move(this->m_Slots);
+
+    const std::size_t iNewSize =
+        std::max(vOldSlots.size() * 2, PKG_FS_MIN_SLOTS);
+    this->m_Slots.assign(iNewSize, Slot_t{ 0, nullptr, 0 });
+
+    const std::size_t iMask = iNewSize - 1;
+
+    // the paths are unique already, only look for an empty slot
+    for (auto&& oldSlot : vOldSlots)
+    {
+        if (oldSlot.pEntry == nullptr)
+        {
+            continue;
+        }
+
+        std::size_t iIndex = oldSlot.iHash & iMask;
+
+        while (this->m_Slots[iIndex].pEntry != nullptr)
+        {
+            iIndex = (iIndex + 1) & iMask;
+        }
+
+        this->m_Slots[iIndex] = oldSlot;
+    }
+}
+
+std::size_t PkgFileSystemImpl::FindSlot(std::string_view szvPath,
+                                        std::uint64_t iHash) const
+{
+    const std::size_t iMask = this->m_Slots.size() - 1;
+    std::size_t iIndex = iHash & iMask;
+
+    while (true)
+    {
+        const Slot_t& slot = this->m_Slots[iIndex];
+
+        if (slot.pEntry == nullptr)
+        {
+            return iIndex;
+        }
+
+        if (slot.iHash == iHash &&
+            ArePathsEqual(slot.pEntry->GetFilePath(), szvPath) == true)
+        {
+            return iIndex;
+        }
+
+        iIndex = (iIndex + 1) & iMask;
+    }
+}
+}  // namespace uc2
\ No newline at end of file
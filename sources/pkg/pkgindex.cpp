@@ -5,38 +5,14 @@
 #include "decryptor.hpp"
 #include "keyhashes.hpp"
 #include "pkg/pkgstructures.hpp"
+#include "textlines.hpp"
+#include "traceimpl.hpp"
 #include "util.hpp"
 
 namespace uc2
 {
 constexpr const std::uint16_t SUPPORTED_PKG_VERSION = 2;
 
-std::vector<std::string_view> SplitTextFileByLine(
-    gsl::span<std::uint8_t> fileBuffer)
-{
-    constexpr std::string_view szNewLine("\r\n", 2);
-
-    std::vector<std::string_view> vFilenames;
-
-    std::string_view szPkgBuffer(
-        reinterpret_cast<const char*>(fileBuffer.data()), fileBuffer.size());
-    std::uint64_t iCurrentPos = 0;
-    std::uint64_t iLineEndPos = 0;
-
-    while ((iLineEndPos = szPkgBuffer.find(szNewLine, iCurrentPos)) !=
-           std::string::npos)
-    {
-        auto strBase = AddOffsetToBase<char>(szPkgBuffer.data(), iCurrentPos);
-        std::string_view szvEntry(strBase, iLineEndPos - iCurrentPos);
-
-        vFilenames.push_back(szvEntry);
-
-        iCurrentPos = iLineEndPos + szNewLine.length();
-    }
-
-    return vFilenames;
-}
-
 PkgIndex::ptr_t PkgIndex::Create(
     std::string_view indexFilename, std::vector<std::uint8_t>& fileData,
     const std::uint8_t (*keyCollection)[4][16] /* = nullptr */)
@@ -116,6 +92,8 @@ void PkgIndexImpl::ValidateHeader()
 
 std::uint64_t PkgIndexImpl::Parse()
 {
+    UC2_TRACE_SPAN("PkgIndex::Parse", this->m_szvIndexFilename);
+
     if (this->m_bHeaderValidated == false)
     {
         throw std::runtime_error("The header was not validated.");
@@ -137,9 +115,11 @@ std::uint64_t PkgIndexImpl::Parse()
         decryptor.DecryptInBuffer(pDataStart, pHeader->iFileSize);
 
     this->m_vFilenames =
-        SplitTextFileByLine({ pDataStart, pHeader->iFileSize });
+        SplitTextByLine({ reinterpret_cast<const char*>(pDataStart),
+                          pHeader->iFileSize });
 
-    if (this->m_vFilenames[0] != this->m_szvIndexFilename)
+    if (this->m_vFilenames.empty() == true ||
+        this->m_vFilenames[0] != this->m_szvIndexFilename)
     {
         this->m_vFilenames.clear();
         throw std::runtime_error("Failed to decrypt the index file.");
@@ -0,0 +1,144 @@
+#include "stats.hpp"
+#include "statsimpl.hpp"
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <vector>
+
+namespace uc2
+{
+constexpr const std::size_t STATS_COUNTERS_NUM =
+    static_cast<std::size_t>(StatsCounter::Count);
+
+using StatsCounters_t =
+    std::array<std::atomic<std::uint64_t>, STATS_COUNTERS_NUM>;
+using StatsTotals_t = std::array<std::uint64_t, STATS_COUNTERS_NUM>;
+
+std::atomic<bool> g_bStatsEnabled = false;
+
+struct ThreadStats_t;
+
+// the counters of every running thread, and the sums of the exited ones
+static std::mutex g_StatsMutex;
+static std::vector<ThreadStats_t*> g_vThreadStats;
+static StatsTotals_t g_ExitedThreadsStats = {};
+
+// A thread's counters, registered when the thread first updates them
+struct ThreadStats_t
+{
+    ThreadStats_t()
+    {
+        for (auto&& value : this->Counters)
+        {
+            value.store(0, std::memory_order_relaxed);
+        }
+
+        std::lock_guard<std::mutex> lock(g_StatsMutex);
+        g_vThreadStats.push_back(this);
+    }
+
+    ~ThreadStats_t()
+    {
+        std::lock_guard<std::mutex> lock(g_StatsMutex);
+
+        for (std::size_t i = 0; i < STATS_COUNTERS_NUM; i++)
+        {
+            g_ExitedThreadsStats[i] += this->GetSinceReset(i);
+        }
+
+        g_vThreadStats.erase(
+            std::find(g_vThreadStats.begin(), g_vThreadStats.end(), this));
+    }
+
+    // g_StatsMutex must be held
+    std::uint64_t GetSinceReset(std::size_t iCounter) const
+    {
+        return this->Counters[iCounter].load(std::memory_order_relaxed) -
+               this->Baseline[iCounter];
+    }
+
+    // only written to by its thread
+    StatsCounters_t Counters;
+    // the counters' values at the last reset, guarded by g_StatsMutex
+    StatsTotals_t Baseline = {};
+};
+
+void AddThreadStat(StatsCounter counter, std::uint64_t iValue)
+{
+    static thread_local ThreadStats_t threadStats;
+
+    std::atomic<std::uint64_t>& value =
+        threadStats.Counters[static_cast<std::size_t>(counter)];
+
+    // only this thread writes to its counters, so there's no need for an
+    // atomic read-modify-write
+    value.store(value.load(std::memory_order_relaxed) + iValue,
+                std::memory_order_relaxed);
+}
+
+Stats Stats::Get()
+{
+    StatsTotals_t totals;
+
+    {
+        std::lock_guard<std::mutex> lock(g_StatsMutex);
+
+        totals = g_ExitedThreadsStats;
+
+        for (const ThreadStats_t* pThreadStats : g_vThreadStats)
+        {
+            for (std::size_t i = 0; i < STATS_COUNTERS_NUM; i++)
+            {
+                totals[i] += pThreadStats->GetSinceReset(i);
+            }
+        }
+    }
+
+    auto getTotal = [&totals](StatsCounter counter) {
+        return totals[static_cast<std::size_t>(counter)];
+    };
+
+    Stats stats;
+    stats.iDesBytesDecrypted = getTotal(StatsCounter::DesBytesDecrypted);
+    stats.iAesBytesDecrypted = getTotal(StatsCounter::AesBytesDecrypted);
+    stats.iBlowfishBytesDecrypted =
+        getTotal(StatsCounter::BlowfishBytesDecrypted);
+    stats.iBlocksDecrypted = getTotal(StatsCounter::BlocksDecrypted);
+    stats.iEntriesParsed = getTotal(StatsCounter::EntriesParsed);
+    stats.iKeysDerived = getTotal(StatsCounter::KeysDerived);
+    stats.iLzmaChunksDecoded = getTotal(StatsCounter::LzmaChunksDecoded);
+    stats.iDecryptNs = getTotal(StatsCounter::DecryptNs);
+    stats.iKeyDerivationNs = getTotal(StatsCounter::KeyDerivationNs);
+    stats.iLzmaNs = getTotal(StatsCounter::LzmaNs);
+    return stats;
+}
+
+void Stats::Reset()
+{
+    std::lock_guard<std::mutex> lock(g_StatsMutex);
+
+    g_ExitedThreadsStats.fill(0);
+
+    // the counters are only written to by their own threads, so remember
+    // their current values instead of zeroing them
+    for (ThreadStats_t* pThreadStats : g_vThreadStats)
+    {
+        for (std::size_t i = 0; i < STATS_COUNTERS_NUM; i++)
+        {
+            pThreadStats->Baseline[i] =
+                pThreadStats->Counters[i].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Stats::SetEnabled(bool bEnabled)
+{
+    g_bStatsEnabled.store(bEnabled, std::memory_order_relaxed);
+}
+
+bool Stats::IsEnabled()
+{
+    return AreStatsEnabled();
+}
+}  // namespace uc2
@@ -0,0 +1,114 @@
+#include "textlines.hpp"
+
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define UC2_TEXTLINES_SSE2
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace uc2
+{
+inline std::size_t CountTrailingZeros(std::uint32_t iMask)
+{
+#ifdef _MSC_VER
+    unsigned long iBit;
+    _BitScanForward(&iBit, iMask);
+    return iBit;
+#else
+    return static_cast<std::size_t>(__builtin_ctz(iMask));
+#endif
+}
+
+// A line ends at every '\n' preceded by a '\r'. A '\r' before the start of the
+// current line is always the previous line's separator, so the byte before the
+// '\n' is enough to know if it ends a line
+template <typename Func>
+inline void ScanLineFeeds(const char* pText, std::size_t iLength,
+                          Func onLineFeed)
+{
+    std::size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i vLineFeed = _mm256_set1_epi8('\n');
+
+    for (; i + sizeof(__m256i) <= iLength; i += sizeof(__m256i))
+    {
+        const __m256i vChars =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pText + i));
+        std::uint32_t iMask = static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(vChars, vLineFeed)));
+
+        while (iMask != 0)
+        {
+            onLineFeed(i + CountTrailingZeros(iMask));
+            iMask &= iMask - 1;
+        }
+    }
+#elif defined(UC2_TEXTLINES_SSE2)
+    const __m128i vLineFeed = _mm_set1_epi8('\n');
+
+    for (; i + sizeof(__m128i) <= iLength; i += sizeof(__m128i))
+    {
+        const __m128i vChars =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(pText + i));
+        std::uint32_t iMask = static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(vChars, vLineFeed)));
+
+        while (iMask != 0)
+        {
+            onLineFeed(i + CountTrailingZeros(iMask));
+            iMask &= iMask - 1;
+        }
+    }
+#endif
+
+    for (; i < iLength; i++)
+    {
+        if (pText[i] == '\n')
+        {
+            onLineFeed(i);
+        }
+    }
+}
+
+std::vector<std::string_view> SplitTextByLine(std::string_view szvText)
+{
+    const char* pText = szvText.data();
+    std::size_t iLinesNum = 0;
+
+    ScanLineFeeds(pText, szvText.length(), [&](std::size_t iPos) {
+        if (iPos != 0 && pText[iPos - 1] == '\r')
+        {
+            iLinesNum++;
+        }
+    });
+
+    std::vector<std::string_view> vLines;
+
+    if (iLinesNum == 0)
+    {
+        return vLines;
+    }
+
+    vLines.reserve(iLinesNum);
+    std::size_t iLineStart = 0;
+
+    ScanLineFeeds(pText, szvText.length(), [&](std::size_t iPos) {
+        if (iPos > iLineStart && pText[iPos - 1] == '\r')
+        {
+            vLines.emplace_back(pText + iLineStart, iPos - 1 - iLineStart);
+            iLineStart = iPos + 1;
+        }
+    });
+
+    return vLines;
+}
+}  // namespace uc2
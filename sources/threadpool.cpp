@@ -0,0 +1,169 @@
+#include "threadpool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace uc2
+{
+CThreadPool::CThreadPool(std::uint32_t iThreadsNum) : m_bStopping(false)
+{
+    // the thread calling ParallelFor also does work, so spawn one less worker
+    for (std::uint32_t i = 1; i < iThreadsNum; i++)
+    {
+        this->m_Workers.emplace_back(&CThreadPool::WorkerLoop, this);
+    }
+}
+
+CThreadPool::~CThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->m_TasksMutex);
+        this->m_bStopping = true;
+    }
+
+    this->m_TaskAvailable.notify_all();
+
+    for (auto&& worker : this->m_Workers)
+    {
+        worker.join();
+    }
+}
+
+std::uint32_t CThreadPool::GetThreadsNum() const
+{
+    return static_cast<std::uint32_t>(this->m_Workers.size()) + 1;
+}
+
+void CThreadPool::ParallelFor(std::size_t iCount,
+                              const std::function<void(std::size_t)>& fn)
+{
+    this->ParallelFor(iCount, this->GetThreadsNum(), fn);
+}
+
+void CThreadPool::ParallelFor(std::size_t iCount, std::uint32_t iMaxThreads,
+                              const std::function<void(std::size_t)>& fn)
+{
+    if (iCount == 0)
+    {
+        return;
+    }
+
+    // The state is shared with the helper tasks, since a helper may only get
+    // to run after this call has returned
+    struct ForState_t
+    {
+        const std::function<void(std::size_t)>* pFunction;
+        std::size_t iCount;
+        std::atomic<std::size_t> iNextIndex;
+
+        std::mutex Mutex;
+        std::condition_variable HelpersDone;
+        std::size_t iRunningHelpers;
+        std::exception_ptr pException;
+    };
+
+    auto pState = std::make_shared<ForState_t>();
+    pState->pFunction = &fn;
+    pState->iCount = iCount;
+    pState->iNextIndex = 0;
+    pState->iRunningHelpers = 0;
+
+    auto fnRunIndexes = [](ForState_t& state) {
+        std::size_t iIndex;
+
+        while ((iIndex = state.iNextIndex.fetch_add(1)) < state.iCount)
+        {
+            try
+            {
+                (*state.pFunction)(iIndex);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(state.Mutex);
+
+                if (state.pException == nullptr)
+                {
+                    state.pException = std::current_exception();
+                }
+
+                // don't hand out any more indexes
+                state.iNextIndex = state.iCount;
+            }
+        }
+    };
+
+    const std::size_t iHelpersNum =
+        std::min({ this->m_Workers.size(), iCount - 1,
+                   static_cast<std::size_t>(std::max(iMaxThreads, 1u) - 1) });
+
+    for (std::size_t i = 0; i < iHelpersNum; i++)
+    {
+        this->Enqueue([pState, fnRunIndexes]() {
+            {
+                std::lock_guard<std::mutex> lock(pState->Mutex);
+                pState->iRunningHelpers++;
+            }
+
+            fnRunIndexes(*pState);
+
+            {
+                std::lock_guard<std::mutex> lock(pState->Mutex);
+                pState->iRunningHelpers--;
+            }
+
+            pState->HelpersDone.notify_all();
+        });
+    }
+
+    fnRunIndexes(*pState);
+
+    // Only wait for the helpers that have started running, the ones still in
+    // the queue won't find any index left to process
+    std::unique_lock<std::mutex> lock(pState->Mutex);
+    pState->HelpersDone.wait(
+        lock, [&pState]() { return pState->iRunningHelpers == 0; });
+
+    if (pState->pException != nullptr)
+    {
+        std::rethrow_exception(pState->pException);
+    }
+}
+
+void CThreadPool::Enqueue(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->m_TasksMutex);
+        this->m_Tasks.push(std::move(task));
+    }
+
+    this->m_TaskAvailable.notify_one();
+}
+
+void CThreadPool::WorkerLoop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(this->m_TasksMutex);
+            this->m_TaskAvailable.wait(lock, [this]() {
+                return this->m_bStopping == true ||
+                       this->m_Tasks.empty() == false;
+            });
+
+            if (this->m_Tasks.empty() == true)
+            {
+                return;
+            }
+
+            task = std::move(this->m_Tasks.front());
+            this->m_Tasks.pop();
+        }
+
+        task();
+    }
+}
+}  // namespace uc2
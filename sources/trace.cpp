@@ -0,0 +1,391 @@
+#include "trace.hpp"
+#include "traceimpl.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace uc2
+{
+#ifdef UNCSO2_TRACING
+// how many of its latest events each thread keeps, must be a power of two
+constexpr const std::uint64_t TRACE_EVENTS_PER_THREAD = 2048;
+// the file and path arguments' maximum length, with the null terminator
+constexpr const std::size_t TRACE_TEXT_WORDS = 8;
+constexpr const std::size_t TRACE_TEXT_MAX_LEN =
+    TRACE_TEXT_WORDS * sizeof(std::uint64_t);
+// the buffers of exited threads are dropped after this many buffers
+constexpr const std::size_t TRACE_MAX_BUFFERS = 256;
+
+static_assert((TRACE_EVENTS_PER_THREAD & (TRACE_EVENTS_PER_THREAD - 1)) == 0,
+              "The events per thread must be a power of two");
+
+using TraceText_t = std::array<std::atomic<std::uint64_t>, TRACE_TEXT_WORDS>;
+
+// Every member is atomic, so the events can be read while they're being
+// overwritten. A torn read is detected by the sequence number.
+struct TraceEvent_t
+{
+    // the event's index times two, plus one while it's being written and
+    // plus two after it's written
+    std::atomic<std::uint64_t> iSequence;
+    std::atomic<std::uint64_t> iTimestampNs;
+    std::atomic<const char*> szName;
+    std::atomic<char> cPhase;
+    TraceText_t File;
+    TraceText_t Path;
+};
+
+// A copy of an event, taken while writing the trace
+struct TraceEventCopy_t
+{
+    std::uint64_t iTimestampNs;
+    const char* szName;
+    char cPhase;
+    std::string szFile;
+    std::string szPath;
+};
+
+static const auto g_TraceEpoch = std::chrono::steady_clock::now();
+
+// Stores the end of szvText, which is the most specific part of a path
+static void StoreTraceText(TraceText_t& outText, std::string_view szvText)
+{
+    if (szvText.length() >= TRACE_TEXT_MAX_LEN)
+    {
+        szvText.remove_prefix(szvText.length() - TRACE_TEXT_MAX_LEN + 1);
+
+        // don't start in the middle of a UTF-8 character
+        while (szvText.empty() == false &&
+               (static_cast<unsigned char>(szvText.front()) & 0xC0) == 0x80)
+        {
+            szvText.remove_prefix(1);
+        }
+    }
+
+    std::array<char, TRACE_TEXT_MAX_LEN> szText = {};
+    std::copy(szvText.begin(), szvText.end(), szText.begin());
+
+    for (std::size_t i = 0; i < TRACE_TEXT_WORDS; i++)
+    {
+        std::uint64_t iWord;
+        std::memcpy(&iWord, szText.data() + i * sizeof(iWord), sizeof(iWord));
+        outText[i].store(iWord, std::memory_order_relaxed);
+    }
+}
+
+static std::string LoadTraceText(const TraceText_t& text)
+{
+    std::array<char, TRACE_TEXT_MAX_LEN> szText;
+
+    for (std::size_t i = 0; i < TRACE_TEXT_WORDS; i++)
+    {
+        const std::uint64_t iWord = text[i].load(std::memory_order_relaxed);
+        std::memcpy(szText.data() + i * sizeof(iWord), &iWord, sizeof(iWord));
+    }
+
+    return std::string(szText.data(), strnlen(szText.data(), szText.size()));
+}
+
+// A thread's ring buffer of events. Only its thread records events, so
+// recording doesn't need any lock.
+class CTraceBuffer
+{
+public:
+    explicit CTraceBuffer(std::uint32_t iThreadId)
+        : m_iThreadId(iThreadId), m_iHead(0), m_iFirstVisible(0),
+          m_bThreadExited(false),
+          m_pEvents(std::make_unique<TraceEvent_t[]>(TRACE_EVENTS_PER_THREAD))
+    {
+        for (std::uint64_t i = 0; i < TRACE_EVENTS_PER_THREAD; i++)
+        {
+            this->m_pEvents[i].iSequence.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void Record(char cPhase, const char* szName, std::string_view szvFile,
+                std::string_view szvPath)
+    {
+        const std::uint64_t iIndex =
+            this->m_iHead.load(std::memory_order_relaxed);
+        TraceEvent_t& event =
+            this->m_pEvents[iIndex & (TRACE_EVENTS_PER_THREAD - 1)];
+
+        const auto elapsed = std::chrono::steady_clock::now() - g_TraceEpoch;
+
+        event.iSequence.store(iIndex * 2 + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        event.iTimestampNs.store(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                .count(),
+            std::memory_order_relaxed);
+        event.szName.store(szName, std::memory_order_relaxed);
+        event.cPhase.store(cPhase, std::memory_order_relaxed);
+        StoreTraceText(event.File, szvFile);
+        StoreTraceText(event.Path, szvPath);
+
+        event.iSequence.store(iIndex * 2 + 2, std::memory_order_release);
+        this->m_iHead.store(iIndex + 1, std::memory_order_release);
+    }
+
+    // Copies the events that weren't overwritten while being copied
+    void CopyEvents(std::vector<TraceEventCopy_t>& vOutEvents) const
+    {
+        const std::uint64_t iHead =
+            this->m_iHead.load(std::memory_order_acquire);
+        const std::uint64_t iFirst = std::max(
+            this->m_iFirstVisible.load(std::memory_order_relaxed),
+            iHead > TRACE_EVENTS_PER_THREAD ? iHead - TRACE_EVENTS_PER_THREAD :
+                                              0);
+
+        for (std::uint64_t i = iFirst; i < iHead; i++)
+        {
+            const TraceEvent_t& event =
+                this->m_pEvents[i & (TRACE_EVENTS_PER_THREAD - 1)];
+
+            const std::uint64_t iSequence =
+                event.iSequence.load(std::memory_order_acquire);
+
+            if (iSequence != i * 2 + 2)
+            {
+                continue;
+            }
+
+            TraceEventCopy_t copy{
+                event.iTimestampNs.load(std::memory_order_relaxed),
+                event.szName.load(std::memory_order_relaxed),
+                event.cPhase.load(std::memory_order_relaxed),
+                LoadTraceText(event.File), LoadTraceText(event.Path)
+            };
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // the event was overwritten while it was copied
+            if (event.iSequence.load(std::memory_order_relaxed) != iSequence)
+            {
+                continue;
+            }
+
+            vOutEvents.push_back(std::move(copy));
+        }
+    }
+
+    // Hides the events recorded until now
+    void Clear()
+    {
+        this->m_iFirstVisible.store(
+            this->m_iHead.load(std::memory_order_acquire),
+            std::memory_order_relaxed);
+    }
+
+    std::uint32_t GetThreadId() const { return this->m_iThreadId; }
+
+    bool HasThreadExited() const
+    {
+        return this->m_bThreadExited.load(std::memory_order_relaxed);
+    }
+
+    void SetThreadExited()
+    {
+        this->m_bThreadExited.store(true, std::memory_order_relaxed);
+    }
+
+private:
+    const std::uint32_t m_iThreadId;
+    std::atomic<std::uint64_t> m_iHead;
+    std::atomic<std::uint64_t> m_iFirstVisible;
+    std::atomic<bool> m_bThreadExited;
+    std::unique_ptr<TraceEvent_t[]> m_pEvents;
+};
+
+// the buffers are kept after their threads exit, so a dump shows what
+// the exited workers did
+static std::mutex g_TraceMutex;
+static std::vector<std::shared_ptr<CTraceBuffer>> g_vTraceBuffers;
+static std::uint32_t g_iNextTraceThreadId = 1;
+
+// Registers a thread's buffer when it first records an event
+struct ThreadTrace_t
+{
+    ThreadTrace_t()
+    {
+        std::lock_guard<std::mutex> lock(g_TraceMutex);
+
+        // drop the oldest exited thread's buffer if there are too many
+        if (g_vTraceBuffers.size() >= TRACE_MAX_BUFFERS)
+        {
+            auto it = std::find_if(g_vTraceBuffers.begin(),
+                                   g_vTraceBuffers.end(), [](auto&& pBuffer) {
+                                       return pBuffer->HasThreadExited();
+                                   });
+
+            if (it != g_vTraceBuffers.end())
+            {
+                g_vTraceBuffers.erase(it);
+            }
+        }
+
+        this->pBuffer =
+            std::make_shared<CTraceBuffer>(g_iNextTraceThreadId++);
+        g_vTraceBuffers.push_back(this->pBuffer);
+    }
+
+    ~ThreadTrace_t() { this->pBuffer->SetThreadExited(); }
+
+    std::shared_ptr<CTraceBuffer> pBuffer;
+};
+
+static CTraceBuffer& GetThreadTraceBuffer()
+{
+    static thread_local ThreadTrace_t threadTrace;
+    return *threadTrace.pBuffer;
+}
+
+CTraceSpan::CTraceSpan(const char* szName, std::string_view szvFile /*= {}*/,
+                       std::string_view szvPath /*= {}*/)
+    : m_szName(szName)
+{
+    GetThreadTraceBuffer().Record('B', szName, szvFile, szvPath);
+}
+
+CTraceSpan::~CTraceSpan()
+{
+    GetThreadTraceBuffer().Record('E', this->m_szName, {}, {});
+}
+
+static void WriteJsonString(std::ostream& os, std::string_view szvText)
+{
+    constexpr const char szHexDigits[] = "0123456789abcdef";
+
+    os << '"';
+
+    for (const char c : szvText)
+    {
+        if (c == '"' || c == '\\')
+        {
+            os << '\\' << c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            os << "\\u00" << szHexDigits[c >> 4] << szHexDigits[c & 0xF];
+        }
+        else
+        {
+            os << c;
+        }
+    }
+
+    os << '"';
+}
+
+static void WriteTraceEvent(std::ostream& os, const TraceEventCopy_t& event,
+                            std::uint32_t iThreadId)
+{
+    // the timestamps are in microseconds
+    os << "{\"name\":";
+    WriteJsonString(os, event.szName);
+    os << ",\"ph\":\"" << event.cPhase << "\",\"ts\":"
+       << event.iTimestampNs / 1000 << '.' << event.iTimestampNs / 100 % 10
+       << event.iTimestampNs / 10 % 10 << event.iTimestampNs % 10
+       << ",\"pid\":1,\"tid\":" << iThreadId;
+
+    if (event.szFile.empty() == false || event.szPath.empty() == false)
+    {
+        os << ",\"args\":{\"file\":";
+        WriteJsonString(os, event.szFile);
+        os << ",\"path\":";
+        WriteJsonString(os, event.szPath);
+        os << '}';
+    }
+
+    os << '}';
+}
+#endif
+
+bool Trace::IsAvailable()
+{
+#ifdef UNCSO2_TRACING
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool Trace::WriteChromeTrace([[maybe_unused]] std::ostream& os)
+{
+#ifdef UNCSO2_TRACING
+    std::vector<std::shared_ptr<CTraceBuffer>> vBuffers;
+
+    {
+        std::lock_guard<std::mutex> lock(g_TraceMutex);
+        vBuffers = g_vTraceBuffers;
+    }
+
+    os << "{\"traceEvents\":[\n"
+       << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+          "\"args\":{\"name\":\"libuncso2\"}}";
+
+    std::vector<TraceEventCopy_t> vEvents;
+
+    for (auto&& pBuffer : vBuffers)
+    {
+        vEvents.clear();
+        pBuffer->CopyEvents(vEvents);
+
+        for (const TraceEventCopy_t& event : vEvents)
+        {
+            os << ",\n";
+            WriteTraceEvent(os, event, pBuffer->GetThreadId());
+        }
+    }
+
+    os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+    return os.good();
+#else
+    return false;
+#endif
+}
+
+bool Trace::DumpChromeTrace(const std::filesystem::path& tracePath)
+{
+    if (Trace::IsAvailable() == false)
+    {
+        return false;
+    }
+
+    std::ofstream os(tracePath, std::ios::trunc);
+
+    if (os.is_open() == false)
+    {
+        return false;
+    }
+
+    return Trace::WriteChromeTrace(os);
+}
+
+void Trace::Clear()
+{
+#ifdef UNCSO2_TRACING
+    std::lock_guard<std::mutex> lock(g_TraceMutex);
+
+    g_vTraceBuffers.erase(
+        std::remove_if(g_vTraceBuffers.begin(), g_vTraceBuffers.end(),
+                       [](auto&& pBuffer) { return pBuffer->HasThreadExited(); }),
+        g_vTraceBuffers.end());
+
+    for (auto&& pBuffer : g_vTraceBuffers)
+    {
+        pBuffer->Clear();
+    }
+#endif
+}
+}  // namespace uc2
@@ -1,8 +1,10 @@
 #include <catch2/catch.hpp>
 
+#include <clocale>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <string>
 #include <string_view>
 
 #include <uc2/uc2.h>
@@ -49,6 +51,50 @@ TEST_CASE("Can decrypt .e* files", "[encfile]")
     }
 }
 
+TEST_CASE("Can decrypt .e* files to another buffer", "[encfile]")
+{
+    SECTION("Decrypting .e* file without modifying its data")
+    {
+        for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+        {
+            auto [bWasRead, vFileBuffer] =
+                ReadFileToBuffer(cso2::EncryptedFileNames[i]);
+
+            REQUIRE(bWasRead == true);
+            REQUIRE(vFileBuffer.empty() == false);
+
+            const std::vector<std::uint8_t> vOriginalBuffer = vFileBuffer;
+
+            try
+            {
+                auto pEncryptedFile = uc2::EncryptedFile::Create(
+                    cso2::RealEncryptedFileNames[i], vFileBuffer,
+                    cso2::IndexKeyCollections[i]);
+
+                std::vector<std::uint8_t> vOutBuffer(
+                    vFileBuffer.size() - uc2::EncryptedFile::GetHeaderSize());
+
+                // decrypting it twice must give the same data
+                for (std::size_t y = 0; y < 2; y++)
+                {
+                    std::size_t iOutSize = pEncryptedFile->DecryptTo(
+                        vOutBuffer.data(), vOutBuffer.size());
+
+                    REQUIRE(GetDataHash(vOutBuffer.data(), iOutSize) ==
+                            cso2::EncryptedFileHashes[i]);
+                }
+
+                REQUIRE(vFileBuffer == vOriginalBuffer);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << e.what() << '\n';
+                throw e;
+            }
+        }
+    }
+}
+
 TEST_CASE("Can decrypt .e* files with C bindings", "[encfile]")
 {
     SECTION("Decrypting .e* file")
@@ -84,3 +130,170 @@ TEST_CASE("Can decrypt .e* files with C bindings", "[encfile]")
         }
     }
 }
+
+TEST_CASE("Can parse decrypted .e* tables", "[encfile]")
+{
+    SECTION("Parsing a table from text")
+    {
+        constexpr std::string_view szvTable =
+            "id,name,rate\r\n"
+            "1,\"first, \"\"quoted\"\"\",0.5\r\n"
+            "\r\n"
+            "-2,second,\r\n"sv;
+
+        try
+        {
+            auto pTable = uc2::EncryptedTable::Create(szvTable);
+
+            REQUIRE(pTable->GetRowsNum() == 3);
+            REQUIRE(pTable->GetColumnsNum(0) == 3);
+            REQUIRE(pTable->FindColumn("name") == 1);
+            REQUIRE(pTable->FindColumn("missing") ==
+                    uc2::EncryptedTable::COLUMN_NOT_FOUND);
+
+            REQUIRE(pTable->GetCell(1, 1) == "first, \"\"quoted\"\""sv);
+            REQUIRE(pTable->GetCellInteger(1, 0) == 1);
+            REQUIRE(pTable->GetCellFloat(1, 2) == 0.5);
+            REQUIRE(pTable->GetCellInteger(2, 0) == -2);
+            REQUIRE(pTable->GetCell(2, 2).empty() == true);
+
+            REQUIRE_THROWS_AS(pTable->GetCellInteger(2, 1),
+                              std::invalid_argument);
+            REQUIRE_THROWS_AS(pTable->GetCell(3, 0), std::out_of_range);
+            REQUIRE_THROWS_AS(pTable->GetCell(0, 3), std::out_of_range);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << '\n';
+            throw e;
+        }
+    }
+
+    SECTION("Parsing floating point cells in any locale")
+    {
+        constexpr std::string_view szvTable =
+            "0.5,-1.25e3,1e-310,1e-400,1e400, 1\r\n"sv;
+
+        // restores the locale even if a requirement fails
+        struct LocaleGuard_t
+        {
+            std::string szOldLocale = std::setlocale(LC_ALL, nullptr);
+            ~LocaleGuard_t() { std::setlocale(LC_ALL, szOldLocale.c_str()); }
+        } localeGuard;
+
+        // a locale whose decimal point is a comma, if one is installed
+        for (const char* szLocale :
+             { "de_DE.UTF-8", "de_DE.utf8", "de_DE", "German_Germany.1252",
+               "pt_PT.UTF-8", "fr_FR.UTF-8" })
+        {
+            if (std::setlocale(LC_ALL, szLocale) != nullptr)
+            {
+                break;
+            }
+        }
+
+        try
+        {
+            auto pTable = uc2::EncryptedTable::Create(szvTable);
+
+            REQUIRE(pTable->GetCellFloat(0, 0) == 0.5);
+            REQUIRE(pTable->GetCellFloat(0, 1) == -1250.0);
+
+            // subnormal numbers and underflows are fine, overflows are not
+            REQUIRE(pTable->GetCellFloat(0, 2) == 1e-310);
+            REQUIRE(pTable->GetCellFloat(0, 3) >= 0.0);
+            REQUIRE(pTable->GetCellFloat(0, 3) < 1e-300);
+            REQUIRE_THROWS_AS(pTable->GetCellFloat(0, 4),
+                              std::invalid_argument);
+
+            REQUIRE_THROWS_AS(pTable->GetCellFloat(0, 5),
+                              std::invalid_argument);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << '\n';
+            throw e;
+        }
+    }
+
+    SECTION("Parsing a decrypted .e* file")
+    {
+        for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+        {
+            auto [bWasRead, vFileBuffer] =
+                ReadFileToBuffer(cso2::EncryptedFileNames[i]);
+
+            REQUIRE(bWasRead == true);
+            REQUIRE(vFileBuffer.empty() == false);
+
+            try
+            {
+                auto pEncryptedFile = uc2::EncryptedFile::Create(
+                    cso2::RealEncryptedFileNames[i], vFileBuffer,
+                    cso2::IndexKeyCollections[i]);
+                auto pTable = uc2::EncryptedTable::Create(*pEncryptedFile);
+
+                REQUIRE(pTable->GetRowsNum() != 0);
+
+                // every cell must point inside the decrypted file
+                const char* pBufferStart =
+                    reinterpret_cast<const char*>(vFileBuffer.data());
+                const char* pBufferEnd = pBufferStart + vFileBuffer.size();
+
+                for (std::uint64_t r = 0; r < pTable->GetRowsNum(); r++)
+                {
+                    for (std::uint64_t c = 0; c < pTable->GetColumnsNum(r);
+                         c++)
+                    {
+                        std::string_view szvCell = pTable->GetCell(r, c);
+                        REQUIRE(szvCell.data() >= pBufferStart);
+                        REQUIRE(szvCell.data() + szvCell.length() <=
+                                pBufferEnd);
+                    }
+                }
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << e.what() << '\n';
+                throw e;
+            }
+        }
+    }
+}
+
+TEST_CASE("Can parse decrypted .e* tables with C bindings", "[encfile]")
+{
+    SECTION("Parsing a decrypted .e* file")
+    {
+        for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+        {
+            auto [bWasRead, vFileBuffer] =
+                ReadFileToBuffer(cso2::EncryptedFileNames[i]);
+
+            REQUIRE(bWasRead == true);
+            REQUIRE(vFileBuffer.empty() == false);
+
+            EncryptedFile_t pFile = uncso2_EncryptedFile_Create(
+                cso2::RealEncryptedFileNames[i].data(), vFileBuffer.data(),
+                vFileBuffer.size(), &cso2::IndexKeyCollections[i]);
+            REQUIRE(pFile != nullptr);
+
+            EncryptedTable_t pTable = uncso2_EncryptedTable_Create(pFile, ',');
+            REQUIRE(pTable != nullptr);
+
+            REQUIRE(uncso2_EncryptedTable_GetRowsNum(pTable) != 0);
+            REQUIRE(uncso2_EncryptedTable_GetColumnsNum(pTable, 0) != 0);
+
+            const char* pCell = nullptr;
+            std::uint64_t iCellSize = 0;
+            bool bGotCell =
+                uncso2_EncryptedTable_GetCell(pTable, 0, 0, &pCell, &iCellSize);
+
+            REQUIRE(bGotCell == true);
+            REQUIRE(pCell != nullptr);
+
+            uncso2_EncryptedTable_Free(pTable);
+            uncso2_EncryptedFile_Free(pFile);
+        }
+    }
+}
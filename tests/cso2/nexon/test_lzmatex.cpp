@@ -9,10 +9,28 @@
 #include <uc2/uc2.hpp>
 
 #include "cso2/nexon/settings.hpp"
+#include "synthetic.hpp"
 #include "utils.hpp"
 
 using namespace std::literals::string_view_literals;
 
+constexpr const std::string_view TEXTURES_PKG_NAME = "synthetic_textures.pkg";
+
+// The game PKGs used by the tests may not have any LZMA texture, so the
+// textures read from PKG entries also come from a synthetic PKG. Its
+// textures have a few chunks each, and some of them are encrypted.
+static std::vector<std::uint8_t> BuildTexturesPkg()
+{
+    SyntheticPkgOptions_t options;
+    options.iEntriesNum = 8;
+    options.iMinFileSize = 100 * 1024;
+    options.iMaxFileSize = 400 * 1024;
+    options.fEncryptedRatio = 0.5;
+    options.fTextureRatio = 1.0;
+
+    return BuildSyntheticPkg(TEXTURES_PKG_NAME, options);
+}
+
 TEST_CASE("Can decompress LZMA'd VTFs", "[lzmavtf]")
 {
     SECTION("Decompressing texture file")
@@ -47,6 +65,225 @@ TEST_CASE("Can decompress LZMA'd VTFs", "[lzmavtf]")
             throw e;
         }
     }
+
+    SECTION("Decompressing texture file in parallel")
+    {
+        auto [bWasRead, vTexBuffer] = ReadFileToBuffer(cso2::TextureFilename);
+
+        REQUIRE(bWasRead == true);
+        REQUIRE(vTexBuffer.empty() == false);
+
+        try
+        {
+            auto pTex = uc2::LzmaTexture::Create(vTexBuffer);
+
+            std::uint64_t iOrigSize = pTex->GetOriginalSize();
+            REQUIRE(iOrigSize != 0);
+
+            for (std::uint32_t iThreadsNum : { 0u, 1u, 4u })
+            {
+                std::vector<std::uint8_t> buff(iOrigSize);
+                bool bDecompressed = pTex->DecompressParallel(
+                    buff.data(), buff.size(), iThreadsNum);
+
+                REQUIRE(bDecompressed == true);
+                REQUIRE(GetDataHash(buff.data(), buff.size()) ==
+                        cso2::TextureFileHash);
+            }
+
+            // the buffer must still have the texture's exact size
+            std::vector<std::uint8_t> smallBuff(iOrigSize - 1);
+            REQUIRE(pTex->DecompressParallel(smallBuff.data(),
+                                             smallBuff.size()) == false);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << '\n';
+            throw e;
+        }
+    }
+
+    SECTION("Decompressing texture file piece by piece")
+    {
+        auto [bWasRead, vTexBuffer] = ReadFileToBuffer(cso2::TextureFilename);
+
+        REQUIRE(bWasRead == true);
+        REQUIRE(vTexBuffer.empty() == false);
+
+        try
+        {
+            auto pReader = uc2::LzmaTextureReader::Create(vTexBuffer.data(),
+                                                          vTexBuffer.size());
+
+            std::uint64_t iOrigSize = pReader->GetOriginalSize();
+            REQUIRE(iOrigSize != 0);
+
+            std::vector<std::uint8_t> buff;
+
+            for (auto [pWindow, iWindowSize] = pReader->Next();
+                 iWindowSize != 0;
+                 std::tie(pWindow, iWindowSize) = pReader->Next())
+            {
+                REQUIRE(iWindowSize <= uc2::LzmaTextureReader::GetWindowSize());
+                buff.insert(buff.end(), pWindow, pWindow + iWindowSize);
+            }
+
+            REQUIRE(pReader->IsFinished() == true);
+            REQUIRE(pReader->GetPosition() == iOrigSize);
+            REQUIRE(GetDataHash(buff.data(), buff.size()) ==
+                    cso2::TextureFileHash);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << '\n';
+            throw e;
+        }
+    }
+
+    SECTION("Decompressing textures from PKG entries piece by piece")
+    {
+        try
+        {
+            std::vector<std::uint8_t> vPkgBuffer = BuildTexturesPkg();
+
+            auto pPkgFile = uc2::PkgFile::Create(
+                std::string(TEXTURES_PKG_NAME), vPkgBuffer,
+                std::string(SYNTHETIC_ENTRY_KEY),
+                std::string(SYNTHETIC_DATA_KEY));
+
+            REQUIRE(pPkgFile->DecryptHeader() == true);
+            pPkgFile->Parse();
+
+            REQUIRE(pPkgFile->GetEntries().empty() == false);
+
+            for (auto&& entry : pPkgFile->GetEntries())
+            {
+                std::vector<std::uint8_t> vEntryData(entry->GetDecryptedSize());
+                entry->DecryptFileTo(vEntryData.data(), vEntryData.size());
+
+                auto pTex = uc2::LzmaTexture::Create(vEntryData);
+                std::vector<std::uint8_t> vExpected(pTex->GetOriginalSize());
+                REQUIRE(pTex->Decompress(vExpected.data(), vExpected.size()) ==
+                        true);
+
+                // the texture is read from the entry one chunk at a time
+                auto pEntryReader = uc2::PkgEntryReader::Create(*entry);
+                auto pReader = uc2::LzmaTextureReader::Create(*pEntryReader);
+
+                REQUIRE(pReader->GetOriginalSize() == vExpected.size());
+
+                std::vector<std::uint8_t> buff;
+
+                for (auto [pWindow, iWindowSize] = pReader->Next();
+                     iWindowSize != 0;
+                     std::tie(pWindow, iWindowSize) = pReader->Next())
+                {
+                    REQUIRE(iWindowSize <=
+                            uc2::LzmaTextureReader::GetWindowSize());
+                    buff.insert(buff.end(), pWindow, pWindow + iWindowSize);
+                }
+
+                REQUIRE(pReader->IsFinished() == true);
+                REQUIRE(buff == vExpected);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << '\n';
+            throw e;
+        }
+    }
+
+    SECTION("Decompressing textures from PKG entries")
+    {
+        // decompresses every texture of the PKG, and returns how many it has
+        auto fnDecompressTextures = [](uc2::PkgFile& pkgFile) {
+            std::size_t iTexturesNum = 0;
+
+            pkgFile.DecryptHeader();
+            pkgFile.Parse();
+
+            for (auto&& entry : pkgFile.GetEntries())
+            {
+                std::vector<std::uint8_t> vEntryData(entry->GetDecryptedSize());
+                entry->ReadRange(0, vEntryData.size(), vEntryData.data());
+
+                if (uc2::LzmaTexture::IsLzmaTexture(
+                        vEntryData.data(), vEntryData.size()) == false)
+                {
+                    REQUIRE_THROWS_AS(uc2::LzmaTexture::Create(*entry),
+                                      std::invalid_argument);
+                    continue;
+                }
+
+                auto pTex = uc2::LzmaTexture::Create(vEntryData);
+                std::vector<std::uint8_t> vExpected(pTex->GetOriginalSize());
+                REQUIRE(pTex->Decompress(vExpected.data(), vExpected.size()) ==
+                        true);
+
+                // the entry is decrypted while it is decompressed
+                for (std::uint32_t iThreadsNum : { 0u, 1u, 4u })
+                {
+                    auto pEntryTex = uc2::LzmaTexture::Create(*entry);
+                    std::vector<std::uint8_t> buff(
+                        pEntryTex->GetOriginalSize());
+
+                    REQUIRE(pEntryTex->DecompressParallel(
+                                buff.data(), buff.size(), iThreadsNum) == true);
+                    REQUIRE(buff == vExpected);
+                }
+
+                iTexturesNum++;
+            }
+
+            return iTexturesNum;
+        };
+
+        std::size_t iTexturesFound = 0;
+
+        for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+        {
+            auto [bWasRead, vFileBuffer] =
+                ReadFileToBuffer(cso2::PkgFilenames[i]);
+
+            REQUIRE(bWasRead == true);
+            REQUIRE(vFileBuffer.empty() == false);
+
+            try
+            {
+                auto pPkgFile = uc2::PkgFile::Create(
+                    cso2::PkgFilenames[i], vFileBuffer,
+                    cso2::PackageEntryKeys[i], cso2::PackageFileKeys[i]);
+
+                iTexturesFound += fnDecompressTextures(*pPkgFile);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << e.what() << '\n';
+                throw e;
+            }
+        }
+
+        try
+        {
+            std::vector<std::uint8_t> vPkgBuffer = BuildTexturesPkg();
+
+            auto pPkgFile = uc2::PkgFile::Create(
+                std::string(TEXTURES_PKG_NAME), vPkgBuffer,
+                std::string(SYNTHETIC_ENTRY_KEY),
+                std::string(SYNTHETIC_DATA_KEY));
+
+            iTexturesFound += fnDecompressTextures(*pPkgFile);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << '\n';
+            throw e;
+        }
+
+        // otherwise the fused decryption and decompression never ran
+        REQUIRE(iTexturesFound > 0);
+    }
 }
 
 TEST_CASE("Can decompress LZMA'd VTFs with C bindings", "[lzmavtf]")
@@ -80,7 +317,191 @@ TEST_CASE("Can decompress LZMA'd VTFs with C bindings", "[lzmavtf]")
         REQUIRE(GetDataHash(reinterpret_cast<std::uint8_t*>(pOutBuf),
                             iOrigSize) == cso2::TextureFileHash);
 
+        bWasDecompressed = uncso2_LzmaTexture_DecompressParallel(
+            pTexture, pOutBuf, iOrigSize, 0);
+
+        REQUIRE(bWasDecompressed == true);
+        REQUIRE(GetDataHash(reinterpret_cast<std::uint8_t*>(pOutBuf),
+                            iOrigSize) == cso2::TextureFileHash);
+
         free(pOutBuf);
         uncso2_LzmaTexture_Free(pTexture);
     }
+
+    SECTION("Decompressing texture file piece by piece")
+    {
+        auto [bWasRead, vTexBuffer] = ReadFileToBuffer(cso2::TextureFilename);
+
+        REQUIRE(bWasRead == true);
+        REQUIRE(vTexBuffer.empty() == false);
+
+        LzmaTextureReader_t pReader = uncso2_LzmaTextureReader_Create(
+            vTexBuffer.data(), vTexBuffer.size());
+        REQUIRE(pReader != nullptr);
+
+        std::uint64_t iOrigSize =
+            uncso2_LzmaTextureReader_GetOriginalSize(pReader);
+        REQUIRE(iOrigSize != 0);
+
+        std::vector<std::uint8_t> buff;
+        const void* pWindow = nullptr;
+        std::uint64_t iWindowSize = 0;
+
+        do
+        {
+            REQUIRE(uncso2_LzmaTextureReader_Next(pReader, &pWindow,
+                                                  &iWindowSize) == true);
+
+            auto pWindowBytes = static_cast<const std::uint8_t*>(pWindow);
+            buff.insert(buff.end(), pWindowBytes, pWindowBytes + iWindowSize);
+        } while (iWindowSize != 0);
+
+        REQUIRE(buff.size() == iOrigSize);
+        REQUIRE(GetDataHash(buff.data(), buff.size()) == cso2::TextureFileHash);
+
+        uncso2_LzmaTextureReader_Free(pReader);
+    }
+
+    SECTION("Decompressing textures from PKG entries piece by piece")
+    {
+        std::vector<std::uint8_t> vPkgBuffer = BuildTexturesPkg();
+        const std::string szPkgName(TEXTURES_PKG_NAME);
+        const std::string szEntryKey(SYNTHETIC_ENTRY_KEY);
+        const std::string szDataKey(SYNTHETIC_DATA_KEY);
+
+        PkgFile_t pPkg = uncso2_PkgFile_Create(
+            szPkgName.c_str(), vPkgBuffer.data(), vPkgBuffer.size(),
+            szEntryKey.c_str(), szDataKey.c_str());
+        REQUIRE(pPkg != nullptr);
+
+        REQUIRE(uncso2_PkgFile_DecryptHeader(pPkg) == true);
+        REQUIRE(uncso2_PkgFile_Parse(pPkg) == true);
+
+        std::uint64_t iEntriesNum = uncso2_PkgFile_GetEntriesNum(pPkg);
+        PkgEntry_t* pEntries = uncso2_PkgFile_GetEntries(pPkg);
+
+        REQUIRE(iEntriesNum != 0);
+
+        for (std::size_t y = 0; y < iEntriesNum; y++)
+        {
+            LzmaTexture_t pTexture =
+                uncso2_LzmaTexture_CreateFromEntry(pEntries[y]);
+            REQUIRE(pTexture != nullptr);
+
+            std::vector<std::uint8_t> vExpected(
+                uncso2_LzmaTexture_GetOriginalSize(pTexture));
+            REQUIRE(uncso2_LzmaTexture_Decompress(pTexture, vExpected.data(),
+                                                  vExpected.size()) == true);
+
+            uncso2_LzmaTexture_Free(pTexture);
+
+            // the texture is read from the entry one chunk at a time
+            PkgEntryReader_t pEntryReader =
+                uncso2_PkgEntryReader_Create(pEntries[y]);
+            REQUIRE(pEntryReader != nullptr);
+
+            LzmaTextureReader_t pReader =
+                uncso2_LzmaTextureReader_CreateFromEntry(pEntryReader);
+            REQUIRE(pReader != nullptr);
+
+            REQUIRE(uncso2_LzmaTextureReader_GetOriginalSize(pReader) ==
+                    vExpected.size());
+
+            std::vector<std::uint8_t> buff;
+            const void* pWindow = nullptr;
+            std::uint64_t iWindowSize = 0;
+
+            do
+            {
+                REQUIRE(uncso2_LzmaTextureReader_Next(pReader, &pWindow,
+                                                      &iWindowSize) == true);
+
+                auto pWindowBytes = static_cast<const std::uint8_t*>(pWindow);
+                buff.insert(buff.end(), pWindowBytes,
+                            pWindowBytes + iWindowSize);
+            } while (iWindowSize != 0);
+
+            REQUIRE(buff == vExpected);
+
+            uncso2_LzmaTextureReader_Free(pReader);
+            uncso2_PkgEntryReader_Free(pEntryReader);
+        }
+
+        uncso2_PkgFile_Free(pPkg);
+    }
+
+    SECTION("Decompressing textures from PKG entries")
+    {
+        // decompresses every texture of the PKG, and returns how many it has
+        auto fnDecompressTextures = [](PkgFile_t pPkg) {
+            std::size_t iTexturesNum = 0;
+
+            REQUIRE(uncso2_PkgFile_DecryptHeader(pPkg) == true);
+            REQUIRE(uncso2_PkgFile_Parse(pPkg) == true);
+
+            std::uint64_t iEntriesNum = uncso2_PkgFile_GetEntriesNum(pPkg);
+            PkgEntry_t* pEntries = uncso2_PkgFile_GetEntries(pPkg);
+
+            for (std::size_t y = 0; y < iEntriesNum; y++)
+            {
+                LzmaTexture_t pTexture =
+                    uncso2_LzmaTexture_CreateFromEntry(pEntries[y]);
+
+                if (pTexture == nullptr)
+                {
+                    continue;
+                }
+
+                std::uint64_t iOrigSize =
+                    uncso2_LzmaTexture_GetOriginalSize(pTexture);
+                std::vector<std::uint8_t> buff(iOrigSize);
+
+                REQUIRE(uncso2_LzmaTexture_DecompressParallel(
+                            pTexture, buff.data(), buff.size(), 0) == true);
+
+                uncso2_LzmaTexture_Free(pTexture);
+                iTexturesNum++;
+            }
+
+            return iTexturesNum;
+        };
+
+        std::size_t iTexturesFound = 0;
+
+        for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+        {
+            auto [bWasRead, vFileBuffer] =
+                ReadFileToBuffer(cso2::PkgFilenames[i]);
+
+            REQUIRE(bWasRead == true);
+            REQUIRE(vFileBuffer.empty() == false);
+
+            PkgFile_t pPkg = uncso2_PkgFile_Create(
+                cso2::PkgFilenames[i].data(), vFileBuffer.data(),
+                vFileBuffer.size(), cso2::PackageEntryKeys[i].data(),
+                cso2::PackageFileKeys[i].data());
+            REQUIRE(pPkg != nullptr);
+
+            iTexturesFound += fnDecompressTextures(pPkg);
+
+            uncso2_PkgFile_Free(pPkg);
+        }
+
+        std::vector<std::uint8_t> vPkgBuffer = BuildTexturesPkg();
+        const std::string szPkgName(TEXTURES_PKG_NAME);
+        const std::string szEntryKey(SYNTHETIC_ENTRY_KEY);
+        const std::string szDataKey(SYNTHETIC_DATA_KEY);
+
+        PkgFile_t pPkg = uncso2_PkgFile_Create(
+            szPkgName.c_str(), vPkgBuffer.data(), vPkgBuffer.size(),
+            szEntryKey.c_str(), szDataKey.c_str());
+        REQUIRE(pPkg != nullptr);
+
+        iTexturesFound += fnDecompressTextures(pPkg);
+
+        uncso2_PkgFile_Free(pPkg);
+
+        // otherwise the fused decryption and decompression never ran
+        REQUIRE(iTexturesFound > 0);
+    }
 }
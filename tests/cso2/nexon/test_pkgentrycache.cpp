@@ -0,0 +1,216 @@
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include <uc2/uc2.h>
+#include <uc2/uc2.hpp>
+
+#include "cso2/nexon/settings.hpp"
+#include "utils.hpp"
+
+namespace fs = std::filesystem;
+
+TEST_CASE("Pkg entry tables can be cached", "[pkgentrycache]")
+{
+    const fs::path cachePath =
+        fs::temp_directory_path() / "uc2_entrycache_test.bin";
+
+    SECTION("Can parse PKG files from a cache")
+    {
+        fs::remove(cachePath);
+
+        try
+        {
+            auto pCache = uc2::PkgEntryCache::Open(cachePath);
+            REQUIRE(pCache->GetArchivesNum() == 0);
+
+            auto pOptions = uc2::PkgFileOptions::Create();
+            pOptions->SetEntryCache(pCache.get());
+
+            // the first pass decrypts the tables and fills the cache
+            for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+            {
+                auto pPkgFile = uc2::PkgFile::Open(
+                    cso2::PkgFilenames[i], cso2::PackageEntryKeys[i],
+                    cso2::PackageFileKeys[i], pOptions.get());
+
+                REQUIRE(pPkgFile->DecryptHeader() == true);
+                pPkgFile->Parse();
+
+                REQUIRE(pPkgFile->GetEntries().size() ==
+                        cso2::PackageFileCounts[i]);
+            }
+
+            REQUIRE(pCache->GetArchivesNum() == cso2::NUM_PROVIDERS);
+            pCache->Save();
+
+            // the second pass reads the tables from the saved cache
+            auto pLoadedCache = uc2::PkgEntryCache::Open(cachePath);
+            REQUIRE(pLoadedCache->GetArchivesNum() == cso2::NUM_PROVIDERS);
+
+            pOptions->SetEntryCache(pLoadedCache.get());
+
+            for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+            {
+                auto pPkgFile = uc2::PkgFile::Open(
+                    cso2::PkgFilenames[i], cso2::PackageEntryKeys[i],
+                    cso2::PackageFileKeys[i], pOptions.get());
+
+                pPkgFile->Parse();
+
+                REQUIRE(pPkgFile->GetEntries().size() ==
+                        cso2::PackageFileCounts[i]);
+
+                std::size_t iCurIndex = 0;
+                for (auto&& entry : pPkgFile->GetEntries())
+                {
+                    std::vector<std::uint8_t> vEntryData(
+                        entry->GetDecryptedSize());
+                    entry->DecryptFileTo(vEntryData.data(), vEntryData.size());
+
+                    REQUIRE(GetDataHash(vEntryData.data(), vEntryData.size()) ==
+                            cso2::PackageFilesHashes[i][iCurIndex]);
+
+                    iCurIndex++;
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << '\n';
+            throw e;
+        }
+
+        fs::remove(cachePath);
+    }
+
+    SECTION("Tables are replaced when their PKG's size changes")
+    {
+        fs::remove(cachePath);
+
+        // the copy has the same MD5 hash in its header, but a different size.
+        // The keys are derived from the file's name, so it must be kept.
+        const fs::path grownPkgDir =
+            fs::temp_directory_path() / "uc2_entrycache_grown";
+        const fs::path grownPkgPath = grownPkgDir / cso2::PkgFilenames[0];
+        fs::create_directories(grownPkgDir);
+
+        auto [bWasRead, vFileBuffer] = ReadFileToBuffer(cso2::PkgFilenames[0]);
+        REQUIRE(bWasRead == true);
+
+        {
+            std::ofstream os(grownPkgPath, std::ios::binary | std::ios::trunc);
+            os.write(reinterpret_cast<const char*>(vFileBuffer.data()),
+                     vFileBuffer.size());
+            os << std::string(16, '\0');
+            REQUIRE(os.good() == true);
+        }
+
+        try
+        {
+            auto pCache = uc2::PkgEntryCache::Open(cachePath);
+
+            auto pOptions = uc2::PkgFileOptions::Create();
+            pOptions->SetEntryCache(pCache.get());
+
+            auto pPkgFile = uc2::PkgFile::Open(
+                cso2::PkgFilenames[0], cso2::PackageEntryKeys[0],
+                cso2::PackageFileKeys[0], pOptions.get());
+            REQUIRE(pPkgFile->DecryptHeader() == true);
+            pPkgFile->Parse();
+
+            auto pGrownPkgFile =
+                uc2::PkgFile::Open(grownPkgPath, cso2::PackageEntryKeys[0],
+                                   cso2::PackageFileKeys[0], pOptions.get());
+            REQUIRE(pGrownPkgFile->DecryptHeader() == true);
+            pGrownPkgFile->Parse();
+
+            REQUIRE(pCache->GetArchivesNum() == 1);
+
+            // the first PKG's entries must survive their table's replacement
+            std::size_t iCurIndex = 0;
+            for (auto&& entry : pPkgFile->GetEntries())
+            {
+                std::vector<std::uint8_t> vEntryData(entry->GetDecryptedSize());
+                entry->DecryptFileTo(vEntryData.data(), vEntryData.size());
+
+                REQUIRE(GetDataHash(vEntryData.data(), vEntryData.size()) ==
+                        cso2::PackageFilesHashes[0][iCurIndex]);
+
+                iCurIndex++;
+            }
+
+            pCache->Save();
+
+            // only the table of the grown PKG is cached now, so its header
+            // doesn't need to be decrypted
+            auto pLoadedCache = uc2::PkgEntryCache::Open(cachePath);
+            REQUIRE(pLoadedCache->GetArchivesNum() == 1);
+
+            pOptions->SetEntryCache(pLoadedCache.get());
+
+            auto pCachedPkgFile =
+                uc2::PkgFile::Open(grownPkgPath, cso2::PackageEntryKeys[0],
+                                   cso2::PackageFileKeys[0], pOptions.get());
+            pCachedPkgFile->Parse();
+
+            REQUIRE(pCachedPkgFile->GetEntries().size() ==
+                    cso2::PackageFileCounts[0]);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << '\n';
+            throw e;
+        }
+
+        fs::remove_all(grownPkgDir);
+        fs::remove(cachePath);
+    }
+
+    SECTION("Broken cache files are ignored")
+    {
+        {
+            std::ofstream os(cachePath, std::ios::binary | std::ios::trunc);
+            os << "this is not an entry cache";
+        }
+
+        auto pCache = uc2::PkgEntryCache::Open(cachePath);
+        REQUIRE(pCache->GetArchivesNum() == 0);
+
+        fs::remove(cachePath);
+    }
+
+    SECTION("Can cache entry tables using C bindings")
+    {
+        fs::remove(cachePath);
+
+        PkgEntryCache_t pCache =
+            uncso2_PkgEntryCache_Open(cachePath.string().c_str());
+        REQUIRE(pCache != nullptr);
+
+        PkgFileOptions_t pOptions = uncso2_PkgFileOptions_Create();
+        REQUIRE(pOptions != nullptr);
+        uncso2_PkgFileOptions_SetEntryCache(pOptions, pCache);
+
+        PkgFile_t pPkg = uncso2_PkgFile_Open(
+            cso2::PkgFilenames[0].data(), cso2::PackageEntryKeys[0].data(),
+            cso2::PackageFileKeys[0].data(), pOptions);
+        REQUIRE(pPkg != nullptr);
+
+        REQUIRE(uncso2_PkgFile_DecryptHeader(pPkg) == true);
+        REQUIRE(uncso2_PkgFile_Parse(pPkg) == true);
+        REQUIRE(uncso2_PkgFile_GetEntriesNum(pPkg) ==
+                cso2::PackageFileCounts[0]);
+
+        REQUIRE(uncso2_PkgEntryCache_GetArchivesNum(pCache) == 1);
+        REQUIRE(uncso2_PkgEntryCache_Save(pCache) == true);
+
+        uncso2_PkgFile_Free(pPkg);
+        uncso2_PkgFileOptions_Free(pOptions);
+        uncso2_PkgEntryCache_Free(pCache);
+
+        fs::remove(cachePath);
+    }
+}
@@ -0,0 +1,194 @@
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include <uc2/uc2.h>
+#include <uc2/uc2.hpp>
+
+#include "cso2/nexon/settings.hpp"
+#include "utils.hpp"
+
+#ifdef _WIN32
+#define fileno _fileno
+#endif
+
+static std::vector<std::uint8_t> ReadWholeEntry(uc2::PkgEntryReader& reader)
+{
+    std::vector<std::uint8_t> vEntryData;
+
+    for (auto [pChunk, iChunkSize] = reader.Next(); iChunkSize != 0;
+         std::tie(pChunk, iChunkSize) = reader.Next())
+    {
+        REQUIRE(iChunkSize <= uc2::PkgEntryReader::GetChunkSize());
+        vEntryData.insert(vEntryData.end(), pChunk, pChunk + iChunkSize);
+    }
+
+    REQUIRE(reader.IsFinished() == true);
+
+    return vEntryData;
+}
+
+TEST_CASE("Pkg entries can be read in chunks", "[pkgentryreader]")
+{
+    SECTION("Can read entries from the PKG's buffer")
+    {
+        for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+        {
+            auto [bWasRead, vFileBuffer] =
+                ReadFileToBuffer(cso2::PkgFilenames[i]);
+
+            REQUIRE(bWasRead == true);
+            REQUIRE(vFileBuffer.empty() == false);
+
+            try
+            {
+                auto pPkgFile = uc2::PkgFile::Create(
+                    cso2::PkgFilenames[i], vFileBuffer,
+                    cso2::PackageEntryKeys[i], cso2::PackageFileKeys[i]);
+
+                pPkgFile->DecryptHeader();
+                pPkgFile->Parse();
+
+                REQUIRE(pPkgFile->GetEntries().size() ==
+                        cso2::PackageFileCounts[i]);
+
+                std::size_t iCurIndex = 0;
+                for (auto&& entry : pPkgFile->GetEntries())
+                {
+                    auto pReader = uc2::PkgEntryReader::Create(*entry);
+
+                    // the PKG's buffer is left untouched, so read it twice
+                    for (std::size_t y = 0; y < 2; y++)
+                    {
+                        auto vEntryData = ReadWholeEntry(*pReader);
+
+                        REQUIRE(vEntryData.size() == entry->GetDecryptedSize());
+                        REQUIRE(GetDataHash(vEntryData.data(),
+                                            vEntryData.size()) ==
+                                cso2::PackageFilesHashes[i][iCurIndex]);
+
+                        pReader->Rewind();
+                    }
+
+                    iCurIndex++;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << e.what() << '\n';
+                throw e;
+            }
+        }
+    }
+
+    SECTION("Can read entries from a file descriptor")
+    {
+        for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+        {
+            auto [bWasRead, vFileBuffer] =
+                ReadFileToBuffer(cso2::PkgFilenames[i]);
+
+            REQUIRE(bWasRead == true);
+            REQUIRE(vFileBuffer.empty() == false);
+
+            std::FILE* pFile = std::fopen(cso2::PkgFilenames[i].c_str(), "rb");
+            REQUIRE(pFile != nullptr);
+
+            try
+            {
+                // the entries are parsed from memory, but their data is read
+                // from the file
+                auto pPkgFile = uc2::PkgFile::Create(
+                    cso2::PkgFilenames[i], vFileBuffer,
+                    cso2::PackageEntryKeys[i], cso2::PackageFileKeys[i]);
+
+                pPkgFile->DecryptHeader();
+                pPkgFile->Parse();
+
+                REQUIRE(pPkgFile->GetEntries().size() ==
+                        cso2::PackageFileCounts[i]);
+
+                std::size_t iCurIndex = 0;
+                for (auto&& entry : pPkgFile->GetEntries())
+                {
+                    auto pReader = uc2::PkgEntryReader::CreateFromFile(
+                        *entry, fileno(pFile));
+                    auto vEntryData = ReadWholeEntry(*pReader);
+
+                    REQUIRE(GetDataHash(vEntryData.data(), vEntryData.size()) ==
+                            cso2::PackageFilesHashes[i][iCurIndex]);
+
+                    iCurIndex++;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                std::fclose(pFile);
+                std::cerr << e.what() << '\n';
+                throw e;
+            }
+
+            std::fclose(pFile);
+        }
+    }
+}
+
+TEST_CASE("Pkg entries can be read in chunks using C bindings",
+          "[pkgentryreader]")
+{
+    SECTION("Can read entries")
+    {
+        for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+        {
+            auto [bWasRead, vFileBuffer] =
+                ReadFileToBuffer(cso2::PkgFilenames[i]);
+
+            REQUIRE(bWasRead == true);
+            REQUIRE(vFileBuffer.empty() == false);
+
+            PkgFile_t pPkg = uncso2_PkgFile_Create(
+                cso2::PkgFilenames[i].data(), vFileBuffer.data(),
+                vFileBuffer.size(), cso2::PackageEntryKeys[i].data(),
+                cso2::PackageFileKeys[i].data());
+            REQUIRE(pPkg != nullptr);
+
+            REQUIRE(uncso2_PkgFile_DecryptHeader(pPkg) == true);
+            REQUIRE(uncso2_PkgFile_Parse(pPkg) == true);
+
+            std::uint64_t iEntriesNum = uncso2_PkgFile_GetEntriesNum(pPkg);
+            PkgEntry_t* pEntries = uncso2_PkgFile_GetEntries(pPkg);
+
+            REQUIRE(iEntriesNum == cso2::PackageFileCounts[i]);
+
+            for (std::size_t y = 0; y < iEntriesNum; y++)
+            {
+                PkgEntryReader_t pReader =
+                    uncso2_PkgEntryReader_Create(pEntries[y]);
+                REQUIRE(pReader != nullptr);
+
+                std::vector<std::uint8_t> vEntryData;
+                const void* pChunk;
+                std::uint64_t iChunkSize;
+
+                do
+                {
+                    REQUIRE(uncso2_PkgEntryReader_Next(pReader, &pChunk,
+                                                       &iChunkSize) == true);
+
+                    auto pChunkBytes = static_cast<const std::uint8_t*>(pChunk);
+                    vEntryData.insert(vEntryData.end(), pChunkBytes,
+                                      pChunkBytes + iChunkSize);
+                } while (iChunkSize != 0);
+
+                REQUIRE(GetDataHash(vEntryData.data(), vEntryData.size()) ==
+                        cso2::PackageFilesHashes[i][y]);
+
+                uncso2_PkgEntryReader_Free(pReader);
+            }
+
+            uncso2_PkgFile_Free(pPkg);
+        }
+    }
+}
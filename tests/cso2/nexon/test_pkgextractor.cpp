@@ -0,0 +1,104 @@
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <iostream>
+
+#include <uc2/uc2.h>
+#include <uc2/uc2.hpp>
+
+#include "cso2/nexon/settings.hpp"
+#include "utils.hpp"
+
+namespace fs = std::filesystem;
+
+TEST_CASE("Pkg file entries can be extracted", "[pkgextractor]")
+{
+    SECTION("Can extract every entry to a directory")
+    {
+        for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+        {
+            auto [bWasRead, vFileBuffer] =
+                ReadFileToBuffer(cso2::PkgFilenames[i]);
+
+            REQUIRE(bWasRead == true);
+            REQUIRE(vFileBuffer.empty() == false);
+
+            const fs::path outDir =
+                fs::temp_directory_path() / "uc2_extract_test";
+            fs::remove_all(outDir);
+
+            try
+            {
+                auto pPkgFile = uc2::PkgFile::Create(
+                    cso2::PkgFilenames[i], vFileBuffer,
+                    cso2::PackageEntryKeys[i], cso2::PackageFileKeys[i]);
+
+                pPkgFile->DecryptHeader();
+                pPkgFile->Parse();
+
+                auto pExtractor = uc2::PkgExtractor::Create(*pPkgFile, 4);
+
+                REQUIRE(pExtractor->GetThreadsNum() == 4);
+                REQUIRE(pExtractor->ExtractAll(outDir) ==
+                        cso2::PackageFileCounts[i]);
+
+                std::size_t iCurIndex = 0;
+                for (auto&& entry : pPkgFile->GetEntries())
+                {
+                    const fs::path entryPath =
+                        outDir / fs::path(entry->GetFilePath()).relative_path();
+
+                    auto [bWasExtracted, vEntryData] =
+                        ReadFileToBuffer(entryPath.string());
+
+                    REQUIRE(bWasExtracted == true);
+                    REQUIRE(GetDataHash(vEntryData.data(), vEntryData.size()) ==
+                            cso2::PackageFilesHashes[i][iCurIndex]);
+
+                    iCurIndex++;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << e.what() << '\n';
+                throw e;
+            }
+
+            fs::remove_all(outDir);
+        }
+    }
+
+    SECTION("Can extract every entry using C bindings")
+    {
+        auto [bWasRead, vFileBuffer] = ReadFileToBuffer(cso2::PkgFilenames[0]);
+
+        REQUIRE(bWasRead == true);
+        REQUIRE(vFileBuffer.empty() == false);
+
+        const fs::path outDir = fs::temp_directory_path() / "uc2_extract_test";
+        fs::remove_all(outDir);
+
+        PkgFile_t pPkg = uncso2_PkgFile_Create(
+            cso2::PkgFilenames[0].data(), vFileBuffer.data(),
+            vFileBuffer.size(), cso2::PackageEntryKeys[0].data(),
+            cso2::PackageFileKeys[0].data());
+        REQUIRE(pPkg != nullptr);
+
+        REQUIRE(uncso2_PkgFile_DecryptHeader(pPkg) == true);
+        REQUIRE(uncso2_PkgFile_Parse(pPkg) == true);
+
+        PkgExtractor_t pExtractor = uncso2_PkgExtractor_Create(pPkg, 0);
+        REQUIRE(pExtractor != nullptr);
+
+        std::uint64_t iExtractedNum = 0;
+        REQUIRE(uncso2_PkgExtractor_ExtractAll(
+                    pExtractor, outDir.string().c_str(), &iExtractedNum) ==
+                true);
+        REQUIRE(iExtractedNum == cso2::PackageFileCounts[0]);
+
+        uncso2_PkgExtractor_Free(pExtractor);
+        uncso2_PkgFile_Free(pPkg);
+
+        fs::remove_all(outDir);
+    }
+}
@@ -1,5 +1,6 @@
 #include <catch2/catch.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <string_view>
 
@@ -54,6 +55,610 @@ TEST_CASE("Pkg file can be decrypted and parsed", "[pkgfile]")
     }
 }
 
+TEST_CASE("Pkg file can be decrypted with multiple threads", "[pkgfile]")
+{
+    SECTION("Can decrypt entries in parallel")
+    {
+        for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+        {
+            auto [bWasRead, vFileBuffer] =
+                ReadFileToBuffer(cso2::PkgFilenames[i]);
+
+            REQUIRE(bWasRead == true);
+            REQUIRE(vFileBuffer.empty() == false);
+
+            try
+            {
+                auto pPkgOptions = uc2::PkgFileOptions::Create();
+                pPkgOptions->SetDecryptThreads(4);
+
+                auto pPkgFile = uc2::PkgFile::Create(
+                    cso2::PkgFilenames[i], vFileBuffer,
+                    cso2::PackageEntryKeys[i], cso2::PackageFileKeys[i],
+                    pPkgOptions.get());
+
+                pPkgFile->DecryptHeader();
+                pPkgFile->Parse();
+
+                REQUIRE(pPkgFile->GetEntries().size() ==
+                        cso2::PackageFileCounts[i]);
+
+                std::size_t iCurIndex = 0;
+                for (auto&& entry : pPkgFile->GetEntries())
+                {
+                    auto [fileData, fileDataLen] = entry->DecryptFile();
+                    REQUIRE(GetDataHash(fileData, fileDataLen) ==
+                            cso2::PackageFilesHashes[i][iCurIndex]);
+
+                    iCurIndex++;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << e.what() << '\n';
+                throw e;
+            }
+        }
+    }
+}
+
+TEST_CASE("Pkg file entries can be created on demand", "[pkgfile]")
+{
+    SECTION("Can get entries by their index")
+    {
+        for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+        {
+            auto [bWasRead, vFileBuffer] =
+                ReadFileToBuffer(cso2::PkgFilenames[i]);
+
+            REQUIRE(bWasRead == true);
+            REQUIRE(vFileBuffer.empty() == false);
+
+            try
+            {
+                auto pPkgOptions = uc2::PkgFileOptions::Create();
+                pPkgOptions->SetLazyEntries(true);
+
+                auto pPkgFile = uc2::PkgFile::Create(
+                    cso2::PkgFilenames[i], vFileBuffer,
+                    cso2::PackageEntryKeys[i], cso2::PackageFileKeys[i],
+                    pPkgOptions.get());
+
+                pPkgFile->DecryptHeader();
+                pPkgFile->Parse();
+
+                REQUIRE(pPkgFile->GetEntriesNum() ==
+                        cso2::PackageFileCounts[i]);
+
+                // request the entries backwards, so they aren't created in
+                // the table's order
+                for (std::size_t y = pPkgFile->GetEntriesNum(); y > 0; y--)
+                {
+                    uc2::PkgEntry& entry = pPkgFile->GetEntry(y - 1);
+                    REQUIRE(&entry == &pPkgFile->GetEntry(y - 1));
+
+                    std::vector<std::uint8_t> vData(entry.GetDecryptedSize());
+                    entry.DecryptFileTo(vData.data(), vData.size());
+
+                    REQUIRE(GetDataHash(vData.data(), vData.size()) ==
+                            cso2::PackageFilesHashes[i][y - 1]);
+                }
+
+                REQUIRE_THROWS_AS(
+                    pPkgFile->GetEntry(pPkgFile->GetEntriesNum()),
+                    std::out_of_range);
+
+                auto& entries = pPkgFile->GetEntries();
+                REQUIRE(entries.size() == cso2::PackageFileCounts[i]);
+
+                for (std::size_t y = 0; y < entries.size(); y++)
+                {
+                    REQUIRE(entries[y].get() == &pPkgFile->GetEntry(y));
+                }
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << e.what() << '\n';
+                throw e;
+            }
+        }
+    }
+
+    SECTION("Can get entries by their index using C bindings")
+    {
+        for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+        {
+            auto [bWasRead, vFileBuffer] =
+                ReadFileToBuffer(cso2::PkgFilenames[i]);
+
+            REQUIRE(bWasRead == true);
+            REQUIRE(vFileBuffer.empty() == false);
+
+            PkgFileOptions_t pOptions = uncso2_PkgFileOptions_Create();
+            REQUIRE(pOptions != nullptr);
+
+            uncso2_PkgFileOptions_SetLazyEntries(pOptions, true);
+            REQUIRE(uncso2_PkgFileOptions_IsLazyEntries(pOptions) == true);
+
+            PkgFile_t pPkg = uncso2_PkgFile_Create(
+                cso2::PkgFilenames[i].data(), vFileBuffer.data(),
+                vFileBuffer.size(), cso2::PackageEntryKeys[i].data(),
+                cso2::PackageFileKeys[i].data(), pOptions);
+            REQUIRE(pPkg != nullptr);
+
+            REQUIRE(uncso2_PkgFile_DecryptHeader(pPkg) == true);
+            REQUIRE(uncso2_PkgFile_Parse(pPkg) == true);
+
+            std::uint64_t iEntriesNum = uncso2_PkgFile_GetEntriesNum(pPkg);
+            REQUIRE(iEntriesNum == cso2::PackageFileCounts[i]);
+
+            for (std::size_t y = 0; y < iEntriesNum; y++)
+            {
+                PkgEntry_t pEntry = uncso2_PkgFile_GetEntry(pPkg, y);
+                REQUIRE(pEntry != nullptr);
+
+                void* pOutBuffer;
+                std::uint64_t iOutBufferSize;
+                REQUIRE(uncso2_PkgEntry_Decrypt(pEntry, &pOutBuffer,
+                                                &iOutBufferSize) == true);
+                REQUIRE(GetDataHash(reinterpret_cast<std::uint8_t*>(pOutBuffer),
+                                    iOutBufferSize) ==
+                        cso2::PackageFilesHashes[i][y]);
+            }
+
+            REQUIRE(uncso2_PkgFile_GetEntry(pPkg, iEntriesNum) == nullptr);
+
+            uncso2_PkgFile_Free(pPkg);
+            uncso2_PkgFileOptions_Free(pOptions);
+        }
+    }
+}
+
+TEST_CASE("Pkg file entries created on demand can be invalid", "[pkgfile]")
+{
+    SECTION("An invalid entry is never handed out")
+    {
+        auto [bWasRead, vFileBuffer] = ReadFileToBuffer(cso2::PkgFilenames[0]);
+
+        REQUIRE(bWasRead == true);
+        REQUIRE(vFileBuffer.empty() == false);
+
+        try
+        {
+            // decrypt a copy first, to learn the entry table's plain text
+            std::vector<std::uint8_t> vDecryptedBuffer = vFileBuffer;
+
+            auto pDecryptedPkg = uc2::PkgFile::Create(
+                cso2::PkgFilenames[0], vDecryptedBuffer,
+                cso2::PackageEntryKeys[0], cso2::PackageFileKeys[0]);
+
+            REQUIRE(pDecryptedPkg->DecryptHeader() == true);
+            pDecryptedPkg->Parse();
+
+            const std::uint64_t iEntriesNum = pDecryptedPkg->GetEntriesNum();
+            REQUIRE(iEntriesNum > 1);
+
+            std::uint64_t iBadIndex = 0;
+
+            while (iBadIndex < iEntriesNum &&
+                   pDecryptedPkg->GetEntry(iBadIndex).IsEncrypted() == false)
+            {
+                iBadIndex++;
+            }
+
+            REQUIRE(iBadIndex < iEntriesNum);
+
+            uc2::PkgEntry& badEntry = pDecryptedPkg->GetEntry(iBadIndex);
+
+            // the forged decrypted size below must be the bigger one, and
+            // the path must not reach the block garbled by the forgery
+            REQUIRE(badEntry.GetEncryptedSize() < 0xFFFFFF);
+            REQUIRE(badEntry.GetFilePath().size() < 240);
+
+            // every entry header is 288 bytes long and is encrypted on its
+            // own in CBC mode. Its decrypted size's lower three bytes are at
+            // 269, in the 17th block, so XORing the 16th block's ciphertext
+            // sets them to 0xFF.
+            constexpr const std::size_t ENTRY_HEADER_SIZE = 288;
+            constexpr const std::size_t DECRYPTED_SIZE_OFFSET = 269;
+            constexpr const std::size_t BLOCK_SIZE = 16;
+
+            const std::uint64_t iSizeOffset =
+                pDecryptedPkg->GetFullHeaderSize() -
+                (iEntriesNum - iBadIndex) * ENTRY_HEADER_SIZE +
+                DECRYPTED_SIZE_OFFSET;
+
+            for (std::size_t i = 0; i < 3; i++)
+            {
+                vFileBuffer[iSizeOffset - BLOCK_SIZE + i] ^=
+                    vDecryptedBuffer[iSizeOffset + i] ^ 0xFF;
+            }
+
+            auto pPkgOptions = uc2::PkgFileOptions::Create();
+            pPkgOptions->SetLazyEntries(true);
+
+            auto pPkgFile = uc2::PkgFile::Create(
+                cso2::PkgFilenames[0], vFileBuffer, cso2::PackageEntryKeys[0],
+                cso2::PackageFileKeys[0], pPkgOptions.get());
+
+            REQUIRE(pPkgFile->DecryptHeader() == true);
+            pPkgFile->Parse();
+
+            REQUIRE_THROWS_AS(pPkgFile->GetEntry(iBadIndex),
+                              std::invalid_argument);
+            // the failed entry must not be remembered as created
+            REQUIRE_THROWS_AS(pPkgFile->GetEntry(iBadIndex),
+                              std::invalid_argument);
+
+            const std::uint64_t iGoodIndex = iBadIndex == 0 ? 1 : 0;
+            uc2::PkgEntry& goodEntry = pPkgFile->GetEntry(iGoodIndex);
+
+            REQUIRE_THROWS_AS(pPkgFile->GetEntries(), std::invalid_argument);
+            REQUIRE(&goodEntry == &pPkgFile->GetEntry(iGoodIndex));
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << '\n';
+            throw e;
+        }
+    }
+}
+
+TEST_CASE("Pkg file entries can be found by their path", "[pkgfile]")
+{
+    SECTION("Can find entries by their path and prefix")
+    {
+        for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+        {
+            auto [bWasRead, vFileBuffer] =
+                ReadFileToBuffer(cso2::PkgFilenames[i]);
+
+            REQUIRE(bWasRead == true);
+            REQUIRE(vFileBuffer.empty() == false);
+
+            try
+            {
+                auto pPkgOptions = uc2::PkgFileOptions::Create();
+                pPkgOptions->SetLazyEntries(true);
+
+                auto pPkgFile = uc2::PkgFile::Create(
+                    cso2::PkgFilenames[i], vFileBuffer,
+                    cso2::PackageEntryKeys[i], cso2::PackageFileKeys[i],
+                    pPkgOptions.get());
+
+                pPkgFile->DecryptHeader();
+                pPkgFile->Parse();
+
+                for (std::size_t y = 0; y < pPkgFile->GetEntriesNum(); y++)
+                {
+                    const std::string szPath(
+                        pPkgFile->GetEntry(y).GetFilePath());
+
+                    // the path's root separator is optional
+                    uc2::PkgEntry* pEntry = pPkgFile->FindEntry(szPath);
+                    REQUIRE(pEntry != nullptr);
+                    REQUIRE(pEntry->GetFilePath() == szPath);
+                    REQUIRE(pPkgFile->FindEntry(szPath.substr(1)) == pEntry);
+
+                    std::vector<uc2::PkgEntry*> vFound =
+                        pPkgFile->FindEntriesByPrefix(szPath);
+                    REQUIRE(std::find(vFound.begin(), vFound.end(), pEntry) !=
+                            vFound.end());
+                }
+
+                REQUIRE(pPkgFile->FindEntry("/does/not/exist.txt") ==
+                        nullptr);
+
+                REQUIRE(pPkgFile->FindEntriesByPrefix("").size() ==
+                        cso2::PackageFileCounts[i]);
+                REQUIRE(pPkgFile->ListDirectory("", true).size() ==
+                        cso2::PackageFileCounts[i]);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << e.what() << '\n';
+                throw e;
+            }
+        }
+    }
+
+    SECTION("Can find entries by their path using C bindings")
+    {
+        for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+        {
+            auto [bWasRead, vFileBuffer] =
+                ReadFileToBuffer(cso2::PkgFilenames[i]);
+
+            REQUIRE(bWasRead == true);
+            REQUIRE(vFileBuffer.empty() == false);
+
+            PkgFile_t pPkg = uncso2_PkgFile_Create(
+                cso2::PkgFilenames[i].data(), vFileBuffer.data(),
+                vFileBuffer.size(), cso2::PackageEntryKeys[i].data(),
+                cso2::PackageFileKeys[i].data());
+            REQUIRE(pPkg != nullptr);
+
+            REQUIRE(uncso2_PkgFile_DecryptHeader(pPkg) == true);
+            REQUIRE(uncso2_PkgFile_Parse(pPkg) == true);
+
+            std::uint64_t iEntriesNum = uncso2_PkgFile_GetEntriesNum(pPkg);
+
+            for (std::size_t y = 0; y < iEntriesNum; y++)
+            {
+                PkgEntry_t pEntry = uncso2_PkgFile_GetEntry(pPkg, y);
+                const char* szPath = uncso2_PkgEntry_GetPath(pEntry);
+
+                PkgEntry_t pFound = uncso2_PkgFile_FindEntry(pPkg, szPath);
+                REQUIRE(pFound != nullptr);
+                REQUIRE(std::string_view(uncso2_PkgEntry_GetPath(pFound)) ==
+                        szPath);
+            }
+
+            std::vector<PkgEntry_t> vFound(iEntriesNum);
+            REQUIRE(uncso2_PkgFile_FindEntriesByPrefix(
+                        pPkg, "", vFound.data(), vFound.size()) ==
+                    iEntriesNum);
+            REQUIRE(uncso2_PkgFile_ListDirectory(pPkg, "", true, NULL, 0) ==
+                    iEntriesNum);
+
+            uncso2_PkgFile_Free(pPkg);
+        }
+    }
+}
+
+TEST_CASE("Pkg file can be opened from the disk", "[pkgfile]")
+{
+    SECTION("Can parse entries from a mapped file")
+    {
+        for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+        {
+            auto [bWasRead, vOriginalBuffer] =
+                ReadFileToBuffer(cso2::PkgFilenames[i]);
+
+            REQUIRE(bWasRead == true);
+            REQUIRE(vOriginalBuffer.empty() == false);
+
+            try
+            {
+                auto pPkgFile = uc2::PkgFile::Open(cso2::PkgFilenames[i],
+                                                   cso2::PackageEntryKeys[i],
+                                                   cso2::PackageFileKeys[i]);
+
+                REQUIRE(pPkgFile);
+                REQUIRE(pPkgFile->GetFilename() == cso2::PkgFilenames[i]);
+
+                pPkgFile->DecryptHeader();
+                pPkgFile->Parse();
+
+                REQUIRE(pPkgFile->GetEntries().size() ==
+                        cso2::PackageFileCounts[i]);
+
+                std::size_t iCurIndex = 0;
+                for (auto&& entry : pPkgFile->GetEntries())
+                {
+                    auto [fileData, fileDataLen] = entry->DecryptFile();
+                    REQUIRE(GetDataHash(fileData, fileDataLen) ==
+                            cso2::PackageFilesHashes[i][iCurIndex]);
+
+                    iCurIndex++;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << e.what() << '\n';
+                throw e;
+            }
+
+            // the decrypted data must never reach the file
+            auto [bWasReadAgain, vCurrentBuffer] =
+                ReadFileToBuffer(cso2::PkgFilenames[i]);
+
+            REQUIRE(bWasReadAgain == true);
+            REQUIRE(vCurrentBuffer == vOriginalBuffer);
+        }
+    }
+
+    SECTION("Can open a mapped file using C bindings")
+    {
+        for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+        {
+            PkgFile_t pPkgFile = uncso2_PkgFile_Open(
+                cso2::PkgFilenames[i].data(),
+                cso2::PackageEntryKeys[i].data(),
+                cso2::PackageFileKeys[i].data());
+
+            REQUIRE(pPkgFile != nullptr);
+            REQUIRE(uncso2_PkgFile_DecryptHeader(pPkgFile) == true);
+            REQUIRE(uncso2_PkgFile_Parse(pPkgFile) == true);
+            REQUIRE(uncso2_PkgFile_GetEntriesNum(pPkgFile) ==
+                    cso2::PackageFileCounts[i]);
+
+            uncso2_PkgFile_Free(pPkgFile);
+        }
+
+        REQUIRE(uncso2_PkgFile_Open("missing_file.pkg",
+                                    cso2::PackageEntryKeys[0].data(),
+                                    cso2::PackageFileKeys[0].data()) ==
+                nullptr);
+    }
+}
+
+TEST_CASE("Pkg file entries can be decrypted to another buffer", "[pkgfile]")
+{
+    SECTION("Can decrypt entries without modifying the PKG's data")
+    {
+        for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+        {
+            auto [bWasRead, vFileBuffer] =
+                ReadFileToBuffer(cso2::PkgFilenames[i]);
+
+            REQUIRE(bWasRead == true);
+            REQUIRE(vFileBuffer.empty() == false);
+
+            try
+            {
+                auto pPkgFile = uc2::PkgFile::Create(
+                    cso2::PkgFilenames[i], vFileBuffer,
+                    cso2::PackageEntryKeys[i], cso2::PackageFileKeys[i]);
+
+                pPkgFile->DecryptHeader();
+                pPkgFile->Parse();
+
+                REQUIRE(pPkgFile->GetEntries().size() ==
+                        cso2::PackageFileCounts[i]);
+
+                const std::vector<std::uint8_t> vParsedBuffer = vFileBuffer;
+
+                std::size_t iCurIndex = 0;
+                for (auto&& entry : pPkgFile->GetEntries())
+                {
+                    std::vector<std::uint8_t> vOutBuffer(
+                        entry->GetDecryptedSize());
+
+                    // decrypting it twice must give the same data
+                    for (std::size_t y = 0; y < 2; y++)
+                    {
+                        std::uint64_t iWritten = entry->DecryptFileTo(
+                            vOutBuffer.data(), vOutBuffer.size());
+
+                        REQUIRE(iWritten == entry->GetDecryptedSize());
+                        REQUIRE(GetDataHash(vOutBuffer.data(), iWritten) ==
+                                cso2::PackageFilesHashes[i][iCurIndex]);
+                    }
+
+                    iCurIndex++;
+                }
+
+                REQUIRE(vFileBuffer == vParsedBuffer);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << e.what() << '\n';
+                throw e;
+            }
+        }
+    }
+
+    SECTION("Cannot decrypt an entry to a smaller buffer")
+    {
+        auto [bWasRead, vFileBuffer] = ReadFileToBuffer(cso2::PkgFilenames[0]);
+
+        REQUIRE(bWasRead == true);
+        REQUIRE(vFileBuffer.empty() == false);
+
+        auto pPkgFile = uc2::PkgFile::Create(cso2::PkgFilenames[0], vFileBuffer,
+                                             cso2::PackageEntryKeys[0],
+                                             cso2::PackageFileKeys[0]);
+
+        pPkgFile->DecryptHeader();
+        pPkgFile->Parse();
+
+        auto&& entry = pPkgFile->GetEntries().at(0);
+        std::vector<std::uint8_t> vOutBuffer(16);
+
+        REQUIRE_THROWS_AS(entry->DecryptFileTo(vOutBuffer.data(),
+                                               vOutBuffer.size(), 23),
+                          std::length_error);
+        REQUIRE(entry->DecryptFileTo(vOutBuffer.data(), vOutBuffer.size(),
+                                     16) == 16);
+    }
+}
+
+TEST_CASE("Pkg file entries can be read by ranges", "[pkgfile]")
+{
+    SECTION("Can read entries in unaligned pieces")
+    {
+        for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+        {
+            auto [bWasRead, vFileBuffer] =
+                ReadFileToBuffer(cso2::PkgFilenames[i]);
+
+            REQUIRE(bWasRead == true);
+            REQUIRE(vFileBuffer.empty() == false);
+
+            try
+            {
+                auto pPkgFile = uc2::PkgFile::Create(
+                    cso2::PkgFilenames[i], vFileBuffer,
+                    cso2::PackageEntryKeys[i], cso2::PackageFileKeys[i]);
+
+                pPkgFile->DecryptHeader();
+                pPkgFile->Parse();
+
+                REQUIRE(pPkgFile->GetEntries().size() ==
+                        cso2::PackageFileCounts[i]);
+
+                // crosses the 64 KiB data blocks at odd offsets
+                constexpr const std::uint64_t iPieceSize = 40009;
+
+                std::size_t iCurIndex = 0;
+                for (auto&& entry : pPkgFile->GetEntries())
+                {
+                    const std::uint64_t iFileSize = entry->GetDecryptedSize();
+                    std::vector<std::uint8_t> vOutBuffer(iFileSize);
+
+                    for (std::uint64_t iOffset = 0; iOffset < iFileSize;
+                         iOffset += iPieceSize)
+                    {
+                        std::uint64_t iRead = entry->ReadRange(
+                            iOffset, iPieceSize, vOutBuffer.data() + iOffset);
+
+                        REQUIRE(iRead ==
+                                std::min(iPieceSize, iFileSize - iOffset));
+                    }
+
+                    REQUIRE(GetDataHash(vOutBuffer.data(), iFileSize) ==
+                            cso2::PackageFilesHashes[i][iCurIndex]);
+
+                    iCurIndex++;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << e.what() << '\n';
+                throw e;
+            }
+        }
+    }
+
+    SECTION("Can read a range using C bindings")
+    {
+        auto [bWasRead, vFileBuffer] = ReadFileToBuffer(cso2::PkgFilenames[0]);
+
+        REQUIRE(bWasRead == true);
+        REQUIRE(vFileBuffer.empty() == false);
+
+        PkgFile_t pPkg = uncso2_PkgFile_Create(
+            cso2::PkgFilenames[0].data(), vFileBuffer.data(),
+            vFileBuffer.size(), cso2::PackageEntryKeys[0].data(),
+            cso2::PackageFileKeys[0].data());
+        REQUIRE(pPkg != nullptr);
+
+        REQUIRE(uncso2_PkgFile_DecryptHeader(pPkg) == true);
+        REQUIRE(uncso2_PkgFile_Parse(pPkg) == true);
+
+        PkgEntry_t pEntry = uncso2_PkgFile_GetEntries(pPkg)[0];
+        const std::uint64_t iFileSize = uncso2_PkgEntry_GetDecryptedSize(pEntry);
+
+        std::vector<std::uint8_t> vFullBuffer(iFileSize);
+        std::uint64_t iOutSize;
+        REQUIRE(uncso2_PkgEntry_DecryptTo(pEntry, vFullBuffer.data(),
+                                          vFullBuffer.size(), &iOutSize));
+
+        const std::uint64_t iOffset = iFileSize / 3;
+        const std::uint64_t iLength = iFileSize / 2;
+        std::vector<std::uint8_t> vRangeBuffer(iLength);
+
+        REQUIRE(uncso2_PkgEntry_ReadRange(pEntry, iOffset, iLength,
+                                          vRangeBuffer.data(), &iOutSize));
+        REQUIRE(iOutSize == iLength);
+        REQUIRE(std::equal(vRangeBuffer.begin(), vRangeBuffer.end(),
+                           vFullBuffer.begin() + iOffset));
+
+        uncso2_PkgFile_Free(pPkg);
+    }
+}
+
 TEST_CASE("Pkg file partially decrypting an entry", "[pkgfile]")
 {
     SECTION("Can decrypt 16 bytes of an entry")
@@ -180,4 +785,46 @@ TEST_CASE("Pkg file can be decrypted and parsed using C bindings", "[pkgfile]")
             uncso2_PkgFile_Free(pPkg);
         }
     }
+
+    SECTION("Can decrypt entries to another buffer")
+    {
+        for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+        {
+            auto [bWasRead, vFileBuffer] =
+                ReadFileToBuffer(cso2::PkgFilenames[i]);
+
+            REQUIRE(bWasRead == true);
+            REQUIRE(vFileBuffer.empty() == false);
+
+            PkgFile_t pPkg = uncso2_PkgFile_Create(
+                cso2::PkgFilenames[i].data(), vFileBuffer.data(),
+                vFileBuffer.size(), cso2::PackageEntryKeys[i].data(),
+                cso2::PackageFileKeys[i].data());
+            REQUIRE(pPkg != nullptr);
+
+            REQUIRE(uncso2_PkgFile_DecryptHeader(pPkg) == true);
+            REQUIRE(uncso2_PkgFile_Parse(pPkg) == true);
+
+            std::uint64_t iEntriesNum = uncso2_PkgFile_GetEntriesNum(pPkg);
+            PkgEntry_t* pEntries = uncso2_PkgFile_GetEntries(pPkg);
+
+            REQUIRE(iEntriesNum == cso2::PackageFileCounts[i]);
+
+            for (std::size_t y = 0; y < iEntriesNum; y++)
+            {
+                std::vector<std::uint8_t> vOutBuffer(
+                    uncso2_PkgEntry_GetDecryptedSize(pEntries[y]));
+                std::uint64_t iOutSize;
+                bool bValidEntry =
+                    uncso2_PkgEntry_DecryptTo(pEntries[y], vOutBuffer.data(),
+                                              vOutBuffer.size(), &iOutSize);
+
+                REQUIRE(bValidEntry == true);
+                REQUIRE(GetDataHash(vOutBuffer.data(), iOutSize) ==
+                        cso2::PackageFilesHashes[i][y]);
+            }
+
+            uncso2_PkgFile_Free(pPkg);
+        }
+    }
 }
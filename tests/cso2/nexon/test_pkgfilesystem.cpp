@@ -0,0 +1,166 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <string>
+
+#include <uc2/uc2.h>
+#include <uc2/uc2.hpp>
+
+#include "cso2/nexon/settings.hpp"
+
+// turns "/materials/foo.vtf" into "MATERIALS\FOO.VTF"
+static std::string GetAltPath(std::string_view szvPath)
+{
+    std::string szAltPath(szvPath.substr(szvPath.find_first_not_of('/')));
+
+    std::transform(szAltPath.begin(), szAltPath.end(), szAltPath.begin(),
+                   [](unsigned char c) {
+                       return c == '/' ? '\\' :
+                                         static_cast<char>(std::toupper(c));
+                   });
+
+    return szAltPath;
+}
+
+TEST_CASE("Files can be found across pkg files", "[pkgfilesystem]")
+{
+    SECTION("Can find every entry of a PKG file")
+    {
+        for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+        {
+            try
+            {
+                auto pFs = uc2::PkgFileSystem::Create();
+
+                auto pPkgFile =
+                    uc2::PkgFile::Open(cso2::PkgFilenames[i],
+                                       cso2::PackageEntryKeys[i],
+                                       cso2::PackageFileKeys[i]);
+                uc2::PkgFile* pPkgRaw = pPkgFile.get();
+
+                pFs->AddArchive(std::move(pPkgFile));
+
+                REQUIRE(pFs->GetArchivesNum() == 1);
+                REQUIRE(pFs->GetEntriesNum() == cso2::PackageFileCounts[i]);
+
+                for (auto&& entry : pPkgRaw->GetEntries())
+                {
+                    auto [pFoundPkg, pFoundEntry] =
+                        pFs->Find(entry->GetFilePath());
+
+                    REQUIRE(pFoundPkg == pPkgRaw);
+                    REQUIRE(pFoundEntry == entry.get());
+
+                    REQUIRE(pFs->FindEntry(GetAltPath(
+                                entry->GetFilePath())) == entry.get());
+                }
+
+                REQUIRE(pFs->FindEntry("/this/file/does/not.exist") ==
+                        nullptr);
+                REQUIRE(pFs->Find("").first == nullptr);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << e.what() << '\n';
+                throw e;
+            }
+        }
+    }
+
+    SECTION("The PKG file added last wins")
+    {
+        try
+        {
+            auto pFs = uc2::PkgFileSystem::Create();
+            uc2::PkgFile* pLastPkg = nullptr;
+
+            for (std::size_t i = 0; i < cso2::NUM_PROVIDERS; i++)
+            {
+                auto pPkgFile =
+                    uc2::PkgFile::Open(cso2::PkgFilenames[i],
+                                       cso2::PackageEntryKeys[i],
+                                       cso2::PackageFileKeys[i]);
+                pLastPkg = pPkgFile.get();
+
+                pFs->AddArchive(std::move(pPkgFile));
+            }
+
+            REQUIRE(pFs->GetArchivesNum() == cso2::NUM_PROVIDERS);
+
+            for (auto&& entry : pLastPkg->GetEntries())
+            {
+                auto [pFoundPkg, pFoundEntry] = pFs->Find(entry->GetFilePath());
+
+                REQUIRE(pFoundPkg == pLastPkg);
+                REQUIRE(pFoundEntry == entry.get());
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << '\n';
+            throw e;
+        }
+    }
+
+    SECTION("Can find entries using C bindings")
+    {
+        PkgFileSystem_t pFs = uncso2_PkgFileSystem_Create();
+        REQUIRE(pFs != nullptr);
+
+        PkgFile_t pPkg = uncso2_PkgFile_Open(cso2::PkgFilenames[0].data(),
+                                             cso2::PackageEntryKeys[0].data(),
+                                             cso2::PackageFileKeys[0].data());
+        REQUIRE(pPkg != nullptr);
+
+        REQUIRE(uncso2_PkgFileSystem_AddArchive(pFs, pPkg) == true);
+        REQUIRE(uncso2_PkgFileSystem_GetArchivesNum(pFs) == 1);
+        REQUIRE(uncso2_PkgFileSystem_GetEntriesNum(pFs) ==
+                cso2::PackageFileCounts[0]);
+
+        const uint64_t iEntriesNum = uncso2_PkgFile_GetEntriesNum(pPkg);
+        PkgEntry_t* pEntries = uncso2_PkgFile_GetEntries(pPkg);
+
+        for (uint64_t i = 0; i < iEntriesNum; i++)
+        {
+            const char* szPath = uncso2_PkgEntry_GetPath(pEntries[i]);
+
+            REQUIRE(uncso2_PkgFileSystem_FindEntry(pFs, szPath) == pEntries[i]);
+            REQUIRE(uncso2_PkgFileSystem_FindEntry(
+                        pFs, GetAltPath(szPath).c_str()) == pEntries[i]);
+        }
+
+        REQUIRE(uncso2_PkgFileSystem_FindEntry(
+                    pFs, "/this/file/does/not.exist") == nullptr);
+
+        // the file system owns the PKG file
+        uncso2_PkgFileSystem_Free(pFs);
+    }
+
+    SECTION("Keeps the PKG file's ownership on failure using C bindings")
+    {
+        PkgFile_t pPkg = uncso2_PkgFile_Open(cso2::PkgFilenames[0].data(),
+                                             cso2::PackageEntryKeys[0].data(),
+                                             cso2::PackageFileKeys[0].data());
+        REQUIRE(pPkg != nullptr);
+
+        REQUIRE(uncso2_PkgFileSystem_AddArchive(NULL, pPkg) == false);
+
+        // the header can't be decrypted with the wrong keys
+        PkgFile_t pBadPkg = uncso2_PkgFile_Open(
+            cso2::PkgFilenames[0].data(), "wrong entry key", "wrong data key");
+        REQUIRE(pBadPkg != nullptr);
+
+        PkgFileSystem_t pFs = uncso2_PkgFileSystem_Create();
+        REQUIRE(pFs != nullptr);
+
+        REQUIRE(uncso2_PkgFileSystem_AddArchive(pFs, pBadPkg) == false);
+        REQUIRE(uncso2_PkgFileSystem_GetArchivesNum(pFs) == 0);
+
+        // the caller still owns both PKG files
+        uncso2_PkgFile_Free(pBadPkg);
+        uncso2_PkgFile_Free(pPkg);
+        uncso2_PkgFileSystem_Free(pFs);
+    }
+}
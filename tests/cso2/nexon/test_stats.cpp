@@ -0,0 +1,121 @@
+#include <catch2/catch.hpp>
+
+#include <iostream>
+
+#include <uc2/uc2.h>
+#include <uc2/uc2.hpp>
+
+#include "cso2/nexon/settings.hpp"
+#include "utils.hpp"
+
+// Parses a PKG file and decompresses a texture, which decrypts data, derives
+// keys and decodes LZMA chunks
+static void DoStatsWork()
+{
+    auto pPkgFile = uc2::PkgFile::Open(cso2::PkgFilenames[0],
+                                       cso2::PackageEntryKeys[0],
+                                       cso2::PackageFileKeys[0]);
+
+    REQUIRE(pPkgFile->DecryptHeader() == true);
+    pPkgFile->Parse();
+
+    REQUIRE(pPkgFile->GetEntries().size() == cso2::PackageFileCounts[0]);
+
+    auto [bWasRead, vTexBuffer] = ReadFileToBuffer(cso2::TextureFilename);
+    REQUIRE(bWasRead == true);
+
+    auto pTex = uc2::LzmaTexture::Create(vTexBuffer);
+    std::vector<std::uint8_t> buff(pTex->GetOriginalSize());
+    REQUIRE(pTex->DecompressParallel(buff.data(), buff.size(), 4) == true);
+}
+
+TEST_CASE("Work statistics can be counted", "[stats]")
+{
+    SECTION("Counts the work done while enabled")
+    {
+        try
+        {
+            uc2::Stats::SetEnabled(true);
+            REQUIRE(uc2::Stats::IsEnabled() == true);
+            uc2::Stats::Reset();
+
+            DoStatsWork();
+
+            const uc2::Stats stats = uc2::Stats::Get();
+            uc2::Stats::SetEnabled(false);
+
+            // the PKG's header and entries are decrypted with AES
+            REQUIRE(stats.iAesBytesDecrypted != 0);
+            REQUIRE(stats.iBlocksDecrypted * 16 ==
+                    stats.iAesBytesDecrypted + stats.iDesBytesDecrypted * 2 +
+                        stats.iBlowfishBytesDecrypted * 2);
+            REQUIRE(stats.iEntriesParsed == cso2::PackageFileCounts[0]);
+            REQUIRE(stats.iKeysDerived != 0);
+            REQUIRE(stats.iLzmaChunksDecoded != 0);
+            REQUIRE(stats.iDecryptNs != 0);
+            REQUIRE(stats.iKeyDerivationNs != 0);
+            REQUIRE(stats.iLzmaNs != 0);
+
+            uc2::Stats::Reset();
+            REQUIRE(uc2::Stats::Get().iEntriesParsed == 0);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << '\n';
+            throw e;
+        }
+    }
+
+    SECTION("Counts nothing while disabled")
+    {
+        try
+        {
+            uc2::Stats::SetEnabled(false);
+            uc2::Stats::Reset();
+
+            DoStatsWork();
+
+            const uc2::Stats stats = uc2::Stats::Get();
+
+            REQUIRE(stats.iAesBytesDecrypted == 0);
+            REQUIRE(stats.iEntriesParsed == 0);
+            REQUIRE(stats.iKeysDerived == 0);
+            REQUIRE(stats.iLzmaChunksDecoded == 0);
+            REQUIRE(stats.iDecryptNs == 0);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << '\n';
+            throw e;
+        }
+    }
+}
+
+TEST_CASE("Work statistics can be counted with C bindings", "[stats]")
+{
+    SECTION("Counts the work done while enabled")
+    {
+        REQUIRE(uncso2_Stats_Get(NULL) == false);
+
+        uncso2_Stats_SetEnabled(true);
+        REQUIRE(uncso2_Stats_IsEnabled() == true);
+        uncso2_Stats_Reset();
+
+        DoStatsWork();
+
+        Stats_t stats;
+        REQUIRE(uncso2_Stats_Get(&stats) == true);
+        uncso2_Stats_SetEnabled(false);
+        REQUIRE(uncso2_Stats_IsEnabled() == false);
+
+        REQUIRE(stats.iAesBytesDecrypted != 0);
+        REQUIRE(stats.iEntriesParsed == cso2::PackageFileCounts[0]);
+        REQUIRE(stats.iKeysDerived != 0);
+        REQUIRE(stats.iLzmaChunksDecoded != 0);
+        REQUIRE(stats.iLzmaNs != 0);
+
+        uncso2_Stats_Reset();
+        REQUIRE(uncso2_Stats_Get(&stats) == true);
+        REQUIRE(stats.iLzmaChunksDecoded == 0);
+    }
+}
@@ -0,0 +1,85 @@
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+#include <uc2/uc2.h>
+#include <uc2/uc2.hpp>
+
+#include "cso2/nexon/settings.hpp"
+#include "utils.hpp"
+
+namespace fs = std::filesystem;
+
+TEST_CASE("Work can be traced", "[trace]")
+{
+    SECTION("Writes the spans as Chrome trace JSON")
+    {
+        try
+        {
+            uc2::Trace::Clear();
+
+            auto pPkgFile = uc2::PkgFile::Open(cso2::PkgFilenames[0],
+                                               cso2::PackageEntryKeys[0],
+                                               cso2::PackageFileKeys[0]);
+
+            REQUIRE(pPkgFile->DecryptHeader() == true);
+            pPkgFile->Parse();
+
+            auto& entry = pPkgFile->GetEntry(0);
+            entry.DecryptFile();
+
+            std::ostringstream os;
+            const bool bWritten = uc2::Trace::WriteChromeTrace(os);
+
+            // the spans are compiled out unless tracing was enabled
+            REQUIRE(bWritten == uc2::Trace::IsAvailable());
+
+            if (bWritten == true)
+            {
+                const std::string szTrace = os.str();
+
+                REQUIRE(szTrace.find("\"traceEvents\"") != std::string::npos);
+                REQUIRE(szTrace.find("PkgFile::DecryptHeader") !=
+                        std::string::npos);
+                REQUIRE(szTrace.find("PkgFile::Parse") != std::string::npos);
+                REQUIRE(szTrace.find("PkgEntry::DecryptFile") !=
+                        std::string::npos);
+
+                uc2::Trace::Clear();
+
+                std::ostringstream clearedOs;
+                REQUIRE(uc2::Trace::WriteChromeTrace(clearedOs) == true);
+                REQUIRE(clearedOs.str().find("PkgFile::Parse") ==
+                        std::string::npos);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << '\n';
+            throw e;
+        }
+    }
+}
+
+TEST_CASE("Work can be traced with C bindings", "[trace]")
+{
+    SECTION("Dumps the spans to a file")
+    {
+        const fs::path tracePath =
+            fs::temp_directory_path() / "uc2_trace_test.json";
+        fs::remove(tracePath);
+
+        REQUIRE(uncso2_Trace_DumpChromeTrace(NULL) == false);
+
+        const bool bDumped =
+            uncso2_Trace_DumpChromeTrace(tracePath.string().c_str());
+
+        REQUIRE(bDumped == uncso2_Trace_IsAvailable());
+        REQUIRE(fs::exists(tracePath) == bDumped);
+
+        uncso2_Trace_Clear();
+        fs::remove(tracePath);
+    }
+}
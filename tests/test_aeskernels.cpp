@@ -0,0 +1,152 @@
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <aes.h>
+#include <modes.h>
+
+#include "ciphers/aeskernels.hpp"
+
+// Encrypts the blocks with Crypto++, the fallback of the native kernels
+static std::vector<std::uint8_t> EncryptWithCryptoPP(
+    const std::vector<std::uint8_t>& vKey, const std::uint8_t* pIV,
+    const std::vector<std::uint8_t>& vPlainText)
+{
+    std::vector<std::uint8_t> vCipherText(vPlainText.size());
+
+    if (vPlainText.empty() == false)
+    {
+        CryptoPP::CBC_Mode<CryptoPP::AES>::Encryption enc;
+        enc.SetKeyWithIV(vKey.data(), vKey.size(), pIV);
+        enc.ProcessData(vCipherText.data(), vPlainText.data(),
+                        vPlainText.size());
+    }
+
+    return vCipherText;
+}
+
+static std::vector<std::uint8_t> DecryptWithCryptoPP(
+    const std::vector<std::uint8_t>& vKey, const std::uint8_t* pIV,
+    const std::vector<std::uint8_t>& vCipherText)
+{
+    std::vector<std::uint8_t> vPlainText(vCipherText.size());
+
+    if (vCipherText.empty() == false)
+    {
+        CryptoPP::CBC_Mode<CryptoPP::AES>::Decryption dec;
+        dec.SetKeyWithIV(vKey.data(), vKey.size(), pIV);
+        dec.ProcessData(vPlainText.data(), vCipherText.data(),
+                        vCipherText.size());
+    }
+
+    return vPlainText;
+}
+
+TEST_CASE("Native AES kernels decrypt like Crypto++", "[aeskernels]")
+{
+    constexpr const std::size_t BLOCK_SIZE = 16;
+    // enough blocks to reach every kernel's tail after a full iteration
+    constexpr const std::size_t MAX_BLOCKS = 40;
+
+    const uc2::AesKernel bestKernel = uc2::GetBestAesKernel();
+
+    // the kernels are ordered by speed, and every faster kernel needs the
+    // instructions of the slower ones
+    std::vector<uc2::AesKernel> vKernels;
+
+    for (const uc2::AesKernel kernel :
+         { uc2::AesKernel::AesNi, uc2::AesKernel::Vaes512 })
+    {
+        if (kernel <= bestKernel)
+        {
+            vKernels.push_back(kernel);
+        }
+    }
+
+    std::mt19937 rng(2020);
+    std::uniform_int_distribution<int> byteDist(0, 255);
+
+    auto fnRandomBytes = [&](std::size_t iLength) {
+        std::vector<std::uint8_t> vBytes(iLength);
+
+        for (auto& b : vBytes)
+        {
+            b = static_cast<std::uint8_t>(byteDist(rng));
+        }
+
+        return vBytes;
+    };
+
+    SECTION("Only 128 and 256 bits keys are expanded")
+    {
+        const std::vector<std::uint8_t> vKey = fnRandomBytes(32);
+        uc2::AesDecryptionKeys_t keys;
+
+        const bool bHasKernel = bestKernel != uc2::AesKernel::None;
+
+        REQUIRE(uc2::ExpandAesDecryptionKeys(vKey.data(), 16, keys) ==
+                bHasKernel);
+        REQUIRE(uc2::ExpandAesDecryptionKeys(vKey.data(), 32, keys) ==
+                bHasKernel);
+        REQUIRE(uc2::ExpandAesDecryptionKeys(vKey.data(), 24, keys) == false);
+    }
+
+    SECTION("Decrypts every block count, in and out of place")
+    {
+        try
+        {
+            for (const std::size_t iKeyLength : { 16, 32 })
+            {
+                const std::vector<std::uint8_t> vKey =
+                    fnRandomBytes(iKeyLength);
+                const std::vector<std::uint8_t> vIV = fnRandomBytes(BLOCK_SIZE);
+
+                uc2::AesDecryptionKeys_t keys;
+
+                if (uc2::ExpandAesDecryptionKeys(vKey.data(), vKey.size(),
+                                                 keys) == false)
+                {
+                    REQUIRE(vKernels.empty() == true);
+                    continue;
+                }
+
+                for (std::size_t iBlocks = 0; iBlocks <= MAX_BLOCKS; iBlocks++)
+                {
+                    const std::vector<std::uint8_t> vPlainText =
+                        fnRandomBytes(iBlocks * BLOCK_SIZE);
+                    const std::vector<std::uint8_t> vCipherText =
+                        EncryptWithCryptoPP(vKey, vIV.data(), vPlainText);
+
+                    REQUIRE(DecryptWithCryptoPP(vKey, vIV.data(),
+                                                vCipherText) == vPlainText);
+
+                    for (const uc2::AesKernel kernel : vKernels)
+                    {
+                        std::vector<std::uint8_t> vOutBuffer(
+                            vCipherText.size());
+                        uc2::DecryptAesCbc(kernel, keys, vIV.data(),
+                                           vCipherText.data(),
+                                           vOutBuffer.data(), iBlocks);
+
+                        REQUIRE(vOutBuffer == vPlainText);
+
+                        std::vector<std::uint8_t> vInPlace = vCipherText;
+                        uc2::DecryptAesCbc(kernel, keys, vIV.data(),
+                                           vInPlace.data(), vInPlace.data(),
+                                           iBlocks);
+
+                        REQUIRE(vInPlace == vPlainText);
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << '\n';
+            throw e;
+        }
+    }
+}
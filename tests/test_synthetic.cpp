@@ -0,0 +1,156 @@
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <uc2/uc2.hpp>
+
+#include "synthetic.hpp"
+#include "utils.hpp"
+
+namespace fs = std::filesystem;
+
+// Writes a synthetic PKG like pkg_gen does
+static void WriteSyntheticPkgFile(const fs::path& path,
+                                  std::string_view szvPkgName,
+                                  const SyntheticPkgOptions_t& options)
+{
+    std::ofstream os(path, std::ios::binary | std::ios::trunc);
+
+    WriteSyntheticPkg(szvPkgName, options,
+                      [&os](const std::uint8_t* pData, std::size_t iSize) {
+                          os.write(reinterpret_cast<const char*>(pData), iSize);
+                      });
+
+    os.close();
+    REQUIRE(os.fail() == false);
+}
+
+TEST_CASE("Synthetic files can be opened by the library", "[synthetic]")
+{
+    const fs::path outDir = fs::temp_directory_path() / "uc2_synthetic_test";
+    fs::create_directories(outDir);
+
+    SECTION("Can parse synthetic CSO2 and TFO PKG files")
+    {
+        for (const bool bTfoPkg : { false, true })
+        {
+            SyntheticPkgOptions_t options;
+            options.iEntriesNum = 100;
+            options.iMinFileSize = 0;
+            options.iMaxFileSize = 4096;
+            options.fEncryptedRatio = 0.5;
+            options.fTextureRatio = 0.5;
+            options.bTfoPkg = bTfoPkg;
+
+            // the PKG's keys are derived from its file name
+            const std::string szPkgName = GetSyntheticPkgName(bTfoPkg);
+            const fs::path pkgPath = outDir / szPkgName;
+            WriteSyntheticPkgFile(pkgPath, szPkgName, options);
+
+            try
+            {
+                auto pOptions = uc2::PkgFileOptions::Create();
+                pOptions->SetTfoPkg(bTfoPkg);
+
+                auto pPkgFile = uc2::PkgFile::Open(
+                    pkgPath, std::string(SYNTHETIC_ENTRY_KEY),
+                    std::string(SYNTHETIC_DATA_KEY), pOptions.get());
+
+                REQUIRE(pPkgFile->DecryptHeader() == true);
+                pPkgFile->Parse();
+
+                REQUIRE(pPkgFile->GetEntries().size() == options.iEntriesNum);
+
+                std::size_t iTexturesNum = 0;
+
+                for (auto&& entry : pPkgFile->GetEntries())
+                {
+                    std::vector<std::uint8_t> vEntryData(
+                        entry->GetDecryptedSize());
+                    REQUIRE(entry->DecryptFileTo(vEntryData.data(),
+                                                 vEntryData.size()) ==
+                            vEntryData.size());
+
+                    const std::string_view szvPath = entry->GetFilePath();
+
+                    if (szvPath.substr(szvPath.length() - 4) != ".vtf")
+                    {
+                        continue;
+                    }
+
+                    // a texture only decompresses if it was decrypted right
+                    auto pTexture = uc2::LzmaTexture::Create(vEntryData);
+                    std::vector<std::uint8_t> vTextureData(
+                        pTexture->GetOriginalSize());
+
+                    REQUIRE(pTexture->Decompress(vTextureData.data(),
+                                                 vTextureData.size()) == true);
+
+                    iTexturesNum++;
+                }
+
+                REQUIRE(iTexturesNum > 0);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << e.what() << '\n';
+                throw e;
+            }
+        }
+    }
+
+    SECTION("Can parse a synthetic index file")
+    {
+        const std::string szIndexName = "synthetic_index.pkg";
+        const std::vector<std::string> vPkgNames = { GetSyntheticPkgName(0),
+                                                     GetSyntheticPkgName(1) };
+
+        {
+            const std::vector<std::uint8_t> vIndex =
+                BuildSyntheticIndex(szIndexName, vPkgNames);
+
+            std::ofstream os(outDir / szIndexName,
+                             std::ios::binary | std::ios::trunc);
+            os.write(reinterpret_cast<const char*>(vIndex.data()),
+                     vIndex.size());
+            os.close();
+            REQUIRE(os.fail() == false);
+        }
+
+        auto [bWasRead, vIndexBuffer] =
+            ReadFileToBuffer((outDir / szIndexName).string());
+
+        REQUIRE(bWasRead == true);
+
+        try
+        {
+            auto pPkgIndex = uc2::PkgIndex::Create(szIndexName, vIndexBuffer,
+                                                   &SYNTHETIC_KEY_COLLECTION);
+
+            pPkgIndex->ValidateHeader();
+            pPkgIndex->Parse();
+
+            // the first file name is the index's own
+            const auto& vFilenames = pPkgIndex->GetFilenames();
+
+            REQUIRE(vFilenames.size() == vPkgNames.size() + 1);
+            REQUIRE(vFilenames[0] == szIndexName);
+
+            for (std::size_t i = 0; i < vPkgNames.size(); i++)
+            {
+                REQUIRE(vFilenames[i + 1] == vPkgNames[i]);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << '\n';
+            throw e;
+        }
+    }
+
+    fs::remove_all(outDir);
+}
@@ -0,0 +1,129 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "textlines.hpp"
+
+// Splits the text one byte at a time, like the kernels' scalar tail does
+static std::vector<std::string> SplitTextByLineSlow(std::string_view szvText)
+{
+    std::vector<std::string> vLines;
+    std::size_t iLineStart = 0;
+
+    for (std::size_t i = 1; i < szvText.length(); i++)
+    {
+        if (szvText[i] == '\n' && szvText[i - 1] == '\r' && i > iLineStart)
+        {
+            vLines.emplace_back(szvText.substr(iLineStart, i - 1 - iLineStart));
+            iLineStart = i + 1;
+        }
+    }
+
+    return vLines;
+}
+
+static std::vector<std::string> ToStrings(
+    const std::vector<std::string_view>& vLines)
+{
+    return std::vector<std::string>(vLines.begin(), vLines.end());
+}
+
+TEST_CASE("Text is split by its CRLF line breaks", "[textlines]")
+{
+    // the AVX2 kernel reads 32 bytes at a time, the SSE2 one 16 bytes
+    constexpr const std::size_t MAX_VECTOR_SIZE = 32;
+
+    SECTION("Splits every kind of line break")
+    {
+        struct SplitCase_t
+        {
+            std::string szText;
+            std::vector<std::string> vExpected;
+        };
+
+        const std::string szPad15(15, 'a');
+        const std::string szPad16(16, 'b');
+        const std::string szPad31(31, 'c');
+        const std::string szPad32(32, 'd');
+
+        const std::vector<SplitCase_t> vCases = {
+            // empty input
+            { "", {} },
+            // shorter than a vector
+            { "a\r\n", { "a" } },
+            { "\r\n", { "" } },
+            { "\r\n\r\n", { "", "" } },
+            { "one\r\ntwo\r\n", { "one", "two" } },
+            // trailing text without a CRLF is not a line
+            { "one\r\ntwo", { "one" } },
+            { "no line break", {} },
+            // a lone '\n' or '\r' does not end a line
+            { "a\nb\r\n", { "a\nb" } },
+            { "\n", {} },
+            { "a\rb\r\n", { "a\rb" } },
+            { "\r", {} },
+            { "\n\r\n", { "\n" } },
+            { "\r\n\n", { "" } },
+            // a CRLF straddling the 16 and 32 bytes boundaries
+            { szPad15 + "\r\n", { szPad15 } },
+            { szPad31 + "\r\n", { szPad31 } },
+            { szPad15 + "\r\n" + szPad15 + "\r\n", { szPad15, szPad15 } },
+            // a lone '\r' at the end of a vector
+            { szPad15 + "\r" + szPad15 + "\n", {} },
+            { szPad15 + "\r" + "x\r\n", { szPad15 + "\rx" } },
+            { szPad31 + "\r" + "x\r\n", { szPad31 + "\rx" } },
+            // a lone '\n' at the start of a vector
+            { szPad16 + "\n\r\n", { szPad16 + "\n" } },
+            { szPad32 + "\n\r\n", { szPad32 + "\n" } },
+        };
+
+        for (const SplitCase_t& splitCase : vCases)
+        {
+            INFO("Text length: " << splitCase.szText.length());
+
+            const std::vector<std::string_view> vLines =
+                uc2::SplitTextByLine(splitCase.szText);
+
+            REQUIRE(ToStrings(vLines) == splitCase.vExpected);
+
+            // the lines point inside the text
+            for (std::string_view szvLine : vLines)
+            {
+                REQUIRE(szvLine.data() >= splitCase.szText.data());
+                REQUIRE(szvLine.data() + szvLine.length() <=
+                        splitCase.szText.data() + splitCase.szText.length());
+            }
+        }
+    }
+
+    SECTION("Splits line breaks at any offset like a byte by byte scan")
+    {
+        for (std::size_t iLength = 0; iLength <= MAX_VECTOR_SIZE * 3;
+             iLength++)
+        {
+            for (std::size_t iBreak = 0; iBreak + 1 < iLength; iBreak++)
+            {
+                for (const char* szBreak : { "\r\n", "\r\r", "\n\n", "\n\r" })
+                {
+                    std::string szText(iLength, 'x');
+                    szText[iBreak] = szBreak[0];
+                    szText[iBreak + 1] = szBreak[1];
+
+                    // a second line break in the following vector
+                    if (iBreak + MAX_VECTOR_SIZE + 1 < iLength)
+                    {
+                        szText[iBreak + MAX_VECTOR_SIZE] = '\r';
+                        szText[iBreak + MAX_VECTOR_SIZE + 1] = '\n';
+                    }
+
+                    INFO("Length: " << iLength << ", break at: " << iBreak);
+
+                    REQUIRE(ToStrings(uc2::SplitTextByLine(szText)) ==
+                            SplitTextByLineSlow(szText));
+                }
+            }
+        }
+    }
+}